@@ -17,6 +17,20 @@ typedef struct circbuf circbuf_t;
 // Export print function definition
 typedef void (*PRINTFUNC)(void * data, uint32_t index);
 
+// Export drop function definition, called with each overwritten item
+typedef void (*DROPFUNC)(void * data);
+
+// Transitions that can be signaled on a notify file descriptor
+#define CB_NOTIFY_NOT_EMPTY (0x01)
+#define CB_NOTIFY_NOT_FULL  (0x02)
+
+// Number of occupancy histogram buckets, each covers an equal share of the
+// buffer length
+#define CB_STATS_BUCKETS (8)
+
+// Size of a cache line used to keep producer and consumer data apart
+#define CB_CACHE_LINE_SIZE (64)
+
 // Check for null pointer
 #define CB_CHECK_NULL(x) if (x == NULL) {return CB_ENUM_NULL_POINTER;}
 
@@ -33,6 +47,25 @@ typedef enum cb_enum
   CB_ENUM_BAD_INDEX
 } cb_enum_t;
 
+// Contiguous run of items inside the circular buffer
+typedef struct cb_span
+{
+  void ** items;
+  uint32_t count;
+} cb_span_t;
+
+// Statistics kept when built with CB_STATS.  Occupancy is sampled after
+// every add and remove call into the histogram.
+typedef struct cb_stats
+{
+  uint64_t adds;
+  uint64_t removes;
+  uint64_t full;
+  uint64_t empty;
+  uint32_t high_water;
+  uint64_t histogram[CB_STATS_BUCKETS];
+} cb_stats_t;
+
 /*
  * \brief circbuf_init: Initialize circular buffer with a length this will
  *                       call malloc to put the buffer and the structure
@@ -45,6 +78,28 @@ typedef enum cb_enum
  */
 cb_enum_t circbuf_init(circbuf_t ** buf, uint16_t length);
 
+/*
+ * \brief circbuf_init_growable: Initialize a circular buffer that doubles
+ *                               its length when an add finds it full, up to
+ *                               max_length.  Growing moves the items to the
+ *                               start of the new buffer so adds and removes
+ *                               stay O(1) amortized.  All other circbuf
+ *                               functions work on it unchanged.
+ *
+ * \param buf: pointer to a pointer for the circular buffer structure
+ * \param length: starting length, the buffer never shrinks below it
+ * \param max_length: largest length the buffer may grow to
+ * \param shrink_after: number of removes in a row with the buffer at most a
+ *                      quarter full before its length is halved, 0 never
+ *                      shrinks
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_init_growable(circbuf_t ** buf,
+                                uint32_t length,
+                                uint32_t max_length,
+                                uint32_t shrink_after);
+
 /*
  * \brief circbuf_destroy: calls free on the buffer and the structure
  *
@@ -85,7 +140,96 @@ cb_enum_t circbuf_add_item(circbuf_t * buf, void * payload);
 cb_enum_t circbuf_remove_item(circbuf_t * buf, void ** payload);
 
 /*
- * \brief circbuf_full: checks if buffer is full
+ * \brief circbuf_add_items: adds up to count items at head in one call
+ *
+ * \param buf: pointer to a pointer for the circular buffer structure
+ * \param payloads: array of payloads to be added in order
+ * \param count: number of payloads in the array
+ * \param added: number of payloads actually added, fewer than count when
+ *               the buffer fills up.  In overwrite mode this is the number
+ *               of payloads kept, at most the length of the buffer.
+ * \return: success, or full if nothing could be added
+ *
+ */
+cb_enum_t circbuf_add_items(circbuf_t * buf,
+                            void ** payloads,
+                            uint32_t count,
+                            uint32_t * added);
+
+/*
+ * \brief circbuf_remove_items: removes up to count items from tail in one
+ *                              call
+ *
+ * \param buf: pointer to a pointer for the circular buffer structure
+ * \param payloads: array where removed payloads will be placed in order
+ * \param count: number of payloads the array can hold
+ * \param removed: number of payloads actually removed
+ * \return: success, or empty if nothing could be removed
+ *
+ */
+cb_enum_t circbuf_remove_items(circbuf_t * buf,
+                               void ** payloads,
+                               uint32_t count,
+                               uint32_t * removed);
+
+/*
+ * \brief circbuf_set_overwrite: turns overwrite mode on or off.  In
+ *                              overwrite mode adding to a full buffer drops
+ *                              the oldest items instead of returning full
+ *                              so the buffer always holds the newest items.
+ *
+ * \param buf: pointer to a pointer for the circular buffer structure
+ * \param enable: non zero to overwrite the oldest items when full
+ * \param func: optional function called with each dropped item, may be
+ *              NULL
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_set_overwrite(circbuf_t * buf, uint8_t enable, DROPFUNC func);
+
+/*
+ * \brief circbuf_dropped: gets the number of items dropped by overwrite
+ *                        mode since the buffer was created
+ *
+ * \param buf: pointer to a pointer for the circular buffer structure
+ * \param dropped: memory location where the count will be placed
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_dropped(circbuf_t * buf, uint64_t * dropped);
+
+/*
+ * \brief circbuf_set_notify: attaches a file descriptor, normally an
+ *                           eventfd, that is written when the buffer goes
+ *                           from empty to not empty and/or from full to not
+ *                           full.  Only transitions are signaled so a burst
+ *                           of adds costs at most one write, and one
+ *                           descriptor may be shared by several buffers.
+ *                           The waiting thread reads the descriptor to
+ *                           reset it, then drains the buffers.
+ *
+ * \param buf: pointer to a pointer for the circular buffer structure
+ * \param fd: descriptor to write, negative to detach
+ * \param events: mask of CB_NOTIFY_NOT_EMPTY and CB_NOTIFY_NOT_FULL
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_set_notify(circbuf_t * buf, int32_t fd, uint8_t events);
+
+/*
+ * \brief circbuf_length: gets the number of items the buffer can hold
+ *                       right now
+ *
+ * \param buf: pointer to a pointer for the circular buffer structure
+ * \param length: memory location where the length will be placed
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_length(circbuf_t * buf, uint32_t * length);
+
+/*
+ * \brief circbuf_full: checks if buffer is full, a growable buffer is only
+ *                     full at its max length
  *
  * \param buf: pointer to a pointer for the circular buffer structure
  * \return: success if full or error if not full
@@ -113,6 +257,22 @@ cb_enum_t circbuf_empty(circbuf_t * buf);
  */
 cb_enum_t circbuf_peek(circbuf_t * buf, uint32_t index, void ** payload);
 
+/*
+ * \brief circbuf_peek_spans: gets the readable items as at most two
+ *                            contiguous spans, the first starting at tail
+ *                            and the second starting at the beginning of
+ *                            the buffer after a wrap.  The spans point
+ *                            into the buffer and are only valid until the
+ *                            next add or remove.
+ *
+ * \param buf: pointer to a pointer for the circular buffer structure
+ * \param first: span starting at tail
+ * \param second: span after the wrap, count is 0 if there is no wrap
+ * \return: success, or empty if there are no items
+ *
+ */
+cb_enum_t circbuf_peek_spans(circbuf_t * buf, cb_span_t * first, cb_span_t * second);
+
 /*
  * \brief circbuf_dump: prints contents of circbuf
  *
@@ -123,6 +283,41 @@ cb_enum_t circbuf_peek(circbuf_t * buf, uint32_t index, void ** payload);
  */
 cb_enum_t circbuf_dump(circbuf_t * buf, PRINTFUNC func);
 
+/*
+ * \brief circbuf_stats: gets a snapshot of the statistics, items added and
+ *                      removed, adds rejected as full, removes rejected as
+ *                      empty, the most items ever held and the occupancy
+ *                      histogram
+ *
+ * \param buf: pointer to a pointer for the circular buffer structure
+ * \param stats: memory location where the snapshot will be placed
+ * \return: success, or failure if not built with CB_STATS
+ *
+ */
+cb_enum_t circbuf_stats(circbuf_t * buf, cb_stats_t * stats);
+
+/*
+ * \brief circbuf_stats_reset: clears the statistics, the high water mark
+ *                            restarts at the current count
+ *
+ * \param buf: pointer to a pointer for the circular buffer structure
+ * \return: success, or failure if not built with CB_STATS
+ *
+ */
+cb_enum_t circbuf_stats_reset(circbuf_t * buf);
+
+/*
+ * \brief circbuf_stats_dump: logs the statistics then calls func for each
+ *                           histogram bucket with a pointer to its uint64_t
+ *                           count and the bucket index
+ *
+ * \param buf: pointer to a pointer for the circular buffer structure
+ * \param func: function for printing a bucket
+ * \return: success, or failure if not built with CB_STATS
+ *
+ */
+cb_enum_t circbuf_stats_dump(circbuf_t * buf, PRINTFUNC func);
+
 /*
  * \brief circbuf_null_buffer: nulls internal buffer
  *
@@ -0,0 +1,81 @@
+/** @file circbuf_mpmc.h
+*
+* @brief Interface for lock-free bounded multi producer/multi consumer
+*        circular buffer
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __CIRCBUF_MPMC_H__
+#define __CIRCBUF_MPMC_H__
+
+#include <stdint.h>
+#include "circbuf.h"
+
+// MPMC circbuf typedef
+typedef struct circbuf_mpmc circbuf_mpmc_t;
+
+/*
+ * \brief circbuf_mpmc_init: Initialize a multi producer/multi consumer
+ *                           circular buffer.  Any number of threads may add
+ *                           and remove items without a lock.  The length is
+ *                           rounded up to a power of two of at least 2.
+ *
+ * \param buf: pointer to a pointer for the circular buffer structure
+ * \param length: minimum number of items the buffer can hold
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_mpmc_init(circbuf_mpmc_t ** buf, uint16_t length);
+
+/*
+ * \brief circbuf_mpmc_destroy: calls free on the buffer and the structure
+ *
+ * \param buf: pointer to the circular buffer structure
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_mpmc_destroy(circbuf_mpmc_t * buf);
+
+/*
+ * \brief circbuf_mpmc_add_item: claims the slot at head and adds an item
+ *
+ * \param buf: pointer to the circular buffer structure
+ * \param payload: payload to be added to circular buffer
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_mpmc_add_item(circbuf_mpmc_t * buf, void * payload);
+
+/*
+ * \brief circbuf_mpmc_remove_item: claims the slot at tail and removes
+ *                                  the item
+ *
+ * \param buf: pointer to the circular buffer structure
+ * \param payload: memory location where removed item will be placed
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_mpmc_remove_item(circbuf_mpmc_t * buf, void ** payload);
+
+/*
+ * \brief circbuf_mpmc_full: checks if buffer is full, the result may be
+ *                           stale by the time it is returned
+ *
+ * \param buf: pointer to the circular buffer structure
+ * \return: full if full or failure if not full
+ *
+ */
+cb_enum_t circbuf_mpmc_full(circbuf_mpmc_t * buf);
+
+/*
+ * \brief circbuf_mpmc_empty: checks if buffer is empty, the result may be
+ *                            stale by the time it is returned
+ *
+ * \param buf: pointer to the circular buffer structure
+ * \return: empty if empty or failure if not empty
+ *
+ */
+cb_enum_t circbuf_mpmc_empty(circbuf_mpmc_t * buf);
+#endif // __CIRCBUF_MPMC_H__
@@ -0,0 +1,159 @@
+/** @file circbuf_shard.h
+*
+* @brief Interface for a sharded pool of circular buffers, one per CPU.
+*        Producers add to the shard of the CPU they run on and consumers
+*        remove from their own shard first, stealing from the other shards
+*        when theirs runs dry.  Items keep their order within a shard only.
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __CIRCBUF_SHARD_H__
+#define __CIRCBUF_SHARD_H__
+
+#include <stdint.h>
+#include "circbuf.h"
+
+// Most items a steal takes beyond what the remove asked for, they are kept
+// with the shard of the stealing CPU and handed out by its next removes
+#define CB_SHARD_STEAL_BATCH (16)
+
+// Sharded circbuf typedef
+typedef struct circbuf_shard circbuf_shard_t;
+
+// Work stealing statistics summed over all shards
+typedef struct cb_shard_stats
+{
+  uint64_t steals;
+  uint64_t stolen;
+  uint64_t failed_steals;
+} cb_shard_stats_t;
+
+/*
+ * \brief circbuf_shard_init: Initialize a sharded pool of circular buffers
+ *
+ * \param pool: pointer to a pointer for the pool structure
+ * \param shards: number of shards, 0 for one per online CPU
+ * \param length: number of items each shard can hold
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_shard_init(circbuf_shard_t ** pool, uint32_t shards, uint16_t length);
+
+/*
+ * \brief circbuf_shard_destroy: calls free on every shard and the pool
+ *
+ * \param pool: pointer to the pool structure
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_shard_destroy(circbuf_shard_t * pool);
+
+/*
+ * \brief circbuf_shard_add_item: adds an item to the shard of the calling
+ *                                CPU, or to the next shard with room when
+ *                                that one is full
+ *
+ * \param pool: pointer to the pool structure
+ * \param payload: payload to be added
+ * \return: success, or full if every shard is full
+ *
+ */
+cb_enum_t circbuf_shard_add_item(circbuf_shard_t * pool, void * payload);
+
+/*
+ * \brief circbuf_shard_remove_item: removes an item from the shard of the
+ *                                   calling CPU, stealing a batch of up to
+ *                                   CB_SHARD_STEAL_BATCH more from the next
+ *                                   shard holding any when it is empty
+ *
+ * \param pool: pointer to the pool structure
+ * \param payload: memory location where removed item will be placed
+ * \return: success, or empty if every shard is empty
+ *
+ */
+cb_enum_t circbuf_shard_remove_item(circbuf_shard_t * pool, void ** payload);
+
+/*
+ * \brief circbuf_shard_add_items: adds up to count items, filling the shard
+ *                                 of the calling CPU first then the next
+ *                                 shards with room
+ *
+ * \param pool: pointer to the pool structure
+ * \param payloads: array of payloads to be added in order
+ * \param count: number of payloads in the array
+ * \param added: number of payloads actually added
+ * \return: success, or full if nothing could be added
+ *
+ */
+cb_enum_t circbuf_shard_add_items(circbuf_shard_t * pool,
+                                  void ** payloads,
+                                  uint32_t count,
+                                  uint32_t * added);
+
+/*
+ * \brief circbuf_shard_remove_items: removes up to count items, draining
+ *                                    the shard of the calling CPU and what
+ *                                    it stole earlier first, then stealing
+ *                                    from each next shard until count items
+ *                                    are removed plus up to
+ *                                    CB_SHARD_STEAL_BATCH more kept for the
+ *                                    next removes on this CPU
+ *
+ * \param pool: pointer to the pool structure
+ * \param payloads: array where removed payloads will be placed
+ * \param count: number of payloads the array can hold
+ * \param removed: number of payloads actually removed
+ * \return: success, or empty if nothing could be removed
+ *
+ */
+cb_enum_t circbuf_shard_remove_items(circbuf_shard_t * pool,
+                                     void ** payloads,
+                                     uint32_t count,
+                                     uint32_t * removed);
+
+/*
+ * \brief circbuf_shard_empty: checks if every shard is empty, the result
+ *                             may be stale by the time it is returned
+ *
+ * \param pool: pointer to the pool structure
+ * \return: empty if empty or failure if not empty
+ *
+ */
+cb_enum_t circbuf_shard_empty(circbuf_shard_t * pool);
+
+/*
+ * \brief circbuf_shard_count: gets the number of shards
+ *
+ * \param pool: pointer to the pool structure
+ * \param shards: memory location where the number of shards will be placed
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_shard_count(circbuf_shard_t * pool, uint32_t * shards);
+
+/*
+ * \brief circbuf_shard_stats: gets the work stealing statistics, steals is
+ *                             the number of shards stolen from, stolen the
+ *                             number of items taken and failed_steals the
+ *                             number of removes that found every shard
+ *                             empty
+ *
+ * \param pool: pointer to the pool structure
+ * \param stats: memory location where the statistics will be placed
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_shard_stats(circbuf_shard_t * pool, cb_shard_stats_t * stats);
+
+/*
+ * \brief circbuf_shard_set_home: pins the shard used as home by every caller
+ *
+ * \param pool: pointer to the pool structure
+ * \param home: index of the shard, -1 to use the calling CPU again
+ * \return: success/fail
+ *
+ */
+cb_enum_t circbuf_shard_set_home(circbuf_shard_t * pool, int32_t home);
+#endif // __CIRCBUF_SHARD_H__
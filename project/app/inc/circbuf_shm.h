@@ -0,0 +1,118 @@
+/** @file circbuf_shm.h
+*
+* @brief Interface for single producer/single consumer circular buffer in
+*        shared memory, usable between processes.  Items are copied in and
+*        out of fixed size slots since pointers mean nothing in the other
+*        process.
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __CIRCBUF_SHM_H__
+#define __CIRCBUF_SHM_H__
+
+#include <stdint.h>
+#include "circbuf.h"
+
+// Shared memory circbuf typedef
+typedef struct circbuf_shm circbuf_shm_t;
+
+/*
+ * \brief circbuf_shm_init: Create a circular buffer in shared memory.  With
+ *                          a name the buffer is created in a new shm_open
+ *                          segment other processes can open, without a
+ *                          name it is anonymous and inherited across fork.
+ *
+ * \param buf: pointer to a pointer for the circular buffer handle
+ * \param name: shm_open name starting with '/' or NULL for anonymous
+ * \param length: number of items the buffer can hold
+ * \param item_size: size of each item in bytes
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_shm_init(circbuf_shm_t ** buf,
+                           const char * name,
+                           uint16_t length,
+                           uint32_t item_size);
+
+/*
+ * \brief circbuf_shm_open: Open a named circular buffer created by another
+ *                          process with circbuf_shm_init.  Fails if the
+ *                          segment has no valid header or is too small for
+ *                          the slots its header describes.
+ *
+ * \param buf: pointer to a pointer for the circular buffer handle
+ * \param name: shm_open name the buffer was created with
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_shm_open(circbuf_shm_t ** buf, const char * name);
+
+/*
+ * \brief circbuf_shm_destroy: unmaps the buffer and frees the handle.  The
+ *                             process that created a named segment also
+ *                             unlinks it, handles from circbuf_shm_open or
+ *                             inherited across fork only unmap.
+ *
+ * \param buf: pointer to the circular buffer handle
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_shm_destroy(circbuf_shm_t * buf);
+
+/*
+ * \brief circbuf_shm_add_item: copies an item in at head, must only be
+ *                              called by the producer
+ *
+ * \param buf: pointer to the circular buffer handle
+ * \param item: item_size bytes to copy in
+ * \return: success, or failure if the shared index is out of range
+ *
+ */
+cb_enum_t circbuf_shm_add_item(circbuf_shm_t * buf, const void * item);
+
+/*
+ * \brief circbuf_shm_remove_item: copies an item out from tail, must only
+ *                                 be called by the consumer
+ *
+ * \param buf: pointer to the circular buffer handle
+ * \param item: location for item_size bytes to be copied to
+ * \return: success, or failure if the shared index is out of range
+ *
+ */
+cb_enum_t circbuf_shm_remove_item(circbuf_shm_t * buf, void * item);
+
+/*
+ * \brief circbuf_shm_add_item_wait: like circbuf_shm_add_item but sleeps on
+ *                                   a futex while the buffer is full
+ *
+ * \param buf: pointer to the circular buffer handle
+ * \param item: item_size bytes to copy in
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_shm_add_item_wait(circbuf_shm_t * buf, const void * item);
+
+/*
+ * \brief circbuf_shm_remove_item_wait: like circbuf_shm_remove_item but
+ *                                      sleeps on a futex while the buffer
+ *                                      is empty
+ *
+ * \param buf: pointer to the circular buffer handle
+ * \param item: location for item_size bytes to be copied to
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_shm_remove_item_wait(circbuf_shm_t * buf, void * item);
+
+/*
+ * \brief circbuf_shm_empty: checks if buffer is empty, the result may be
+ *                           stale by the time it is returned
+ *
+ * \param buf: pointer to the circular buffer handle
+ * \return: empty if empty or failure if not empty
+ *
+ */
+cb_enum_t circbuf_shm_empty(circbuf_shm_t * buf);
+#endif // __CIRCBUF_SHM_H__
@@ -0,0 +1,124 @@
+/** @file circbuf_spsc.h
+*
+* @brief Interface for lock-free single producer/single consumer circular
+*        buffer
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __CIRCBUF_SPSC_H__
+#define __CIRCBUF_SPSC_H__
+
+#include <stdint.h>
+#include <time.h>
+#include "circbuf.h"
+
+// SPSC circbuf typedef
+typedef struct circbuf_spsc circbuf_spsc_t;
+
+/*
+ * \brief circbuf_spsc_init: Initialize a single producer/single consumer
+ *                           circular buffer.  Exactly one thread may add
+ *                           items and exactly one thread may remove items,
+ *                           neither needs a lock.
+ *
+ * \param buf: pointer to a pointer for the circular buffer structure
+ * \param length: number of items the buffer can hold
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_spsc_init(circbuf_spsc_t ** buf, uint16_t length);
+
+/*
+ * \brief circbuf_spsc_destroy: calls free on the buffer and the structure
+ *
+ * \param buf: pointer to the circular buffer structure
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_spsc_destroy(circbuf_spsc_t * buf);
+
+/*
+ * \brief circbuf_spsc_add_item: adds an item at head, must only be called
+ *                               from the producer thread
+ *
+ * \param buf: pointer to the circular buffer structure
+ * \param payload: payload to be added to circular buffer
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_spsc_add_item(circbuf_spsc_t * buf, void * payload);
+
+/*
+ * \brief circbuf_spsc_remove_item: removes an item from tail, must only be
+ *                                  called from the consumer thread
+ *
+ * \param buf: pointer to the circular buffer structure
+ * \param payload: memory location where removed item will be placed
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_spsc_remove_item(circbuf_spsc_t * buf, void ** payload);
+
+/*
+ * \brief circbuf_spsc_add_item_wait: adds an item at head, sleeping while
+ *                                    the buffer is full.  A free slot costs
+ *                                    no system call, the thread only parks
+ *                                    on a futex when the buffer is full.
+ *                                    Sleepers are only woken by the wait
+ *                                    functions so both sides must use them
+ *                                    when either side blocks, a zero
+ *                                    timeout gives a non-blocking call.
+ *
+ * \param buf: pointer to the circular buffer structure
+ * \param payload: payload to be added to circular buffer
+ * \param timeout: longest time to wait or NULL to wait forever
+ * \return: success, full if the timeout passed while still full, or
+ *          failure if the timeout is negative or tv_nsec is not below one
+ *          second.  Also wakes a consumer sleeping in
+ *          circbuf_spsc_remove_item_wait.
+ *
+ */
+cb_enum_t circbuf_spsc_add_item_wait(circbuf_spsc_t * buf,
+                                     void * payload,
+                                     const struct timespec * timeout);
+
+/*
+ * \brief circbuf_spsc_remove_item_wait: removes an item from tail, sleeping
+ *                                       while the buffer is empty.  Wakes a
+ *                                       producer sleeping in
+ *                                       circbuf_spsc_add_item_wait.
+ *
+ * \param buf: pointer to the circular buffer structure
+ * \param payload: memory location where removed item will be placed
+ * \param timeout: longest time to wait or NULL to wait forever
+ * \return: success, empty if the timeout passed while still empty, or
+ *          failure if the timeout is negative or tv_nsec is not below one
+ *          second
+ *
+ */
+cb_enum_t circbuf_spsc_remove_item_wait(circbuf_spsc_t * buf,
+                                        void ** payload,
+                                        const struct timespec * timeout);
+
+/*
+ * \brief circbuf_spsc_full: checks if buffer is full, the result may be
+ *                           stale by the time it is returned
+ *
+ * \param buf: pointer to the circular buffer structure
+ * \return: full if full or failure if not full
+ *
+ */
+cb_enum_t circbuf_spsc_full(circbuf_spsc_t * buf);
+
+/*
+ * \brief circbuf_spsc_empty: checks if buffer is empty, the result may be
+ *                            stale by the time it is returned
+ *
+ * \param buf: pointer to the circular buffer structure
+ * \return: empty if empty or failure if not empty
+ *
+ */
+cb_enum_t circbuf_spsc_empty(circbuf_spsc_t * buf);
+#endif // __CIRCBUF_SPSC_H__
@@ -0,0 +1,105 @@
+/** @file circbuf_typed.h
+*
+* @brief Macro generated circular buffer that stores items of one type
+*        inline.  Capacity is a compile time power of two so indexing is a
+*        mask, and the buffer needs no heap so it can be declared static on
+*        targets without malloc.
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __CIRCBUF_TYPED_H__
+#define __CIRCBUF_TYPED_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "circbuf.h"
+
+/*
+ * \brief CIRCBUF_DEFINE: defines the type name_t holding capacity items of
+ *                        type inline, and static inline functions
+ *
+ *                        name_init(buf)
+ *                        name_add_item(buf, const type * item)
+ *                        name_remove_item(buf, type * item)
+ *                        name_full(buf)
+ *                        name_empty(buf)
+ *                        name_count(buf)
+ *
+ *                        Items are copied in and out.  Head and tail are
+ *                        free running counters so all capacity slots are
+ *                        usable and the count is head - tail even after
+ *                        the counters wrap.  A capacity that is not a
+ *                        power of two fails to compile.
+ *
+ * \param name: prefix for the generated type and functions
+ * \param type: type of the items stored
+ * \param capacity: number of items, must be a power of two
+ *
+ */
+#define CIRCBUF_DEFINE(name, type, capacity)                                  \
+                                                                              \
+typedef char name##_capacity_check[                                           \
+  ((capacity) > 0 && ((capacity) & ((capacity) - 1)) == 0) ? 1 : -1];         \
+                                                                              \
+typedef struct name                                                           \
+{                                                                             \
+  uint32_t head;                                                              \
+  uint32_t tail;                                                              \
+  type items[capacity];                                                       \
+} name##_t;                                                                   \
+                                                                              \
+static inline cb_enum_t name##_init(name##_t * buf)                           \
+{                                                                             \
+  CB_CHECK_NULL(buf);                                                         \
+  buf->head = 0;                                                              \
+  buf->tail = 0;                                                              \
+  return CB_ENUM_NO_ERROR;                                                    \
+}                                                                             \
+                                                                              \
+static inline cb_enum_t name##_add_item(name##_t * buf, const type * item)    \
+{                                                                             \
+  CB_CHECK_NULL(buf);                                                         \
+  CB_CHECK_NULL(item);                                                        \
+  if (buf->head - buf->tail == (capacity))                                    \
+  {                                                                           \
+    return CB_ENUM_FULL;                                                      \
+  }                                                                           \
+  buf->items[buf->head & ((capacity) - 1)] = *item;                           \
+  buf->head++;                                                                \
+  return CB_ENUM_NO_ERROR;                                                    \
+}                                                                             \
+                                                                              \
+static inline cb_enum_t name##_remove_item(name##_t * buf, type * item)       \
+{                                                                             \
+  CB_CHECK_NULL(buf);                                                         \
+  CB_CHECK_NULL(item);                                                        \
+  if (buf->head == buf->tail)                                                 \
+  {                                                                           \
+    return CB_ENUM_EMPTY;                                                     \
+  }                                                                           \
+  *item = buf->items[buf->tail & ((capacity) - 1)];                           \
+  buf->tail++;                                                                \
+  return CB_ENUM_NO_ERROR;                                                    \
+}                                                                             \
+                                                                              \
+static inline cb_enum_t name##_full(name##_t * buf)                           \
+{                                                                             \
+  CB_CHECK_NULL(buf);                                                         \
+  return (buf->head - buf->tail == (capacity)) ?                              \
+         CB_ENUM_FULL : CB_ENUM_FAILURE;                                      \
+}                                                                             \
+                                                                              \
+static inline cb_enum_t name##_empty(name##_t * buf)                          \
+{                                                                             \
+  CB_CHECK_NULL(buf);                                                         \
+  return (buf->head == buf->tail) ? CB_ENUM_EMPTY : CB_ENUM_FAILURE;          \
+}                                                                             \
+                                                                              \
+static inline uint32_t name##_count(name##_t * buf)                           \
+{                                                                             \
+  return buf->head - buf->tail;                                               \
+}
+
+#endif // __CIRCBUF_TYPED_H__
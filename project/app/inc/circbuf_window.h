@@ -0,0 +1,127 @@
+/** @file circbuf_window.h
+*
+* @brief Interface for sliding window statistics over the last N samples.
+*        Kept next to a circbuf holding the same samples so reports can read
+*        min, max, sum, mean and percentiles without walking the buffer.
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __CIRCBUF_WINDOW_H__
+#define __CIRCBUF_WINDOW_H__
+
+#include <stdint.h>
+#include "circbuf.h"
+
+// Window typedef
+typedef struct circbuf_window circbuf_window_t;
+
+/*
+ * \brief circbuf_window_init: Initialize a window over the last length
+ *                             samples.  Percentiles come from a histogram of
+ *                             buckets equal buckets between low and high,
+ *                             samples outside the range count in the end
+ *                             buckets.
+ *
+ * \param win: pointer to a pointer for the window structure
+ * \param length: number of samples in the window
+ * \param low: lowest value expected for percentiles
+ * \param high: highest value expected for percentiles
+ * \param buckets: number of histogram buckets, 0 for no percentiles
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_window_init(circbuf_window_t ** win,
+                              uint16_t length,
+                              double low,
+                              double high,
+                              uint16_t buckets);
+
+/*
+ * \brief circbuf_window_destroy: calls free on the window
+ *
+ * \param win: pointer to the window structure
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_window_destroy(circbuf_window_t * win);
+
+/*
+ * \brief circbuf_window_add: adds a sample, the oldest sample leaves the
+ *                            window once it is full.  O(1) amortized.
+ *
+ * \param win: pointer to the window structure
+ * \param sample: sample to add
+ * \return: success, or failure if the sample is NaN or infinite
+ *
+ */
+cb_enum_t circbuf_window_add(circbuf_window_t * win, double sample);
+
+/*
+ * \brief circbuf_window_count: gets the number of samples in the window
+ *
+ * \param win: pointer to the window structure
+ * \param count: memory location where the count will be placed
+ * \return: success or error
+ *
+ */
+cb_enum_t circbuf_window_count(circbuf_window_t * win, uint32_t * count);
+
+/*
+ * \brief circbuf_window_min: gets the smallest sample in the window, O(1)
+ *
+ * \param win: pointer to the window structure
+ * \param min: memory location where the minimum will be placed
+ * \return: success, or empty if there are no samples
+ *
+ */
+cb_enum_t circbuf_window_min(circbuf_window_t * win, double * min);
+
+/*
+ * \brief circbuf_window_max: gets the largest sample in the window, O(1)
+ *
+ * \param win: pointer to the window structure
+ * \param max: memory location where the maximum will be placed
+ * \return: success, or empty if there are no samples
+ *
+ */
+cb_enum_t circbuf_window_max(circbuf_window_t * win, double * max);
+
+/*
+ * \brief circbuf_window_sum: gets the sum of the samples in the window, O(1)
+ *
+ * \param win: pointer to the window structure
+ * \param sum: memory location where the sum will be placed
+ * \return: success, or empty if there are no samples
+ *
+ */
+cb_enum_t circbuf_window_sum(circbuf_window_t * win, double * sum);
+
+/*
+ * \brief circbuf_window_mean: gets the mean of the samples in the window,
+ *                             O(1)
+ *
+ * \param win: pointer to the window structure
+ * \param mean: memory location where the mean will be placed
+ * \return: success, or empty if there are no samples
+ *
+ */
+cb_enum_t circbuf_window_mean(circbuf_window_t * win, double * mean);
+
+/*
+ * \brief circbuf_window_percentile: gets an approximate percentile of the
+ *                                   samples in the window from the
+ *                                   histogram, within one bucket width of
+ *                                   the exact value and never outside the
+ *                                   window min and max.  O(buckets).
+ *
+ * \param win: pointer to the window structure
+ * \param percent: percentile to get from 0 to 100
+ * \param value: memory location where the percentile will be placed
+ * \return: success, empty if there are no samples, bad index if percent
+ *          is out of range or failure if there is no histogram
+ *
+ */
+cb_enum_t circbuf_window_percentile(circbuf_window_t * win, double percent, double * value);
+#endif // __CIRCBUF_WINDOW_H__
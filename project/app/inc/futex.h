@@ -0,0 +1,41 @@
+/** @file futex.h
+*
+* @brief Thin wrappers around the futex system call used to park threads
+*        and processes waiting on a buffer
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __FUTEX_H__
+#define __FUTEX_H__
+
+#include <stdint.h>
+#include <time.h>
+
+/*!
+* @brief Sleep as long as *addr still holds val
+* @param[in] addr address of the futex word
+* @param[in] val value *addr is expected to hold
+* @param[in] timeout relative timeout or NULL to wait forever
+* @param[in] shared non zero when the futex word is in memory shared
+*                   between processes
+* @return 0 when woken or *addr did not hold val, -1 with errno set to
+*         ETIMEDOUT on timeout
+*/
+int32_t futex_wait(uint32_t * addr,
+                   uint32_t val,
+                   const struct timespec * timeout,
+                   uint8_t shared);
+
+/*!
+* @brief Wake threads sleeping on a futex word
+* @param[in] addr address of the futex word
+* @param[in] count maximum number of sleepers to wake
+* @param[in] shared non zero when the futex word is in memory shared
+*                   between processes
+* @return number of sleepers woken or -1 on error
+*/
+int32_t futex_wake(uint32_t * addr, uint32_t count, uint8_t shared);
+
+#endif // __FUTEX_H__
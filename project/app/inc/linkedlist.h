@@ -21,6 +21,17 @@ typedef uint8_t (*COMPAREFUNC)(void * data1, void * data2);
 // Export print function definition
 typedef void (*PRINTFUNC)(void * data, uint32_t index);
 
+// Cursor over a list, sits on a node or at the end past the last node.  The
+// fields are only read and written by the ll_cursor functions, it may live
+// on the stack.  A cursor stays valid across edits made through it but any
+// other insert or remove may leave it on a freed node or a stale index.
+typedef struct ll_cursor
+{
+  node_t * head;
+  node_t * node;
+  int32_t index;
+} ll_cursor_t;
+
 // Enums for linked list
 typedef enum ll_enum
 {
@@ -45,6 +56,22 @@ typedef enum ll_enum
  */
 ll_enum_t ll_init(node_t ** head);
 
+/*
+ * \brief ll_init_pool: Initialize a linked list whose nodes come from a
+ *                      pool owned by the list.  Nodes are carved out of
+ *                      slabs of slab_nodes nodes and removed nodes go back
+ *                      on a free list, so insert and remove churn does not
+ *                      call malloc and free.  Slabs are only released by
+ *                      ll_destroy, a whole slab at a time.
+ *
+ * \param head: pointer to head which will be malloced.
+ * \param slab_nodes: number of nodes allocated together when the pool runs
+ *                    out
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_init_pool(node_t ** head, uint32_t slab_nodes);
+
 /*
  * \brief ll_destroy: Destroy linked list by looping over nodes and
  *                    freeing data.
@@ -60,7 +87,9 @@ ll_enum_t ll_destroy(node_t * head);
  *
  * \param head: pointer to head.
  * \param data: pointer to data which will be inserted
- * \param index: index to insert (INSERT_AT_END can be used to do so)
+ * \param index: index the new node will have, negative indices count back
+ *               from the end so INSERT_AT_END appends.  Inserting near
+ *               either end is cheap, the list is walked from the closer end.
  * \return: success or error
  *
  */
@@ -71,7 +100,8 @@ ll_enum_t ll_insert(node_t * head, void * data, int32_t index);
  *
  * \param head: pointer to head.
  * \param data: double pointer where data will be placed if found
- * \param index: index to insert (REMOVE_AT_END can be used to do so)
+ * \param index: index to remove, negative indices count back from the end
+ *               so REMOVE_AT_END removes the last node
  * \return: success or error
  *
  */
@@ -89,6 +119,196 @@ ll_enum_t ll_remove(node_t * head, void ** data, int32_t index);
  */
 ll_enum_t ll_search(node_t * head, void * data, COMPAREFUNC func, int32_t * index);
 
+/*
+ * \brief ll_search_cursor: Search for data using compare func and leave a
+ *                          cursor on the match so it can be removed or
+ *                          edited around without walking the list again
+ *
+ * \param head: pointer to head.
+ * \param data: pointer to data for comparison in compare func
+ * \param func: comparison function used to find data
+ * \param cursor: cursor placed on the node if data is found
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_search_cursor(node_t * head, void * data, COMPAREFUNC func, ll_cursor_t * cursor);
+
+/*
+ * \brief ll_cursor_first: Place a cursor on the first node, or at the end
+ *                         if the list is empty
+ *
+ * \param head: pointer to head.
+ * \param cursor: cursor to place
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_cursor_first(node_t * head, ll_cursor_t * cursor);
+
+/*
+ * \brief ll_cursor_last: Place a cursor on the last node, or at the end if
+ *                        the list is empty
+ *
+ * \param head: pointer to head.
+ * \param cursor: cursor to place
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_cursor_last(node_t * head, ll_cursor_t * cursor);
+
+/*
+ * \brief ll_cursor_next: Move a cursor to the next node, from the last node
+ *                        it moves to the end and from the end it wraps to
+ *                        the first node
+ *
+ * \param cursor: cursor to move
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_cursor_next(ll_cursor_t * cursor);
+
+/*
+ * \brief ll_cursor_prev: Move a cursor to the previous node, from the first
+ *                        node it moves to the end and from the end it wraps
+ *                        to the last node
+ *
+ * \param cursor: cursor to move
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_cursor_prev(ll_cursor_t * cursor);
+
+/*
+ * \brief ll_cursor_get: Get the data of the node under a cursor
+ *
+ * \param cursor: cursor to read
+ * \param data: double pointer where data will be placed
+ * \return: success, or index non existent at the end
+ *
+ */
+ll_enum_t ll_cursor_get(ll_cursor_t * cursor, void ** data);
+
+/*
+ * \brief ll_cursor_index: Get the index of the node under a cursor, the
+ *                         size of the list at the end
+ *
+ * \param cursor: cursor to read
+ * \param index: index of the node
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_cursor_index(ll_cursor_t * cursor, int32_t * index);
+
+/*
+ * \brief ll_cursor_insert_before: Insert a node before the cursor without
+ *                                 walking, the cursor stays on its node.  At
+ *                                 the end this appends.
+ *
+ * \param cursor: cursor to insert at
+ * \param data: pointer to data which will be inserted
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_cursor_insert_before(ll_cursor_t * cursor, void * data);
+
+/*
+ * \brief ll_cursor_insert_after: Insert a node after the cursor without
+ *                                walking, the cursor stays on its node.  At
+ *                                the end this inserts at the front.
+ *
+ * \param cursor: cursor to insert at
+ * \param data: pointer to data which will be inserted
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_cursor_insert_after(ll_cursor_t * cursor, void * data);
+
+/*
+ * \brief ll_cursor_remove: Remove the node under the cursor without
+ *                          walking and move the cursor to the next node
+ *
+ * \param cursor: cursor to remove at
+ * \param data: double pointer where data will be placed
+ * \return: success, or index non existent at the end
+ *
+ */
+ll_enum_t ll_cursor_remove(ll_cursor_t * cursor, void ** data);
+
+/*
+ * \brief ll_sort: Sort the list in place with a bottom up merge sort.  Nodes
+ *                 are relinked, not copied, so it takes O(n log n) compares
+ *                 and allocates nothing.  The sort is stable.
+ *
+ * \param head: pointer to head.
+ * \param less: comparison function returning 1 when data1 sorts before
+ *              data2
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_sort(node_t * head, COMPAREFUNC less);
+
+/*
+ * \brief ll_merge: Merge a sorted list into another sorted list in one pass.
+ *                  Equal items from head come before those from other.
+ *                  Other is left empty and still has to be destroyed.
+ *
+ * \param head: pointer to head of the list merged into.
+ * \param other: pointer to head of the list merged from.  Nodes move across
+ *               as they are unless either list has a pool, then other's
+ *               nodes go back to it and head gets new ones.
+ * \param less: comparison function returning 1 when data1 sorts before
+ *              data2
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_merge(node_t * head, node_t * other, COMPAREFUNC less);
+
+/*
+ * \brief ll_from_array: Insert items from an array in one go.  Every node
+ *                       is allocated before the list changes and the insert
+ *                       point is walked to once.
+ *
+ * \param head: pointer to head of the list.
+ * \param data: array of data pointers which will be inserted in order
+ * \param count: number of items in data
+ * \param index: index the first item will have, negative indices count back
+ *               from the end so INSERT_AT_END appends
+ * \return: success or error, the list is unchanged on error
+ *
+ */
+ll_enum_t ll_from_array(node_t * head, void ** data, int32_t count, int32_t index);
+
+/*
+ * \brief ll_to_array: Remove items from the front of the list into an
+ *                     array, repeated calls drain a list in batches
+ *
+ * \param head: pointer to head of the list.
+ * \param data: array the data pointers are placed in
+ * \param length: number of entries data can hold
+ * \param count: number of items moved into data
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_to_array(node_t * head, void ** data, int32_t length, int32_t * count);
+
+/*
+ * \brief ll_splice: Move a run of items from another list into this one.
+ *                   Nodes move across as they are unless either list has a
+ *                   pool, then other's nodes go back to it and head gets new
+ *                   ones.  Moving all of a heap list to either end of
+ *                   another is O(1).
+ *
+ * \param head: pointer to head of the list moved into.
+ * \param index: index the first moved item will have, negative indices
+ *               count back from the end so INSERT_AT_END appends
+ * \param other: pointer to head of the list moved from, not head.
+ * \param first: index in other of the first item to move, negative indices
+ *               count back from the end of other
+ * \param count: number of items to move
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_splice(node_t * head, int32_t index, node_t * other, int32_t first, int32_t count);
+
 /*
  * \brief ll_dump: Print all of linked list
  *
@@ -100,7 +320,8 @@ ll_enum_t ll_search(node_t * head, void * data, COMPAREFUNC func, int32_t * inde
 ll_enum_t ll_dump(node_t * head, PRINTFUNC func);
 
 /*
- * \brief ll_size: Gets the size of the list
+ * \brief ll_size: Gets the size of the list, kept by the list so this
+ *                 does not walk it
  *
  * \param head: pointer to head.
  * \param size: size of list
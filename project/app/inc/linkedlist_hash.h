@@ -0,0 +1,128 @@
+/** @file linkedlist_hash.h
+*
+* @brief Interface for linked list with a hash index, the list keeps its
+*        order and index based operations while lookups and removes by key
+*        go through the index
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __LINKEDLIST_HASH_H__
+#define __LINKEDLIST_HASH_H__
+
+#include <stdint.h>
+#include "linkedlist.h"
+
+// Export hash function definition, equal items must hash the same
+typedef uint32_t (*HASHFUNC)(void * data);
+
+// Hash indexed list typedef
+typedef struct ll_hash ll_hash_t;
+
+/*
+ * \brief ll_hash_init: Initialize a hash indexed list.  Keys are unique,
+ *                      the key of an item is whatever hash and equal look
+ *                      at in it.
+ *
+ * \param list: pointer to a pointer for the list which will be malloced.
+ * \param hash: hash function called with items and keys
+ * \param equal: comparison function called with a key and an item, returns
+ *               1 when the item has that key
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_hash_init(ll_hash_t ** list, HASHFUNC hash, COMPAREFUNC equal);
+
+/*
+ * \brief ll_hash_destroy: Destroy the list freeing its nodes and data.
+ *
+ * \param list: pointer to the list which will be freed.
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_hash_destroy(ll_hash_t * list);
+
+/*
+ * \brief ll_hash_insert: Insert data into the list and the index
+ *
+ * \param list: pointer to the list.
+ * \param data: pointer to data which will be inserted
+ * \param index: index the data will have, negative indices count back from
+ *               the end so INSERT_AT_END appends in O(1)
+ * \return: success, or failure if an item with the same key is on the list
+ *
+ */
+ll_enum_t ll_hash_insert(ll_hash_t * list, void * data, int32_t index);
+
+/*
+ * \brief ll_hash_remove: Remove data from the list and the index by index
+ *
+ * \param list: pointer to the list.
+ * \param data: double pointer where data will be placed if found
+ * \param index: index to remove, negative indices count back from the end
+ *               so REMOVE_AT_END removes the last item
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_hash_remove(ll_hash_t * list, void ** data, int32_t index);
+
+/*
+ * \brief ll_hash_lookup: Find the item with a key in O(1) through the index
+ *
+ * \param list: pointer to the list.
+ * \param key: key passed to the hash and equal functions
+ * \param data: double pointer where data will be placed if found
+ * \return: success or data not found
+ *
+ */
+ll_enum_t ll_hash_lookup(ll_hash_t * list, void * key, void ** data);
+
+/*
+ * \brief ll_hash_remove_key: Remove the item with a key in O(1) through the
+ *                            index
+ *
+ * \param list: pointer to the list.
+ * \param key: key passed to the hash and equal functions
+ * \param data: double pointer where data will be placed if found
+ * \return: success or data not found
+ *
+ */
+ll_enum_t ll_hash_remove_key(ll_hash_t * list, void * key, void ** data);
+
+/*
+ * \brief ll_hash_search: Search for data in list order using compare func,
+ *                        for matches that are not by key
+ *
+ * \param list: pointer to the list.
+ * \param data: pointer to data for comparison in compare func
+ * \param func: comparison function used to find data
+ * \param index: index of data if found
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_hash_search(ll_hash_t * list,
+                         void * data,
+                         COMPAREFUNC func,
+                         int32_t * index);
+
+/*
+ * \brief ll_hash_dump: Print all of the list in list order
+ *
+ * \param list: pointer to the list.
+ * \param func: print function used to print data
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_hash_dump(ll_hash_t * list, PRINTFUNC func);
+
+/*
+ * \brief ll_hash_size: Gets the size of the list
+ *
+ * \param list: pointer to the list.
+ * \param size: size of list
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_hash_size(ll_hash_t * list, int32_t * size);
+#endif // __LINKEDLIST_HASH_H__
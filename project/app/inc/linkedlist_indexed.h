@@ -0,0 +1,110 @@
+/** @file linkedlist_indexed.h
+*
+* @brief Interface for indexed sequence, a list with the linked list's index
+*        based operations kept in a tree ordered by position.  Each node
+*        knows the size of its subtree so finding an index, inserting and
+*        removing take expected O(log n) instead of a walk.
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __LINKEDLIST_INDEXED_H__
+#define __LINKEDLIST_INDEXED_H__
+
+#include <stdint.h>
+#include "linkedlist.h"
+
+// Indexed sequence typedef
+typedef struct ll_indexed ll_indexed_t;
+
+/*
+ * \brief ll_indexed_init: Initialize the indexed sequence.
+ *
+ * \param list: pointer to a pointer for the list which will be malloced.
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_indexed_init(ll_indexed_t ** list);
+
+/*
+ * \brief ll_indexed_destroy: Destroy the list freeing its nodes and data.
+ *
+ * \param list: pointer to the list which will be freed.
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_indexed_destroy(ll_indexed_t * list);
+
+/*
+ * \brief ll_indexed_insert: Insert data into the list in expected O(log n)
+ *
+ * \param list: pointer to the list.
+ * \param data: pointer to data which will be inserted
+ * \param index: index the data will have, negative indices count back from
+ *               the end so INSERT_AT_END appends
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_indexed_insert(ll_indexed_t * list, void * data, int32_t index);
+
+/*
+ * \brief ll_indexed_remove: Remove data from the list in expected O(log n)
+ *
+ * \param list: pointer to the list.
+ * \param data: double pointer where data will be placed if found
+ * \param index: index to remove, negative indices count back from the end
+ *               so REMOVE_AT_END removes the last item
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_indexed_remove(ll_indexed_t * list, void ** data, int32_t index);
+
+/*
+ * \brief ll_indexed_get: Get the data at an index without removing it in
+ *                        expected O(log n)
+ *
+ * \param list: pointer to the list.
+ * \param data: double pointer where data will be placed if found
+ * \param index: index to get, negative indices count back from the end so
+ *               REMOVE_AT_END gets the last item
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_indexed_get(ll_indexed_t * list, void ** data, int32_t index);
+
+/*
+ * \brief ll_indexed_search: Search for data using compare func
+ *
+ * \param list: pointer to the list.
+ * \param data: pointer to data for comparison in compare func
+ * \param func: comparison function used to find data
+ * \param index: index of data if found
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_indexed_search(ll_indexed_t * list,
+                            void * data,
+                            COMPAREFUNC func,
+                            int32_t * index);
+
+/*
+ * \brief ll_indexed_dump: Print all of the list
+ *
+ * \param list: pointer to the list.
+ * \param func: print function used to print data
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_indexed_dump(ll_indexed_t * list, PRINTFUNC func);
+
+/*
+ * \brief ll_indexed_size: Gets the size of the list
+ *
+ * \param list: pointer to the list.
+ * \param size: size of list
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_indexed_size(ll_indexed_t * list, int32_t * size);
+#endif // __LINKEDLIST_INDEXED_H__
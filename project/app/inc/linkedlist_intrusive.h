@@ -0,0 +1,122 @@
+/** @file linkedlist_intrusive.h
+*
+* @brief Interface for intrusive doubly linked list, the link lives inside
+*        the user's structure so putting an object on a list allocates
+*        nothing
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __LINKEDLIST_INTRUSIVE_H__
+#define __LINKEDLIST_INTRUSIVE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "linkedlist.h"
+
+// Link embedded in each object that can be put on a list
+typedef struct ll_link
+{
+  struct ll_link * next;
+  struct ll_link * prev;
+} ll_link_t;
+
+// Intrusive list, may live on the stack or inside another structure.  The
+// fields are only read and written by the ll_intrusive functions.
+typedef struct ll_intrusive
+{
+  ll_link_t head;
+  size_t offset;
+  int32_t count;
+} ll_intrusive_t;
+
+// Get the object that holds a link
+#define LL_CONTAINER_OF(link, type, member) \
+  ((type *)((char *)(link) - offsetof(type, member)))
+
+/*
+ * \brief ll_intrusive_init: Initialize an empty intrusive list for objects
+ *                           that hold their ll_link_t at offset
+ *
+ * \param list: pointer to the list
+ * \param offset: offsetof(type, member) of the link in the objects
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_intrusive_init(ll_intrusive_t * list, size_t offset);
+
+/*
+ * \brief ll_intrusive_insert: Insert an object into the list, its link must
+ *                             not be on another list
+ *
+ * \param list: pointer to the list
+ * \param object: pointer to the object which will be inserted
+ * \param index: index the object will have, negative indices count back
+ *               from the end so INSERT_AT_END appends
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_intrusive_insert(ll_intrusive_t * list, void * object, int32_t index);
+
+/*
+ * \brief ll_intrusive_remove: Remove an object from the list by index
+ *
+ * \param list: pointer to the list
+ * \param object: double pointer where the object will be placed
+ * \param index: index to remove, negative indices count back from the end
+ *               so REMOVE_AT_END removes the last object
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_intrusive_remove(ll_intrusive_t * list, void ** object, int32_t index);
+
+/*
+ * \brief ll_intrusive_unlink: Remove an object known to be on the list
+ *                             without walking
+ *
+ * \param list: pointer to the list
+ * \param object: pointer to the object which will be removed
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_intrusive_unlink(ll_intrusive_t * list, void * object);
+
+/*
+ * \brief ll_intrusive_search: Search for data using compare func, which is
+ *                             called with data and each object
+ *
+ * \param list: pointer to the list
+ * \param data: pointer to data for comparison in compare func
+ * \param func: comparison function used to find data
+ * \param object: double pointer where the matching object will be placed,
+ *                it can be passed to ll_intrusive_unlink
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_intrusive_search(ll_intrusive_t * list,
+                              void * data,
+                              COMPAREFUNC func,
+                              void ** object);
+
+/*
+ * \brief ll_intrusive_dump: Print all of the list, func is called with each
+ *                           object
+ *
+ * \param list: pointer to the list
+ * \param func: print function used to print objects
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_intrusive_dump(ll_intrusive_t * list, PRINTFUNC func);
+
+/*
+ * \brief ll_intrusive_size: Gets the size of the list
+ *
+ * \param list: pointer to the list
+ * \param size: size of list
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_intrusive_size(ll_intrusive_t * list, int32_t * size);
+#endif // __LINKEDLIST_INTRUSIVE_H__
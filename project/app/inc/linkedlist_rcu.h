@@ -0,0 +1,163 @@
+/** @file linkedlist_rcu.h
+*
+* @brief Interface for concurrent linked list with lock free readers.
+*        Readers walk the list inside a read section without taking a lock,
+*        writers are serialized by a mutex and removed nodes are freed once
+*        every read section that could still see them has ended.
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __LINKEDLIST_RCU_H__
+#define __LINKEDLIST_RCU_H__
+
+#include <stdint.h>
+#include "linkedlist.h"
+
+// Most readers registered with one list at the same time
+#define LL_RCU_MAX_READERS (64)
+
+// Concurrent list typedef
+typedef struct ll_rcu ll_rcu_t;
+
+/*
+ * \brief ll_rcu_init: Initialize the concurrent list.
+ *
+ * \param list: pointer to a pointer for the list which will be malloced.
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_rcu_init(ll_rcu_t ** list);
+
+/*
+ * \brief ll_rcu_destroy: Destroy the list freeing its nodes and data,
+ *                        including removed ones still waiting to be freed.
+ *                        No other thread may be using the list.
+ *
+ * \param list: pointer to the list which will be freed.
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_rcu_destroy(ll_rcu_t * list);
+
+/*
+ * \brief ll_rcu_register: Claim a reader slot for a thread, each thread
+ *                         reading the list needs its own
+ *
+ * \param list: pointer to the list.
+ * \param reader: slot number passed to the read section calls
+ * \return: success, or failure if all LL_RCU_MAX_READERS slots are taken
+ *
+ */
+ll_enum_t ll_rcu_register(ll_rcu_t * list, uint32_t * reader);
+
+/*
+ * \brief ll_rcu_unregister: Give back a reader slot, the thread must not be
+ *                           inside a read section
+ *
+ * \param list: pointer to the list.
+ * \param reader: slot number from ll_rcu_register
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_rcu_unregister(ll_rcu_t * list, uint32_t reader);
+
+/*
+ * \brief ll_rcu_read_lock: Start a read section.  Data found by search or
+ *                          dump stays valid until the section ends.  Takes
+ *                          no lock and never waits for writers.
+ *
+ * \param list: pointer to the list.
+ * \param reader: slot number from ll_rcu_register
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_rcu_read_lock(ll_rcu_t * list, uint32_t reader);
+
+/*
+ * \brief ll_rcu_read_unlock: End a read section
+ *
+ * \param list: pointer to the list.
+ * \param reader: slot number from ll_rcu_register
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_rcu_read_unlock(ll_rcu_t * list, uint32_t reader);
+
+/*
+ * \brief ll_rcu_search: Search for data using compare func, must be called
+ *                       inside a read section
+ *
+ * \param list: pointer to the list.
+ * \param data: pointer to data for comparison in compare func
+ * \param func: comparison function used to find data
+ * \param found: data of the first match
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_rcu_search(ll_rcu_t * list,
+                        void * data,
+                        COMPAREFUNC func,
+                        void ** found);
+
+/*
+ * \brief ll_rcu_dump: Print all of the list, must be called inside a read
+ *                     section.  Items inserted or removed during the dump
+ *                     may or may not be seen.
+ *
+ * \param list: pointer to the list.
+ * \param func: print function used to print data
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_rcu_dump(ll_rcu_t * list, PRINTFUNC func);
+
+/*
+ * \brief ll_rcu_insert: Insert data into the list, waits for other writers
+ *
+ * \param list: pointer to the list.
+ * \param data: pointer to data which will be inserted
+ * \param index: index the data will have, negative indices count back from
+ *               the end so INSERT_AT_END appends
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_rcu_insert(ll_rcu_t * list, void * data, int32_t index);
+
+/*
+ * \brief ll_rcu_remove: Remove the first data matching compare func, waits
+ *                       for other writers.  The node and its data are freed
+ *                       once no read section can still see them.
+ *
+ * \param list: pointer to the list.
+ * \param data: pointer to data for comparison in compare func
+ * \param func: comparison function used to find data
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_rcu_remove(ll_rcu_t * list, void * data, COMPAREFUNC func);
+
+/*
+ * \brief ll_rcu_synchronize: Wait until every read section that started
+ *                            before the call has ended and free everything
+ *                            removed so far.  Must not be called inside a
+ *                            read section.
+ *
+ * \param list: pointer to the list.
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_rcu_synchronize(ll_rcu_t * list);
+
+/*
+ * \brief ll_rcu_size: Gets the size of the list, may be stale by the time
+ *                     it is returned
+ *
+ * \param list: pointer to the list.
+ * \param size: size of list
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_rcu_size(ll_rcu_t * list, int32_t * size);
+#endif // __LINKEDLIST_RCU_H__
@@ -0,0 +1,108 @@
+/** @file linkedlist_skip.h
+*
+* @brief Interface for ordered skip list, items are kept sorted by a compare
+*        function and found through express lanes of links in expected
+*        O(log n)
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __LINKEDLIST_SKIP_H__
+#define __LINKEDLIST_SKIP_H__
+
+#include <stdint.h>
+#include "linkedlist.h"
+
+// Most levels a node can have, enough for 4^16 items
+#define LL_SKIP_MAX_LEVEL (16)
+
+// Skip list typedef
+typedef struct ll_skip ll_skip_t;
+
+/*
+ * \brief ll_skip_init: Initialize the skip list.
+ *
+ * \param list: pointer to a pointer for the list which will be malloced.
+ * \param less: comparison function returning 1 when data1 sorts before
+ *              data2, items where neither sorts before the other are equal
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_skip_init(ll_skip_t ** list, COMPAREFUNC less);
+
+/*
+ * \brief ll_skip_destroy: Destroy the list freeing its nodes and data.
+ *
+ * \param list: pointer to the list which will be freed.
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_skip_destroy(ll_skip_t * list);
+
+/*
+ * \brief ll_skip_insert: Insert data in order, after any equal items
+ *
+ * \param list: pointer to the list.
+ * \param data: pointer to data which will be inserted
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_skip_insert(ll_skip_t * list, void * data);
+
+/*
+ * \brief ll_skip_remove: Remove the first item equal to a key
+ *
+ * \param list: pointer to the list.
+ * \param key: key passed to the compare function
+ * \param data: double pointer where data will be placed if found
+ * \return: success or data not found
+ *
+ */
+ll_enum_t ll_skip_remove(ll_skip_t * list, void * key, void ** data);
+
+/*
+ * \brief ll_skip_lookup: Find the first item equal to a key
+ *
+ * \param list: pointer to the list.
+ * \param key: key passed to the compare function
+ * \param data: double pointer where data will be placed if found
+ * \return: success or data not found
+ *
+ */
+ll_enum_t ll_skip_lookup(ll_skip_t * list, void * key, void ** data);
+
+/*
+ * \brief ll_skip_range: Call the print function on items from low up to but
+ *                       not including high in order
+ *
+ * \param list: pointer to the list.
+ * \param low: first key in the range, NULL starts at the first item
+ * \param high: key ending the range, NULL runs to the last item
+ * \param func: print function called with each item and its index in the
+ *              range
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_skip_range(ll_skip_t * list, void * low, void * high, PRINTFUNC func);
+
+/*
+ * \brief ll_skip_dump: Print all of the list in order
+ *
+ * \param list: pointer to the list.
+ * \param func: print function used to print data
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_skip_dump(ll_skip_t * list, PRINTFUNC func);
+
+/*
+ * \brief ll_skip_size: Gets the size of the list
+ *
+ * \param list: pointer to the list.
+ * \param size: size of list
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_skip_size(ll_skip_t * list, int32_t * size);
+#endif // __LINKEDLIST_SKIP_H__
@@ -0,0 +1,103 @@
+/** @file linkedlist_unrolled.h
+*
+* @brief Interface for unrolled doubly linked list, each node holds a small
+*        array of data pointers so a walk touches one cache line per
+*        several items instead of one per item
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __LINKEDLIST_UNROLLED_H__
+#define __LINKEDLIST_UNROLLED_H__
+
+#include <stdint.h>
+#include "linkedlist.h"
+
+// Data pointers held by each node, with the links and count a node fills
+// two 64 byte cache lines
+#define LL_UNROLLED_SLOTS (13)
+
+// Unrolled list typedef
+typedef struct ll_unrolled ll_unrolled_t;
+
+/*
+ * \brief ll_unrolled_init: Initialize the unrolled linked list.
+ *
+ * \param list: pointer to a pointer for the list which will be malloced.
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_unrolled_init(ll_unrolled_t ** list);
+
+/*
+ * \brief ll_unrolled_destroy: Destroy the list freeing its nodes and data.
+ *
+ * \param list: pointer to the list which will be freed.
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_unrolled_destroy(ll_unrolled_t * list);
+
+/*
+ * \brief ll_unrolled_insert: Insert data into the list, a full node is split
+ *                            in half to make room
+ *
+ * \param list: pointer to the list.
+ * \param data: pointer to data which will be inserted
+ * \param index: index the data will have, negative indices count back from
+ *               the end so INSERT_AT_END appends
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_unrolled_insert(ll_unrolled_t * list, void * data, int32_t index);
+
+/*
+ * \brief ll_unrolled_remove: Remove data from the list, a node that drops
+ *                            under half full is merged with a neighbour
+ *                            when they fit in one node
+ *
+ * \param list: pointer to the list.
+ * \param data: double pointer where data will be placed if found
+ * \param index: index to remove, negative indices count back from the end
+ *               so REMOVE_AT_END removes the last item
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_unrolled_remove(ll_unrolled_t * list, void ** data, int32_t index);
+
+/*
+ * \brief ll_unrolled_search: Search for data using compare func
+ *
+ * \param list: pointer to the list.
+ * \param data: pointer to data for comparison in compare func
+ * \param func: comparison function used to find data
+ * \param index: index of data if found
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_unrolled_search(ll_unrolled_t * list,
+                             void * data,
+                             COMPAREFUNC func,
+                             int32_t * index);
+
+/*
+ * \brief ll_unrolled_dump: Print all of the list
+ *
+ * \param list: pointer to the list.
+ * \param func: print function used to print data
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_unrolled_dump(ll_unrolled_t * list, PRINTFUNC func);
+
+/*
+ * \brief ll_unrolled_size: Gets the size of the list
+ *
+ * \param list: pointer to the list.
+ * \param size: size of list
+ * \return: success or error
+ *
+ */
+ll_enum_t ll_unrolled_size(ll_unrolled_t * list, int32_t * size);
+#endif // __LINKEDLIST_UNROLLED_H__
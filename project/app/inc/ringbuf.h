@@ -0,0 +1,119 @@
+/** @file ringbuf.h
+*
+* @brief Interface for byte ring buffer holding variable length records.
+*        Records are written and read in place, a single producer calls
+*        reserve/commit and a single consumer calls read/release.
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __RINGBUF_H__
+#define __RINGBUF_H__
+
+#include <stdint.h>
+#include "circbuf.h"
+
+// Ring buffer typedef
+typedef struct ringbuf ringbuf_t;
+
+/*
+ * \brief ringbuf_init: Initialize a byte ring buffer, the size is rounded
+ *                      up to a power of two
+ *
+ * \param ring: pointer to a pointer for the ring buffer structure
+ * \param size: minimum size of the ring in bytes
+ * \return: success or error
+ *
+ */
+cb_enum_t ringbuf_init(ringbuf_t ** ring, uint32_t size);
+
+/*
+ * \brief ringbuf_init_mirrored: Initialize a byte ring buffer whose pages
+ *                               are mapped twice back to back, so a record
+ *                               running past the end of the ring continues
+ *                               in the mirror and is always contiguous.
+ *                               The size is rounded up to a power of two
+ *                               and at least a page.
+ *
+ * \param ring: pointer to a pointer for the ring buffer structure
+ * \param size: minimum size of the ring in bytes
+ * \return: success or error
+ *
+ */
+cb_enum_t ringbuf_init_mirrored(ringbuf_t ** ring, uint32_t size);
+
+/*
+ * \brief ringbuf_destroy: frees the ring and the structure
+ *
+ * \param ring: pointer to the ring buffer structure
+ * \return: success or error
+ *
+ */
+cb_enum_t ringbuf_destroy(ringbuf_t * ring);
+
+/*
+ * \brief ringbuf_reserve: reserves room for a record of length bytes and
+ *                         returns where to write it.  The record is not
+ *                         visible to the consumer until it is committed.
+ *
+ * \param ring: pointer to the ring buffer structure
+ * \param length: number of bytes to reserve
+ * \param record: location where the pointer to the record is placed
+ * \return: success, full if there is no room or failure if the record can
+ *          never fit
+ *
+ */
+cb_enum_t ringbuf_reserve(ringbuf_t * ring, uint32_t length, void ** record);
+
+/*
+ * \brief ringbuf_commit: publishes the reserved record to the consumer
+ *
+ * \param ring: pointer to the ring buffer structure
+ * \param length: number of bytes written, up to the reserved length
+ * \return: success or error
+ *
+ */
+cb_enum_t ringbuf_commit(ringbuf_t * ring, uint32_t length);
+
+/*
+ * \brief ringbuf_read: gets the oldest record in place without removing it
+ *
+ * \param ring: pointer to the ring buffer structure
+ * \param record: location where the pointer to the record is placed
+ * \param length: location where the record length is placed
+ * \return: success or empty
+ *
+ */
+cb_enum_t ringbuf_read(ringbuf_t * ring, void ** record, uint32_t * length);
+
+/*
+ * \brief ringbuf_release: gives the record returned by ringbuf_read back to
+ *                         the producer
+ *
+ * \param ring: pointer to the ring buffer structure
+ * \return: success or error
+ *
+ */
+cb_enum_t ringbuf_release(ringbuf_t * ring);
+
+/*
+ * \brief ringbuf_size: gets the size of the ring after rounding
+ *
+ * \param ring: pointer to the ring buffer structure
+ * \param size: location where the size in bytes is placed
+ * \return: success or error
+ *
+ */
+cb_enum_t ringbuf_size(ringbuf_t * ring, uint32_t * size);
+
+/*
+ * \brief ringbuf_empty: checks if there are no committed records, the
+ *                       result may be stale by the time it is returned
+ *
+ * \param ring: pointer to the ring buffer structure
+ * \return: empty if empty or failure if not empty
+ *
+ */
+cb_enum_t ringbuf_empty(ringbuf_t * ring);
+#endif // __RINGBUF_H__
@@ -67,6 +67,57 @@ void test_circbuf_wrap_remove(void **state);
  */
 void test_circbuf_check_full(void **state);
 
+/*
+ * \brief test_circbuf_add_remove_items: test batch add and remove across
+ *                                       the wrap and mixed with single items
+ *
+ */
+void test_circbuf_add_remove_items(void **state);
+
+/*
+ * \brief test_circbuf_peek_spans: test the readable region is returned as
+ *                                 two spans when it wraps
+ *
+ */
+void test_circbuf_peek_spans(void **state);
+
+/*
+ * \brief test_circbuf_overwrite: test overwrite mode keeps the newest items
+ *                               and counts and reports dropped items
+ *
+ */
+void test_circbuf_overwrite(void **state);
+
+/*
+ * \brief test_circbuf_overwrite_items: test batch adds in overwrite mode
+ *                                     drop the oldest items
+ *
+ */
+void test_circbuf_overwrite_items(void **state);
+
+/*
+ * \brief test_circbuf_notify: test the notify descriptor is signaled once
+ *                            per empty/full transition and can be polled
+ *                            across buffers
+ *
+ */
+void test_circbuf_notify(void **state);
+
+/*
+ * \brief test_circbuf_growable: test a growable buffer keeps items in order
+ *                              while growing past the uint16_t limit, stops
+ *                              at its max length and shrinks when quiet
+ *
+ */
+void test_circbuf_growable(void **state);
+
+/*
+ * \brief test_circbuf_stats: test adds, removes, rejections, high water mark
+ *                           and histogram are counted, dumped and reset
+ *
+ */
+void test_circbuf_stats(void **state);
+
 #ifdef UNITTEST
 /*
  * \brief test_circbuf_check_empty: test circbuf_empty function works
@@ -0,0 +1,47 @@
+/** @file unit_circbuf_mpmc.h
+*
+* @brief Declarations for unit circbuf mpmc
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __UNIT_CIRCBUF_MPMC_H__
+#define __UNIT_CIRCBUF_MPMC_H__
+
+/*
+ * \brief test_circbuf_mpmc_init_destroy: test init and destroy under normal
+ *                                        operations
+ *
+ */
+void test_circbuf_mpmc_init_destroy(void **state);
+
+/*
+ * \brief test_circbuf_mpmc_ops_null_ptr: test mpmc operations handle null
+ *                                        pointers
+ *
+ */
+void test_circbuf_mpmc_ops_null_ptr(void **state);
+
+/*
+ * \brief test_circbuf_mpmc_add_remove_full: test filling, overfilling,
+ *                                           wrapping and draining the buffer
+ *
+ */
+void test_circbuf_mpmc_add_remove_full(void **state);
+
+/*
+ * \brief test_circbuf_mpmc_length_one: test a length of one still holds two
+ *                                      items and never overwrites one
+ *
+ */
+void test_circbuf_mpmc_length_one(void **state);
+
+/*
+ * \brief test_circbuf_mpmc_threads: test several producers and consumers
+ *                                   pass every item exactly once
+ *
+ */
+void test_circbuf_mpmc_threads(void **state);
+
+#endif // __UNIT_CIRCBUF_MPMC_H__
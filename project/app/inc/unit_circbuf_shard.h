@@ -0,0 +1,57 @@
+/** @file unit_circbuf_shard.h
+*
+* @brief Declarations for unit circbuf shard
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __UNIT_CIRCBUF_SHARD_H__
+#define __UNIT_CIRCBUF_SHARD_H__
+
+/*
+ * \brief test_circbuf_shard_init_destroy: test init and destroy with a
+ *                                         given and a default shard count
+ *
+ */
+void test_circbuf_shard_init_destroy(void **state);
+
+/*
+ * \brief test_circbuf_shard_ops_null_ptr: test shard operations handle null
+ *                                         pointers
+ *
+ */
+void test_circbuf_shard_ops_null_ptr(void **state);
+
+/*
+ * \brief test_circbuf_shard_spill_steal: test adds spill to other shards
+ *                                        when the local one is full and
+ *                                        removes steal them back
+ *
+ */
+void test_circbuf_shard_spill_steal(void **state);
+
+/*
+ * \brief test_circbuf_shard_batch_steal: test a single remove on a dry shard
+ *                                        steals a batch that serves the next
+ *                                        removes locally
+ *
+ */
+void test_circbuf_shard_batch_steal(void **state);
+
+/*
+ * \brief test_circbuf_shard_steal_order: test items stolen into a spill
+ *                                        still come out before the newer
+ *                                        ones left in their shard
+ *
+ */
+void test_circbuf_shard_steal_order(void **state);
+
+/*
+ * \brief test_circbuf_shard_threads: test producer and consumer threads
+ *                                    pass every item exactly once
+ *
+ */
+void test_circbuf_shard_threads(void **state);
+
+#endif // __UNIT_CIRCBUF_SHARD_H__
@@ -0,0 +1,55 @@
+/** @file unit_circbuf_shm.h
+*
+* @brief Declarations for unit circbuf shm
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __UNIT_CIRCBUF_SHM_H__
+#define __UNIT_CIRCBUF_SHM_H__
+
+/*
+ * \brief test_circbuf_shm_init_destroy: test anonymous and named buffers
+ *                                       are created, opened and destroyed
+ *
+ */
+void test_circbuf_shm_init_destroy(void **state);
+
+/*
+ * \brief test_circbuf_shm_ops_null_ptr: test shm operations handle null
+ *                                       pointers
+ *
+ */
+void test_circbuf_shm_ops_null_ptr(void **state);
+
+/*
+ * \brief test_circbuf_shm_add_remove_full: test items are copied in and out
+ *                                          and full/empty are detected
+ *
+ */
+void test_circbuf_shm_add_remove_full(void **state);
+
+/*
+ * \brief test_circbuf_shm_fork: test a forked producer process passes items
+ *                               to the parent through blocking operations
+ *
+ */
+void test_circbuf_shm_fork(void **state);
+
+/*
+ * \brief test_circbuf_shm_open_checks: test open refuses segments that are
+ *                                      not valid buffers and only the
+ *                                      creator unlinks the name
+ *
+ */
+void test_circbuf_shm_open_checks(void **state);
+
+/*
+ * \brief test_circbuf_shm_peer_header: test a header rewritten after open
+ *                                      can not move copies past the mapping
+ *
+ */
+void test_circbuf_shm_peer_header(void **state);
+
+#endif // __UNIT_CIRCBUF_SHM_H__
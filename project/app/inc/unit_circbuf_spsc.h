@@ -0,0 +1,61 @@
+/** @file unit_circbuf_spsc.h
+*
+* @brief Declarations for unit circbuf spsc
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __UNIT_CIRCBUF_SPSC_H__
+#define __UNIT_CIRCBUF_SPSC_H__
+
+/*
+ * \brief test_circbuf_spsc_init_destroy: test init and destroy under normal
+ *                                        operations
+ *
+ */
+void test_circbuf_spsc_init_destroy(void **state);
+
+/*
+ * \brief test_circbuf_spsc_ops_null_ptr: test spsc operations handle null
+ *                                        pointers
+ *
+ */
+void test_circbuf_spsc_ops_null_ptr(void **state);
+
+/*
+ * \brief test_circbuf_spsc_add_remove_full: test filling, overfilling and
+ *                                           draining the buffer
+ *
+ */
+void test_circbuf_spsc_add_remove_full(void **state);
+
+/*
+ * \brief test_circbuf_spsc_wrap: test that head and tail wrap correctly
+ *
+ */
+void test_circbuf_spsc_wrap(void **state);
+
+/*
+ * \brief test_circbuf_spsc_threads: test a producer and consumer thread
+ *                                   pass items in order without locks
+ *
+ */
+void test_circbuf_spsc_threads(void **state);
+
+/*
+ * \brief test_circbuf_spsc_wait_timeout: test blocking operations return
+ *                                       full/empty once the timeout passes
+ *
+ */
+void test_circbuf_spsc_wait_timeout(void **state);
+
+/*
+ * \brief test_circbuf_spsc_wait_threads: test a producer and consumer thread
+ *                                       pass every item using blocking
+ *                                       operations
+ *
+ */
+void test_circbuf_spsc_wait_threads(void **state);
+
+#endif // __UNIT_CIRCBUF_SPSC_H__
@@ -0,0 +1,34 @@
+/** @file unit_circbuf_typed.h
+*
+* @brief Declarations for unit circbuf typed
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __UNIT_CIRCBUF_TYPED_H__
+#define __UNIT_CIRCBUF_TYPED_H__
+
+/*
+ * \brief test_circbuf_typed_ops_null_ptr: test generated functions handle
+ *                                         null pointers
+ *
+ */
+void test_circbuf_typed_ops_null_ptr(void **state);
+
+/*
+ * \brief test_circbuf_typed_add_remove_full: test items are copied in and
+ *                                            out in order and full/empty
+ *                                            are detected
+ *
+ */
+void test_circbuf_typed_add_remove_full(void **state);
+
+/*
+ * \brief test_circbuf_typed_counter_wrap: test the buffer keeps working when
+ *                                         the head and tail counters wrap
+ *
+ */
+void test_circbuf_typed_counter_wrap(void **state);
+
+#endif // __UNIT_CIRCBUF_TYPED_H__
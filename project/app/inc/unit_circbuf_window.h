@@ -0,0 +1,47 @@
+/** @file unit_circbuf_window.h
+*
+* @brief Declarations for unit circbuf window
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __UNIT_CIRCBUF_WINDOW_H__
+#define __UNIT_CIRCBUF_WINDOW_H__
+
+/*
+ * \brief test_circbuf_window_ops_null_ptr: test window operations handle
+ *                                          null pointers and bad sizes
+ *
+ */
+void test_circbuf_window_ops_null_ptr(void **state);
+
+/*
+ * \brief test_circbuf_window_empty: test queries on an empty window
+ *
+ */
+void test_circbuf_window_empty(void **state);
+
+/*
+ * \brief test_circbuf_window_aggregates: test min, max, sum and mean match
+ *                                        a full scan of the window as it
+ *                                        slides
+ *
+ */
+void test_circbuf_window_aggregates(void **state);
+
+/*
+ * \brief test_circbuf_window_percentile: test percentiles are within one
+ *                                        bucket of the exact value
+ *
+ */
+void test_circbuf_window_percentile(void **state);
+
+/*
+ * \brief test_circbuf_window_non_finite: test NaN and infinite samples are
+ *                                        refused without touching the window
+ *
+ */
+void test_circbuf_window_non_finite(void **state);
+
+#endif // __UNIT_CIRCBUF_WINDOW_H__
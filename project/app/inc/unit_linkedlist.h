@@ -45,4 +45,48 @@ void test_ll_search(void **state);
  */
 void test_ll_size(void **state);
 
+/*
+ * \brief test_ll_pool: test a list whose nodes come from a slab pool
+ *
+ */
+void test_ll_pool(void **state);
+
+/*
+ * \brief test_ll_ends: test tail operations, size and negative indices
+ *
+ */
+void test_ll_ends(void **state);
+
+/*
+ * \brief test_ll_cursor: test walking and editing a list with a cursor
+ *
+ */
+void test_ll_cursor(void **state);
+
+/*
+ * \brief test_ll_sort: test sorting keeps equal items in order
+ *
+ */
+void test_ll_sort(void **state);
+
+/*
+ * \brief test_ll_merge: test merging sorted lists with and without pools
+ *
+ */
+void test_ll_merge(void **state);
+
+/*
+ * \brief test_ll_bulk: test building a list from arrays and draining it
+ *                      into one
+ *
+ */
+void test_ll_bulk(void **state);
+
+/*
+ * \brief test_ll_splice: test moving runs of items between lists with and
+ *                        without pools
+ *
+ */
+void test_ll_splice(void **state);
+
 #endif // __UNIT_LINKEDLIST_H__
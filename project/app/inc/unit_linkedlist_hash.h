@@ -0,0 +1,33 @@
+/** @file unit_linkedlist_hash.h
+*
+* @brief Declarations for unit hash indexed linked list
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __UNIT_LINKEDLIST_HASH_H__
+#define __UNIT_LINKEDLIST_HASH_H__
+
+/*
+ * \brief test_ll_hash_ops_null_ptr: test hash list operations handle null
+ *                                   pointers gracefully
+ *
+ */
+void test_ll_hash_ops_null_ptr(void **state);
+
+/*
+ * \brief test_ll_hash_lookup: test lookups and unique keys while the index
+ *                             grows
+ *
+ */
+void test_ll_hash_lookup(void **state);
+
+/*
+ * \brief test_ll_hash_order: test removes by key and by index keep the list
+ *                            order and the index in step
+ *
+ */
+void test_ll_hash_order(void **state);
+
+#endif // __UNIT_LINKEDLIST_HASH_H__
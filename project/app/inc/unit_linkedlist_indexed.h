@@ -0,0 +1,33 @@
+/** @file unit_linkedlist_indexed.h
+*
+* @brief Declarations for unit indexed sequence
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __UNIT_LINKEDLIST_INDEXED_H__
+#define __UNIT_LINKEDLIST_INDEXED_H__
+
+/*
+ * \brief test_ll_indexed_ops_null_ptr: test indexed sequence operations
+ *                                      handle null pointers gracefully
+ *
+ */
+void test_ll_indexed_ops_null_ptr(void **state);
+
+/*
+ * \brief test_ll_indexed_insert_remove: test inserts, removes and gets at
+ *                                       random indices against an array
+ *
+ */
+void test_ll_indexed_insert_remove(void **state);
+
+/*
+ * \brief test_ll_indexed_search_destroy: test search and destroy freeing
+ *                                        the data
+ *
+ */
+void test_ll_indexed_search_destroy(void **state);
+
+#endif // __UNIT_LINKEDLIST_INDEXED_H__
@@ -0,0 +1,40 @@
+/** @file unit_linkedlist_intrusive.h
+*
+* @brief Declarations for unit intrusive linked list
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __UNIT_LINKEDLIST_INTRUSIVE_H__
+#define __UNIT_LINKEDLIST_INTRUSIVE_H__
+
+/*
+ * \brief test_ll_intrusive_ops_null_ptr: test intrusive list operations
+ *                                        handle null pointers gracefully
+ *
+ */
+void test_ll_intrusive_ops_null_ptr(void **state);
+
+/*
+ * \brief test_ll_intrusive_insert_remove: test insert and remove by index
+ *                                         at both ends and in the middle
+ *
+ */
+void test_ll_intrusive_insert_remove(void **state);
+
+/*
+ * \brief test_ll_intrusive_search_dump: test search and dump hand the
+ *                                       callbacks the containing objects
+ *
+ */
+void test_ll_intrusive_search_dump(void **state);
+
+/*
+ * \brief test_ll_intrusive_two_lists: test an object with two links sitting
+ *                                     on two lists at once
+ *
+ */
+void test_ll_intrusive_two_lists(void **state);
+
+#endif // __UNIT_LINKEDLIST_INTRUSIVE_H__
@@ -0,0 +1,33 @@
+/** @file unit_linkedlist_rcu.h
+*
+* @brief Declarations for unit concurrent linked list
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __UNIT_LINKEDLIST_RCU_H__
+#define __UNIT_LINKEDLIST_RCU_H__
+
+/*
+ * \brief test_ll_rcu_ops_null_ptr: test concurrent list operations handle
+ *                                  null pointers and bad reader slots
+ *
+ */
+void test_ll_rcu_ops_null_ptr(void **state);
+
+/*
+ * \brief test_ll_rcu_insert_remove: test single threaded inserts, searches
+ *                                   and removes
+ *
+ */
+void test_ll_rcu_insert_remove(void **state);
+
+/*
+ * \brief test_ll_rcu_threads: test readers walking the list while a writer
+ *                             inserts and removes never see freed data
+ *
+ */
+void test_ll_rcu_threads(void **state);
+
+#endif // __UNIT_LINKEDLIST_RCU_H__
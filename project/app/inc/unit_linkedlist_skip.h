@@ -0,0 +1,32 @@
+/** @file unit_linkedlist_skip.h
+*
+* @brief Declarations for unit skip list
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __UNIT_LINKEDLIST_SKIP_H__
+#define __UNIT_LINKEDLIST_SKIP_H__
+
+/*
+ * \brief test_ll_skip_ops_null_ptr: test skip list operations handle null
+ *                                   pointers gracefully
+ *
+ */
+void test_ll_skip_ops_null_ptr(void **state);
+
+/*
+ * \brief test_ll_skip_insert_remove: test random inserts and removes keep
+ *                                    the list sorted and stable
+ *
+ */
+void test_ll_skip_insert_remove(void **state);
+
+/*
+ * \brief test_ll_skip_range: test range iteration bounds
+ *
+ */
+void test_ll_skip_range(void **state);
+
+#endif // __UNIT_LINKEDLIST_SKIP_H__
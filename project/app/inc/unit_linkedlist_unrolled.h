@@ -0,0 +1,34 @@
+/** @file unit_linkedlist_unrolled.h
+*
+* @brief Declarations for unit unrolled linked list
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __UNIT_LINKEDLIST_UNROLLED_H__
+#define __UNIT_LINKEDLIST_UNROLLED_H__
+
+/*
+ * \brief test_ll_unrolled_ops_null_ptr: test unrolled list operations
+ *                                       handle null pointers gracefully
+ *
+ */
+void test_ll_unrolled_ops_null_ptr(void **state);
+
+/*
+ * \brief test_ll_unrolled_insert_remove: test inserts and removes at random
+ *                                        indices against an array, crossing
+ *                                        node splits and merges
+ *
+ */
+void test_ll_unrolled_insert_remove(void **state);
+
+/*
+ * \brief test_ll_unrolled_search_destroy: test search and destroy freeing
+ *                                         the data
+ *
+ */
+void test_ll_unrolled_search_destroy(void **state);
+
+#endif // __UNIT_LINKEDLIST_UNROLLED_H__
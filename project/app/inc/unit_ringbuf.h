@@ -0,0 +1,54 @@
+/** @file unit_ringbuf.h
+*
+* @brief Declarations for unit ring buffer
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#ifndef __UNIT_RINGBUF_H__
+#define __UNIT_RINGBUF_H__
+
+/*
+ * \brief test_ringbuf_init_destroy: test ringbuf_init ringbuf_destroy under
+ *                                   normal operations
+ *
+ */
+void test_ringbuf_init_destroy(void **state);
+
+/*
+ * \brief test_ringbuf_ops_null_ptr: test ring operations handle null
+ *                                   pointers
+ *
+ */
+void test_ringbuf_ops_null_ptr(void **state);
+
+/*
+ * \brief test_ringbuf_reserve_commit: test records of different lengths
+ *                                     come back in order and intact
+ *
+ */
+void test_ringbuf_reserve_commit(void **state);
+
+/*
+ * \brief test_ringbuf_full_wrap: test full detection and records wrapping
+ *                                to the beginning of the ring
+ *
+ */
+void test_ringbuf_full_wrap(void **state);
+
+/*
+ * \brief test_ringbuf_mirrored: test records running past the end of a
+ *                               mirrored ring are contiguous
+ *
+ */
+void test_ringbuf_mirrored(void **state);
+
+/*
+ * \brief test_ringbuf_threads: test a producer and consumer thread pass
+ *                              records in place
+ *
+ */
+void test_ringbuf_threads(void **state);
+
+#endif // __UNIT_RINGBUF_H__
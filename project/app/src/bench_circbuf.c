@@ -0,0 +1,991 @@
+/** @file bench_circbuf.c
+*
+* @brief Throughput benchmarks for the circular buffers.  Build with
+*        LOG_LEVEL=1 so FUNC_ENTRY logging is not part of the measurement.
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "circbuf.h"
+#include "circbuf_mpmc.h"
+#include "circbuf_shard.h"
+#include "circbuf_shm.h"
+#include "circbuf_spsc.h"
+#include "circbuf_typed.h"
+#include "circbuf_window.h"
+#include "log.h"
+#include "ringbuf.h"
+#include "profiler.h"
+#include "project_defs.h"
+
+// Number of items moved through a buffer in each benchmark
+#define BENCH_ITEMS (10000000)
+
+// Length of the buffer used in each benchmark
+#define BENCH_BUF_SIZE (1024)
+
+// Length of the buffer filled and drained by the batch benchmark
+#define BENCH_BATCH_SIZE (10000)
+
+// Records queued before they are drained by the record benchmark
+#define BENCH_BURST (64)
+
+// Record length used by the record benchmark for record i
+#define BENCH_RECORD_LENGTH(i) (16 + ((i) % 16) * 16)
+
+// Number of items in a burst that needs a growable buffer
+#define BENCH_BIG_BURST (1 << 20)
+
+// Number of samples added, each followed by a min/max/mean query
+#define BENCH_WINDOW_QUERIES (100000)
+
+// Number of ping/pong round trips between processes
+#define BENCH_ROUND_TRIPS (100000)
+
+// Benchmark entry
+typedef struct bench
+{
+  const char * name;
+  void (*func)(void);
+} bench_t;
+
+// Shared state for the producer/consumer scaling benchmark
+typedef struct scale
+{
+  void * buf;
+  cb_enum_t (*add)(void * buf, void * payload);
+  cb_enum_t (*remove)(void * buf, void ** payload);
+  uint32_t items;
+  uint32_t total;
+  uint32_t consumed;
+} scale_t;
+
+// Small fixed size sample for the typed buffer benchmark
+typedef struct sample
+{
+  uint32_t id;
+  uint32_t flags;
+  uint64_t value;
+} sample_t;
+
+CIRCBUF_DEFINE(sample_ring, sample_t, BENCH_BUF_SIZE)
+
+// Results written here so benchmark loops are not optimized away
+uint64_t bench_sink;
+
+uint32_t abort_signal;
+uint8_t timer;
+
+// Generic circbuf protected by a mutex for the baseline
+static circbuf_t * mutex_buf;
+static pthread_mutex_t mutex_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*!
+* @brief Log the operations per second for a benchmark
+* @param[in] name name of the benchmark
+* @param[in] ops number of operations performed
+* @param[in] diff time taken to perform the operations
+*/
+static void report(const char * name, uint64_t ops, struct timespec * diff)
+{
+  double sec = (double)diff->tv_sec + (double)diff->tv_nsec / 1000000000;
+
+  LOG_HIGH("%-16s %10llu ops in %8.4f sec, %12.0f ops/sec",
+           name,
+           (unsigned long long)ops,
+           sec,
+           (double)ops / sec);
+} // report()
+
+/*!
+* @brief Producer for the mutex wrapped circbuf
+* @param[in] param not used
+* @return NULL
+*/
+static void * mutex_producer(void * param)
+{
+  cb_enum_t res;
+
+  for (uintptr_t i = 1; i <= BENCH_ITEMS; i++)
+  {
+    do
+    {
+      pthread_mutex_lock(&mutex_lock);
+      res = circbuf_add_item(mutex_buf, (void *)i);
+      pthread_mutex_unlock(&mutex_lock);
+
+      // Give the consumer a chance to run when full
+      if (res == CB_ENUM_FULL)
+      {
+        sched_yield();
+      }
+    } while (res == CB_ENUM_FULL);
+  }
+
+  return NULL;
+} // mutex_producer()
+
+/*!
+* @brief Two thread transfer through a mutex wrapped circbuf
+*/
+static void bench_mutex(void)
+{
+  pthread_t producer;
+  struct timespec diff;
+  void * payload;
+  cb_enum_t res;
+
+  if (circbuf_init(&mutex_buf, BENCH_BUF_SIZE) != CB_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create circbuf");
+    return;
+  }
+
+  START_TIME;
+  pthread_create(&producer, NULL, mutex_producer, NULL);
+  for (uint32_t i = 0; i < BENCH_ITEMS;)
+  {
+    pthread_mutex_lock(&mutex_lock);
+    res = circbuf_remove_item(mutex_buf, &payload);
+    pthread_mutex_unlock(&mutex_lock);
+    if (res == CB_ENUM_NO_ERROR)
+    {
+      i++;
+    }
+    else
+    {
+      sched_yield();
+    }
+  }
+  pthread_join(producer, NULL);
+  GET_TIME;
+
+  report("mutex circbuf", BENCH_ITEMS, &diff);
+  circbuf_destroy(mutex_buf);
+} // bench_mutex()
+
+/*!
+* @brief Producer for the spsc circbuf
+* @param[in] param pointer to spsc circbuf
+* @return NULL
+*/
+static void * spsc_producer(void * param)
+{
+  circbuf_spsc_t * spsc = (circbuf_spsc_t *)param;
+
+  for (uintptr_t i = 1; i <= BENCH_ITEMS; i++)
+  {
+    while (circbuf_spsc_add_item(spsc, (void *)i) == CB_ENUM_FULL)
+    {
+      sched_yield();
+    }
+  }
+
+  return NULL;
+} // spsc_producer()
+
+/*!
+* @brief Producer for the blocking spsc circbuf, sleeps while full then
+*        echoes round trips back on the second buffer
+* @param[in] param array of the forward and return spsc circbufs
+* @return NULL
+*/
+static void * wait_producer(void * param)
+{
+  circbuf_spsc_t ** spsc = (circbuf_spsc_t **)param;
+  void * payload;
+
+  for (uintptr_t i = 1; i <= BENCH_ITEMS; i++)
+  {
+    circbuf_spsc_add_item_wait(spsc[0], (void *)i, NULL);
+  }
+  for (uint32_t i = 0; i < BENCH_ROUND_TRIPS; i++)
+  {
+    circbuf_spsc_remove_item_wait(spsc[1], &payload, NULL);
+    circbuf_spsc_add_item_wait(spsc[0], payload, NULL);
+  }
+
+  return NULL;
+} // wait_producer()
+
+/*!
+* @brief Two thread transfer through a lock-free spsc circbuf
+*/
+static void bench_spsc(void)
+{
+  pthread_t producer;
+  struct timespec diff;
+  circbuf_spsc_t * spsc;
+  void * payload;
+
+  if (circbuf_spsc_init(&spsc, BENCH_BUF_SIZE) != CB_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create spsc circbuf");
+    return;
+  }
+
+  START_TIME;
+  pthread_create(&producer, NULL, spsc_producer, spsc);
+  for (uint32_t i = 0; i < BENCH_ITEMS;)
+  {
+    if (circbuf_spsc_remove_item(spsc, &payload) == CB_ENUM_NO_ERROR)
+    {
+      i++;
+    }
+    else
+    {
+      sched_yield();
+    }
+  }
+  pthread_join(producer, NULL);
+  GET_TIME;
+
+  report("spsc circbuf", BENCH_ITEMS, &diff);
+  circbuf_spsc_destroy(spsc);
+} // bench_spsc()
+
+/*!
+* @brief Add wrapper for the mutex wrapped circbuf
+* @param[in] buf pointer to circbuf
+* @param[in] payload payload to add
+* @return circbuf status
+*/
+static cb_enum_t scale_mutex_add(void * buf, void * payload)
+{
+  cb_enum_t res;
+
+  pthread_mutex_lock(&mutex_lock);
+  res = circbuf_add_item((circbuf_t *)buf, payload);
+  pthread_mutex_unlock(&mutex_lock);
+
+  return res;
+} // scale_mutex_add()
+
+/*!
+* @brief Remove wrapper for the mutex wrapped circbuf
+* @param[in] buf pointer to circbuf
+* @param[out] payload removed payload
+* @return circbuf status
+*/
+static cb_enum_t scale_mutex_remove(void * buf, void ** payload)
+{
+  cb_enum_t res;
+
+  pthread_mutex_lock(&mutex_lock);
+  res = circbuf_remove_item((circbuf_t *)buf, payload);
+  pthread_mutex_unlock(&mutex_lock);
+
+  return res;
+} // scale_mutex_remove()
+
+/*!
+* @brief Add wrapper for the mpmc circbuf
+* @param[in] buf pointer to circbuf
+* @param[in] payload payload to add
+* @return circbuf status
+*/
+static cb_enum_t scale_mpmc_add(void * buf, void * payload)
+{
+  return circbuf_mpmc_add_item((circbuf_mpmc_t *)buf, payload);
+} // scale_mpmc_add()
+
+/*!
+* @brief Remove wrapper for the mpmc circbuf
+* @param[in] buf pointer to circbuf
+* @param[out] payload removed payload
+* @return circbuf status
+*/
+static cb_enum_t scale_mpmc_remove(void * buf, void ** payload)
+{
+  return circbuf_mpmc_remove_item((circbuf_mpmc_t *)buf, payload);
+} // scale_mpmc_remove()
+
+/*!
+* @brief Add wrapper for the sharded circbuf
+* @param[in] buf pointer to circbuf
+* @param[in] payload payload to add
+* @return circbuf status
+*/
+static cb_enum_t scale_shard_add(void * buf, void * payload)
+{
+  return circbuf_shard_add_item((circbuf_shard_t *)buf, payload);
+} // scale_shard_add()
+
+/*!
+* @brief Remove wrapper for the sharded circbuf
+* @param[in] buf pointer to circbuf
+* @param[out] payload removed payload
+* @return circbuf status
+*/
+static cb_enum_t scale_shard_remove(void * buf, void ** payload)
+{
+  return circbuf_shard_remove_item((circbuf_shard_t *)buf, payload);
+} // scale_shard_remove()
+
+/*!
+* @brief Producer for the scaling benchmark
+* @param[in] param pointer to scale_t
+* @return NULL
+*/
+static void * scale_producer(void * param)
+{
+  scale_t * scale = (scale_t *)param;
+
+  for (uintptr_t i = 1; i <= scale->items; i++)
+  {
+    while (scale->add(scale->buf, (void *)i) == CB_ENUM_FULL)
+    {
+      sched_yield();
+    }
+  }
+
+  return NULL;
+} // scale_producer()
+
+/*!
+* @brief Consumer for the scaling benchmark, runs until every produced item
+*        has been removed by some consumer
+* @param[in] param pointer to scale_t
+* @return NULL
+*/
+static void * scale_consumer(void * param)
+{
+  scale_t * scale = (scale_t *)param;
+  void * payload;
+
+  while (__atomic_load_n(&scale->consumed, __ATOMIC_RELAXED) < scale->total)
+  {
+    if (scale->remove(scale->buf, &payload) == CB_ENUM_NO_ERROR)
+    {
+      __atomic_fetch_add(&scale->consumed, 1, __ATOMIC_RELAXED);
+    }
+    else
+    {
+      sched_yield();
+    }
+  }
+
+  return NULL;
+} // scale_consumer()
+
+/*!
+* @brief Run threads producers and threads consumers through a buffer
+* @param[in] name name to report
+* @param[in] scale buffer and operations to use
+* @param[in] threads number of producers and of consumers
+*/
+static void scale_run(const char * name, scale_t * scale, uint32_t threads)
+{
+  pthread_t producers[threads];
+  pthread_t consumers[threads];
+  struct timespec diff;
+  char label[32];
+
+  scale->items = BENCH_ITEMS / threads;
+  scale->total = scale->items * threads;
+  scale->consumed = 0;
+
+  START_TIME;
+  for (uint32_t i = 0; i < threads; i++)
+  {
+    pthread_create(&producers[i], NULL, scale_producer, scale);
+    pthread_create(&consumers[i], NULL, scale_consumer, scale);
+  }
+  for (uint32_t i = 0; i < threads; i++)
+  {
+    pthread_join(producers[i], NULL);
+    pthread_join(consumers[i], NULL);
+  }
+  GET_TIME;
+
+  snprintf(label, sizeof(label), "%s %2up/%2uc", name, threads, threads);
+  report(label, scale->total, &diff);
+} // scale_run()
+
+/*!
+* @brief Scale producers and consumers from 1 to the number of cores
+*        through a mutex wrapped circbuf and the mpmc circbuf
+*/
+static void bench_mpmc(void)
+{
+  long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  circbuf_mpmc_t * mpmc;
+  scale_t scale;
+
+  if (circbuf_init(&mutex_buf, BENCH_BUF_SIZE) != CB_ENUM_NO_ERROR ||
+      circbuf_mpmc_init(&mpmc, BENCH_BUF_SIZE) != CB_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create circbufs");
+    return;
+  }
+
+  for (uint32_t threads = 1; threads <= cores; threads++)
+  {
+    scale.buf = mutex_buf;
+    scale.add = scale_mutex_add;
+    scale.remove = scale_mutex_remove;
+    scale_run("mutex", &scale, threads);
+
+    scale.buf = mpmc;
+    scale.add = scale_mpmc_add;
+    scale.remove = scale_mpmc_remove;
+    scale_run("mpmc", &scale, threads);
+  }
+
+  circbuf_destroy(mutex_buf);
+  circbuf_mpmc_destroy(mpmc);
+} // bench_mpmc()
+
+/*!
+* @brief Single thread fill and drain with one call per item compared to
+*        one call per batch
+*/
+static void bench_batch(void)
+{
+  static void * payloads[BENCH_BATCH_SIZE];
+  struct timespec diff;
+  circbuf_t * buf;
+  uint32_t rounds = BENCH_ITEMS / BENCH_BATCH_SIZE;
+  uint32_t count;
+
+  if (circbuf_init(&buf, BENCH_BATCH_SIZE) != CB_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create circbuf");
+    return;
+  }
+  for (uintptr_t i = 0; i < BENCH_BATCH_SIZE; i++)
+  {
+    payloads[i] = (void *)i;
+  }
+
+  START_TIME;
+  for (uint32_t r = 0; r < rounds; r++)
+  {
+    for (uint32_t i = 0; i < BENCH_BATCH_SIZE; i++)
+    {
+      circbuf_add_item(buf, payloads[i]);
+    }
+    for (uint32_t i = 0; i < BENCH_BATCH_SIZE; i++)
+    {
+      circbuf_remove_item(buf, &payloads[i]);
+    }
+  }
+  GET_TIME;
+  report("single items", rounds * BENCH_BATCH_SIZE, &diff);
+
+  START_TIME;
+  for (uint32_t r = 0; r < rounds; r++)
+  {
+    circbuf_add_items(buf, payloads, BENCH_BATCH_SIZE, &count);
+    circbuf_remove_items(buf, payloads, BENCH_BATCH_SIZE, &count);
+  }
+  GET_TIME;
+  report("batch items", rounds * BENCH_BATCH_SIZE, &diff);
+
+  circbuf_destroy(buf);
+} // bench_batch()
+
+/*!
+* @brief Queue variable length records as malloced payloads in a circbuf
+*        compared to writing them in place in a ringbuf
+*/
+static void bench_records(void)
+{
+  struct timespec diff;
+  circbuf_t * buf;
+  ringbuf_t * ring;
+  void * record;
+  uint32_t length;
+
+  if (circbuf_init(&buf, BENCH_BURST) != CB_ENUM_NO_ERROR ||
+      ringbuf_init(&ring, BENCH_BURST * BENCH_RECORD_LENGTH(15) * 2) != CB_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create buffers");
+    return;
+  }
+
+  START_TIME;
+  for (uint32_t r = 0; r < BENCH_ITEMS / BENCH_BURST; r++)
+  {
+    for (uint32_t i = 0; i < BENCH_BURST; i++)
+    {
+      record = malloc(BENCH_RECORD_LENGTH(i));
+      memset(record, i, BENCH_RECORD_LENGTH(i));
+      circbuf_add_item(buf, record);
+    }
+    for (uint32_t i = 0; i < BENCH_BURST; i++)
+    {
+      circbuf_remove_item(buf, &record);
+      free(record);
+    }
+  }
+  GET_TIME;
+  report("malloc records", BENCH_ITEMS / BENCH_BURST * BENCH_BURST, &diff);
+
+  START_TIME;
+  for (uint32_t r = 0; r < BENCH_ITEMS / BENCH_BURST; r++)
+  {
+    for (uint32_t i = 0; i < BENCH_BURST; i++)
+    {
+      ringbuf_reserve(ring, BENCH_RECORD_LENGTH(i), &record);
+      memset(record, i, BENCH_RECORD_LENGTH(i));
+      ringbuf_commit(ring, BENCH_RECORD_LENGTH(i));
+    }
+    for (uint32_t i = 0; i < BENCH_BURST; i++)
+    {
+      ringbuf_read(ring, &record, &length);
+      ringbuf_release(ring);
+    }
+  }
+  GET_TIME;
+  report("ringbuf records", BENCH_ITEMS / BENCH_BURST * BENCH_BURST, &diff);
+
+  circbuf_destroy(buf);
+  ringbuf_destroy(ring);
+} // bench_records()
+
+/*!
+* @brief Pass items to a forked process through shared memory buffers,
+*        measures throughput one way and latency of round trips
+*/
+static void bench_shm(void)
+{
+  struct timespec diff;
+  circbuf_shm_t * ping;
+  circbuf_shm_t * pong;
+  uint64_t item;
+  pid_t pid;
+
+  if (circbuf_shm_init(&ping, NULL, BENCH_BUF_SIZE, sizeof(item)) != CB_ENUM_NO_ERROR ||
+      circbuf_shm_init(&pong, NULL, BENCH_BUF_SIZE, sizeof(item)) != CB_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create buffers");
+    return;
+  }
+
+  // Child drains the items, acks, then echoes each round trip
+  if ((pid = fork()) == 0)
+  {
+    for (uint32_t i = 0; i < BENCH_ITEMS; i++)
+    {
+      circbuf_shm_remove_item_wait(ping, &item);
+    }
+    circbuf_shm_add_item_wait(pong, &item);
+    for (uint32_t i = 0; i < BENCH_ROUND_TRIPS; i++)
+    {
+      circbuf_shm_remove_item_wait(ping, &item);
+      circbuf_shm_add_item_wait(pong, &item);
+    }
+    _exit(0);
+  }
+  else if (pid < 0)
+  {
+    LOG_ERROR("Could not fork");
+    circbuf_shm_destroy(ping);
+    circbuf_shm_destroy(pong);
+    return;
+  }
+
+  START_TIME;
+  for (item = 0; item < BENCH_ITEMS; item++)
+  {
+    circbuf_shm_add_item_wait(ping, &item);
+  }
+  circbuf_shm_remove_item_wait(pong, &item);
+  GET_TIME;
+  report("shm", BENCH_ITEMS, &diff);
+
+  START_TIME;
+  for (item = 0; item < BENCH_ROUND_TRIPS; item++)
+  {
+    circbuf_shm_add_item_wait(ping, &item);
+    circbuf_shm_remove_item_wait(pong, &item);
+  }
+  GET_TIME;
+  report("shm round trip", BENCH_ROUND_TRIPS, &diff);
+
+  waitpid(pid, NULL, 0);
+  circbuf_shm_destroy(ping);
+  circbuf_shm_destroy(pong);
+} // bench_shm()
+
+/*!
+* @brief Queue small samples through the generic buffer, which needs
+*        storage outside the buffer and a pointer per sample, and through
+*        the typed buffer which stores them inline
+*/
+static void bench_typed(void)
+{
+  struct timespec diff;
+  circbuf_t * buf;
+  static sample_ring_t ring;
+  static sample_t storage[BENCH_BURST];
+  sample_t sample = {0, 0, 0};
+  sample_t * p_sample;
+  uint64_t sum = 0;
+
+  if (circbuf_init(&buf, BENCH_BURST) != CB_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create buffer");
+    return;
+  }
+  sample_ring_init(&ring);
+
+  START_TIME;
+  for (uint32_t r = 0; r < BENCH_ITEMS / BENCH_BURST; r++)
+  {
+    for (uint32_t i = 0; i < BENCH_BURST; i++)
+    {
+      storage[i].id = i;
+      storage[i].value = r;
+      circbuf_add_item(buf, &storage[i]);
+    }
+    for (uint32_t i = 0; i < BENCH_BURST; i++)
+    {
+      circbuf_remove_item(buf, (void **)&p_sample);
+      sum += p_sample->value;
+    }
+  }
+  GET_TIME;
+  report("circbuf samples", BENCH_ITEMS / BENCH_BURST * BENCH_BURST, &diff);
+
+  START_TIME;
+  for (uint32_t r = 0; r < BENCH_ITEMS / BENCH_BURST; r++)
+  {
+    for (uint32_t i = 0; i < BENCH_BURST; i++)
+    {
+      sample.id = i;
+      sample.value = r;
+      sample_ring_add_item(&ring, &sample);
+    }
+    for (uint32_t i = 0; i < BENCH_BURST; i++)
+    {
+      sample_ring_remove_item(&ring, &sample);
+      sum += sample.value;
+    }
+  }
+  GET_TIME;
+  report("typed samples", BENCH_ITEMS / BENCH_BURST * BENCH_BURST, &diff);
+
+  // Keep the sum so the loops are not optimized away
+  bench_sink = sum;
+  circbuf_destroy(buf);
+} // bench_typed()
+
+/*!
+* @brief Two thread transfer through spsc circbufs that sleep on a futex
+*        when full or empty, then round trips measuring wake latency
+*/
+static void bench_wait(void)
+{
+  pthread_t producer;
+  struct timespec diff;
+  circbuf_spsc_t * spsc[2];
+  void * payload;
+
+  if (circbuf_spsc_init(&spsc[0], BENCH_BUF_SIZE) != CB_ENUM_NO_ERROR ||
+      circbuf_spsc_init(&spsc[1], BENCH_BUF_SIZE) != CB_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create spsc circbufs");
+    return;
+  }
+
+  START_TIME;
+  pthread_create(&producer, NULL, wait_producer, spsc);
+  for (uint32_t i = 0; i < BENCH_ITEMS; i++)
+  {
+    circbuf_spsc_remove_item_wait(spsc[0], &payload, NULL);
+  }
+  GET_TIME;
+  report("spsc wait", BENCH_ITEMS, &diff);
+
+  START_TIME;
+  for (uintptr_t i = 0; i < BENCH_ROUND_TRIPS; i++)
+  {
+    circbuf_spsc_add_item_wait(spsc[1], (void *)i, NULL);
+    circbuf_spsc_remove_item_wait(spsc[0], &payload, NULL);
+  }
+  GET_TIME;
+  report("spsc wait trip", BENCH_ROUND_TRIPS, &diff);
+
+  pthread_join(producer, NULL);
+  circbuf_spsc_destroy(spsc[0]);
+  circbuf_spsc_destroy(spsc[1]);
+} // bench_wait()
+
+/*!
+* @brief Steady state bursts through a fixed and a growable circbuf, then
+*        a burst too large for a fixed circbuf
+*/
+static void bench_grow(void)
+{
+  struct timespec diff;
+  circbuf_t * fixed;
+  circbuf_t * grow;
+  void * payload;
+
+  if (circbuf_init(&fixed, BENCH_BUF_SIZE) != CB_ENUM_NO_ERROR ||
+      circbuf_init_growable(&grow, BENCH_BUF_SIZE, BENCH_BIG_BURST, BENCH_BUF_SIZE) != CB_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create buffers");
+    return;
+  }
+
+  START_TIME;
+  for (uint32_t r = 0; r < BENCH_ITEMS / BENCH_BURST; r++)
+  {
+    for (uintptr_t i = 0; i < BENCH_BURST; i++)
+    {
+      circbuf_add_item(fixed, (void *)i);
+    }
+    for (uint32_t i = 0; i < BENCH_BURST; i++)
+    {
+      circbuf_remove_item(fixed, &payload);
+    }
+  }
+  GET_TIME;
+  report("fixed steady", BENCH_ITEMS / BENCH_BURST * BENCH_BURST, &diff);
+
+  START_TIME;
+  for (uint32_t r = 0; r < BENCH_ITEMS / BENCH_BURST; r++)
+  {
+    for (uintptr_t i = 0; i < BENCH_BURST; i++)
+    {
+      circbuf_add_item(grow, (void *)i);
+    }
+    for (uint32_t i = 0; i < BENCH_BURST; i++)
+    {
+      circbuf_remove_item(grow, &payload);
+    }
+  }
+  GET_TIME;
+  report("growable steady", BENCH_ITEMS / BENCH_BURST * BENCH_BURST, &diff);
+
+  // Each burst grows to 1M slots and shrinks back while draining
+  START_TIME;
+  for (uint32_t r = 0; r < BENCH_ITEMS / BENCH_BIG_BURST; r++)
+  {
+    for (uintptr_t i = 0; i < BENCH_BIG_BURST; i++)
+    {
+      circbuf_add_item(grow, (void *)i);
+    }
+    for (uint32_t i = 0; i < BENCH_BIG_BURST; i++)
+    {
+      circbuf_remove_item(grow, &payload);
+    }
+  }
+  GET_TIME;
+  report("growable burst", BENCH_ITEMS / BENCH_BIG_BURST * BENCH_BIG_BURST, &diff);
+
+  circbuf_destroy(fixed);
+  circbuf_destroy(grow);
+} // bench_grow()
+
+/*!
+* @brief Scale producers and consumers from 1 to the number of cores
+*        through the mpmc circbuf and a sharded pool of the same total size
+*/
+static void bench_shard(void)
+{
+  static void * payloads[2 * BENCH_BUF_SIZE];
+  long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  struct timespec diff;
+  circbuf_mpmc_t * mpmc;
+  circbuf_shard_t * pool;
+  circbuf_shard_t * dry;
+  cb_shard_stats_t stats;
+  scale_t scale;
+  uint32_t rounds = BENCH_ITEMS / BENCH_BUF_SIZE;
+  uint32_t count;
+
+  if (circbuf_mpmc_init(&mpmc, BENCH_BUF_SIZE) != CB_ENUM_NO_ERROR ||
+      circbuf_shard_init(&pool, 0, BENCH_BUF_SIZE / cores) != CB_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create circbufs");
+    return;
+  }
+
+  for (uint32_t threads = 1; threads <= cores; threads++)
+  {
+    scale.buf = mpmc;
+    scale.add = scale_mpmc_add;
+    scale.remove = scale_mpmc_remove;
+    scale_run("mpmc", &scale, threads);
+
+    scale.buf = pool;
+    scale.add = scale_shard_add;
+    scale.remove = scale_shard_remove;
+    scale_run("shard", &scale, threads);
+  }
+
+  circbuf_shard_stats(pool, &stats);
+  LOG_HIGH("shard steals %llu, stolen %llu, failed steals %llu",
+           (unsigned long long)stats.steals,
+           (unsigned long long)stats.stolen,
+           (unsigned long long)stats.failed_steals);
+
+  circbuf_mpmc_destroy(mpmc);
+  circbuf_shard_destroy(pool);
+
+  // Single removes on a dry shard, everything left sits on the other shard
+  // so each of these removes has to be stolen
+  if (circbuf_shard_init(&dry, 2, BENCH_BUF_SIZE) != CB_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create circbuf");
+    return;
+  }
+  for (uintptr_t i = 0; i < 2 * BENCH_BUF_SIZE; i++)
+  {
+    payloads[i] = (void *)i;
+  }
+
+  START_TIME;
+  for (uint32_t r = 0; r < rounds; r++)
+  {
+    circbuf_shard_add_items(dry, payloads, 2 * BENCH_BUF_SIZE, &count);
+    circbuf_shard_remove_items(dry, payloads, BENCH_BUF_SIZE, &count);
+    for (uint32_t i = 0; i < BENCH_BUF_SIZE; i++)
+    {
+      circbuf_shard_remove_item(dry, &payloads[BENCH_BUF_SIZE + i]);
+    }
+  }
+  GET_TIME;
+  report("dry shard", (uint64_t)rounds * BENCH_BUF_SIZE, &diff);
+
+  circbuf_shard_stats(dry, &stats);
+  LOG_HIGH("dry shard steals %llu, stolen %llu",
+           (unsigned long long)stats.steals,
+           (unsigned long long)stats.stolen);
+
+  circbuf_shard_destroy(dry);
+} // bench_shard()
+
+/*!
+* @brief Query min, max and mean of the last samples after every new
+*        sample by scanning a circbuf with circbuf_peek, then by reading a
+*        sliding window
+*/
+static void bench_window(void)
+{
+  struct timespec diff;
+  circbuf_t * buf;
+  circbuf_window_t * win;
+  void * payload;
+  uintptr_t sample;
+  uintptr_t min = 0;
+  uintptr_t max = 0;
+  uint64_t sum = 0;
+  double value;
+  double total = 0;
+
+  if (circbuf_init(&buf, BENCH_BUF_SIZE) != CB_ENUM_NO_ERROR ||
+      circbuf_window_init(&win, BENCH_BUF_SIZE, 0, 1024, 64) != CB_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create buffers");
+    return;
+  }
+  circbuf_set_overwrite(buf, 1, NULL);
+
+  START_TIME;
+  for (uint32_t i = 0; i < BENCH_WINDOW_QUERIES; i++)
+  {
+    circbuf_add_item(buf, (void *)(uintptr_t)(i * 7919 % 1024));
+    circbuf_peek(buf, 0, &payload);
+    min = max = (uintptr_t)payload;
+    sum = 0;
+    for (uint32_t j = 0; j <= i && j < BENCH_BUF_SIZE; j++)
+    {
+      circbuf_peek(buf, j, &payload);
+      sample = (uintptr_t)payload;
+      min = (sample < min) ? sample : min;
+      max = (sample > max) ? sample : max;
+      sum += sample;
+    }
+    total += min + max + sum;
+  }
+  GET_TIME;
+  report("peek scan", BENCH_WINDOW_QUERIES, &diff);
+
+  START_TIME;
+  for (uint32_t i = 0; i < BENCH_WINDOW_QUERIES; i++)
+  {
+    circbuf_window_add(win, i * 7919 % 1024);
+    circbuf_window_min(win, &value);
+    total += value;
+    circbuf_window_max(win, &value);
+    total += value;
+    circbuf_window_mean(win, &value);
+    total += value;
+  }
+  GET_TIME;
+  report("window", BENCH_WINDOW_QUERIES, &diff);
+
+  START_TIME;
+  for (uint32_t i = 0; i < BENCH_WINDOW_QUERIES; i++)
+  {
+    circbuf_window_add(win, i * 7919 % 1024);
+    circbuf_window_percentile(win, 99, &value);
+    total += value;
+  }
+  GET_TIME;
+  report("window p99", BENCH_WINDOW_QUERIES, &diff);
+
+  // Keep the results so the loops are not optimized away
+  bench_sink = (uint64_t)total;
+  circbuf_destroy(buf);
+  circbuf_window_destroy(win);
+} // bench_window()
+
+// List of benchmarks, a single one can be run by passing its name
+static const bench_t benches[] = {
+  {"mutex", bench_mutex},
+  {"spsc", bench_spsc},
+  {"mpmc", bench_mpmc},
+  {"batch", bench_batch},
+  {"records", bench_records},
+  {"shm", bench_shm},
+  {"typed", bench_typed},
+  {"wait", bench_wait},
+  {"grow", bench_grow},
+  {"shard", bench_shard},
+  {"window", bench_window}
+};
+
+/*!
+* @brief Main function
+* @param[in] argc argument count
+* @param[in] argv optional name of the benchmark to run
+* @return 0
+*/
+int main(int argc, char * argv[])
+{
+  // Initialize log and timer
+  log_init();
+  timer = profiler_init();
+
+  FUNC_ENTRY;
+
+  // Run all benchmarks or the one requested
+  for (uint32_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++)
+  {
+    if (argc < 2 || strcmp(argv[1], benches[i].name) == 0)
+    {
+      benches[i].func();
+    }
+  }
+
+  // Destroy log
+  log_destroy();
+  return 0;
+}
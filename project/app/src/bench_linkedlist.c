@@ -0,0 +1,1228 @@
+/** @file bench_linkedlist.c
+*
+* @brief Throughput benchmarks for the linked lists.  Build with
+*        LOG_LEVEL=1 so FUNC_ENTRY logging is not part of the measurement.
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "linkedlist.h"
+#include "linkedlist_hash.h"
+#include "linkedlist_indexed.h"
+#include "linkedlist_skip.h"
+#include "linkedlist_intrusive.h"
+#include "linkedlist_rcu.h"
+#include "linkedlist_unrolled.h"
+#include "log.h"
+#include "profiler.h"
+#include "project_defs.h"
+
+// Number of nodes inserted and removed in each benchmark
+#define BENCH_ITEMS (10000000)
+
+// Nodes that stay in the list while the churn runs
+#define BENCH_LIST_SIZE (1024)
+
+// Nodes inserted before they are removed again by the churn benchmark
+#define BENCH_BURST (64)
+
+// Nodes in each slab of a pooled list
+#define BENCH_SLAB_NODES (256)
+
+// Length of the list built by appending
+#define BENCH_APPENDS (1000000)
+
+// Length of the list filtered by the filter benchmark
+#define BENCH_FILTER_SIZE (50000)
+
+// Objects put on a list and searched by the intrusive benchmark
+#define BENCH_OBJECTS (65536)
+
+// Searches for a random object by the intrusive benchmark
+#define BENCH_SEARCHES (1000)
+
+// Lookups by key made by the hash benchmark
+#define BENCH_LOOKUPS (100000)
+
+// Timestamps kept in order by the skip benchmark
+#define BENCH_STAMPS (20000)
+
+// Entries in the config list read by the concurrent benchmark
+#define BENCH_CONFIG_SIZE (64)
+
+// Searches shared out between the reader threads
+#define BENCH_READS (2000000)
+
+// Microseconds between config updates made by the writer thread
+#define BENCH_UPDATE_USEC (1000)
+
+// Records in the list sorted by the sort benchmark
+#define BENCH_SORT_SIZE (300000)
+
+// Items moved in and out of a list in one go
+#define BENCH_BULK_SIZE (1000000)
+
+// Inserts at random indices, each followed by a remove at another.  Lists
+// that walk to the index get fewer as they grow, BENCH_POSITIONS at 1000
+// items.
+#define BENCH_POSITIONS (20000)
+
+// Items visited by each walk benchmark, spread over as many walks as the
+// list length allows
+#define BENCH_VISITS (50000000)
+
+// Number of full walks over the list after the churn
+#define BENCH_WALKS (1000)
+
+// Object for the intrusive benchmark, the plain list points at the same
+// structure through its node data
+typedef struct object
+{
+  uint64_t key;
+  ll_link_t link;
+} object_t;
+
+// Benchmark entry
+typedef struct bench
+{
+  const char * name;
+  void (*func)(void);
+} bench_t;
+
+// Shared state for the concurrent benchmark, the plain list is guarded by
+// config_lock and the rcu list by nothing on the read side
+typedef struct readers
+{
+  node_t * head;
+  ll_rcu_t * rcu;
+  uint32_t reads;
+  uint32_t done;
+} readers_t;
+
+// Lock wrapping the plain list the way callers do today
+static pthread_mutex_t config_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Results written here so benchmark loops are not optimized away
+uint64_t bench_sink;
+
+uint32_t abort_signal;
+uint8_t timer;
+
+/*!
+* @brief Log the operations per second for a benchmark
+* @param[in] name name of the benchmark
+* @param[in] ops number of operations performed
+* @param[in] diff time taken to perform the operations
+*/
+static void report(const char * name, uint64_t ops, struct timespec * diff)
+{
+  double sec = (double)diff->tv_sec + (double)diff->tv_nsec / 1000000000;
+
+  LOG_HIGH("%-22s %10llu ops in %8.4f sec, %12.0f ops/sec",
+           name,
+           (unsigned long long)ops,
+           sec,
+           (double)ops / sec);
+} // report()
+
+/*!
+* @brief Compare function that visits every node without matching
+* @param[in] data1 not used
+* @param[in] data2 data of the node visited
+* @return 0
+*/
+static uint8_t never_match(void * data1, void * data2)
+{
+  bench_sink += (uintptr_t)data2;
+  return 0;
+} // never_match()
+
+/*!
+* @brief Compare function matching an object key
+* @param[in] data1 pointer to the key searched for
+* @param[in] data2 object visited
+* @return 1 is a match 0 is not a match
+*/
+static uint8_t key_match(void * data1, void * data2)
+{
+  return *(uint64_t *)data1 == ((object_t *)data2)->key;
+} // key_match()
+
+/*!
+* @brief Empty a list without freeing the data, the benchmarks store
+*        integers in the data pointers
+* @param[in] head list to empty
+*/
+static void drain_nodes(node_t * head)
+{
+  void * data;
+
+  while (ll_remove(head, &data, 0) == LL_ENUM_NO_ERROR)
+  {
+    bench_sink += (uintptr_t)data;
+  }
+} // drain_nodes()
+
+/*!
+* @brief Empty a list without freeing the data then destroy it
+* @param[in] head list to empty and destroy
+*/
+static void drain(node_t * head)
+{
+  drain_nodes(head);
+  ll_destroy(head);
+} // drain()
+
+/*!
+* @brief Insert and remove bursts at the front of a list then walk it
+* @param[in] name name to report
+* @param[in] head list to churn
+*/
+static void churn(const char * name, node_t * head)
+{
+  struct timespec diff;
+  char walk_name[32];
+  int32_t index;
+  void * data;
+
+  // Resident nodes that the walk has to visit
+  for (uintptr_t i = 1; i <= BENCH_LIST_SIZE; i++)
+  {
+    ll_insert(head, (void *)i, 0);
+  }
+
+  START_TIME;
+  for (uint32_t r = 0; r < BENCH_ITEMS / BENCH_BURST; r++)
+  {
+    for (uintptr_t i = 1; i <= BENCH_BURST; i++)
+    {
+      ll_insert(head, (void *)i, 0);
+    }
+    for (uint32_t i = 0; i < BENCH_BURST; i++)
+    {
+      ll_remove(head, &data, 0);
+      bench_sink += (uintptr_t)data;
+    }
+  }
+  GET_TIME;
+  report(name, BENCH_ITEMS / BENCH_BURST * BENCH_BURST * 2, &diff);
+
+  // Walk speed shows where the nodes ended up in memory
+  START_TIME;
+  for (uint32_t i = 0; i < BENCH_WALKS; i++)
+  {
+    ll_search(head, (void *)&index, never_match, &index);
+  }
+  GET_TIME;
+  snprintf(walk_name, sizeof(walk_name), "%s walk", name);
+  report(walk_name, (uint64_t)BENCH_WALKS * BENCH_LIST_SIZE, &diff);
+
+  drain(head);
+} // churn()
+
+/*!
+* @brief Node churn with malloc/free per node against a slab pool
+*/
+static void bench_churn(void)
+{
+  node_t * heap;
+  node_t * pool;
+
+  if (ll_init(&heap) != LL_ENUM_NO_ERROR ||
+      ll_init_pool(&pool, BENCH_SLAB_NODES) != LL_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create lists");
+    return;
+  }
+
+  churn("malloc churn", heap);
+  churn("pool churn", pool);
+} // bench_churn()
+
+/*!
+* @brief Build a long list by appending then empty it from the end
+*/
+static void bench_ends(void)
+{
+  struct timespec diff;
+  node_t * head;
+  void * data;
+
+  if (ll_init_pool(&head, BENCH_SLAB_NODES) != LL_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create list");
+    return;
+  }
+
+  START_TIME;
+  for (uintptr_t i = 1; i <= BENCH_APPENDS; i++)
+  {
+    ll_insert(head, (void *)i, INSERT_AT_END);
+  }
+  GET_TIME;
+  report("append", BENCH_APPENDS, &diff);
+
+  START_TIME;
+  for (uint32_t i = 0; i < BENCH_APPENDS; i++)
+  {
+    ll_remove(head, &data, REMOVE_AT_END);
+    bench_sink += (uintptr_t)data;
+  }
+  GET_TIME;
+  report("pop end", BENCH_APPENDS, &diff);
+
+  ll_destroy(head);
+} // bench_ends()
+
+/*!
+* @brief Fill a list with BENCH_FILTER_SIZE integers
+* @param[in] head list to fill
+*/
+static void fill(node_t * head)
+{
+  for (uintptr_t i = 1; i <= BENCH_FILTER_SIZE; i++)
+  {
+    ll_insert(head, (void *)i, INSERT_AT_END);
+  }
+} // fill()
+
+/*!
+* @brief Remove every other node by index against one pass with a cursor
+*/
+static void bench_filter(void)
+{
+  struct timespec diff;
+  ll_cursor_t cursor;
+  node_t * head;
+  void * data;
+
+  if (ll_init_pool(&head, BENCH_SLAB_NODES) != LL_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create list");
+    return;
+  }
+
+  // Each remove walks from the closer end to its index
+  fill(head);
+  START_TIME;
+  for (int32_t i = 1; ll_remove(head, &data, i) == LL_ENUM_NO_ERROR; i++)
+  {
+    bench_sink += (uintptr_t)data;
+  }
+  GET_TIME;
+  report("index filter", BENCH_FILTER_SIZE, &diff);
+  drain_nodes(head);
+
+  // One walk, removes happen under the cursor
+  fill(head);
+  START_TIME;
+  ll_cursor_first(head, &cursor);
+  while (ll_cursor_get(&cursor, &data) == LL_ENUM_NO_ERROR)
+  {
+    if ((uintptr_t)data % 2 == 0)
+    {
+      ll_cursor_remove(&cursor, &data);
+      bench_sink += (uintptr_t)data;
+    }
+    else
+    {
+      ll_cursor_next(&cursor);
+    }
+  }
+  GET_TIME;
+  report("cursor filter", BENCH_FILTER_SIZE, &diff);
+
+  drain(head);
+} // bench_filter()
+
+/*!
+* @brief Put the same objects on a plain list and an intrusive list then
+*        search both
+*/
+static void bench_intrusive(void)
+{
+  struct timespec diff;
+  ll_intrusive_t list;
+  object_t ** objects;
+  node_t * head;
+  void * data;
+  int32_t index;
+  uint64_t key;
+
+  if ((objects = malloc(BENCH_OBJECTS * sizeof(*objects))) == NULL)
+  {
+    LOG_ERROR("Could not create objects");
+    return;
+  }
+  for (uint32_t i = 0; i < BENCH_OBJECTS; i++)
+  {
+    objects[i] = malloc(sizeof(*objects[i]));
+    objects[i]->key = i;
+  }
+
+  // Each object on the plain list costs another allocation for its node
+  START_TIME;
+  ll_init_pool(&head, BENCH_SLAB_NODES);
+  for (uint32_t i = 0; i < BENCH_OBJECTS; i++)
+  {
+    ll_insert(head, objects[i], INSERT_AT_END);
+  }
+  GET_TIME;
+  report("plain build", BENCH_OBJECTS, &diff);
+
+  // The link is inside the object so nothing is allocated
+  START_TIME;
+  ll_intrusive_init(&list, offsetof(object_t, link));
+  for (uint32_t i = 0; i < BENCH_OBJECTS; i++)
+  {
+    ll_intrusive_insert(&list, objects[i], INSERT_AT_END);
+  }
+  GET_TIME;
+  report("intrusive build", BENCH_OBJECTS, &diff);
+
+  // Every node visited is one more pointer to follow to reach the key
+  START_TIME;
+  for (uint32_t i = 0; i < BENCH_SEARCHES; i++)
+  {
+    key = (i * 7919) % BENCH_OBJECTS;
+    ll_search(head, &key, key_match, &index);
+    bench_sink += index;
+  }
+  GET_TIME;
+  report("plain search", BENCH_SEARCHES, &diff);
+
+  START_TIME;
+  for (uint32_t i = 0; i < BENCH_SEARCHES; i++)
+  {
+    key = (i * 7919) % BENCH_OBJECTS;
+    ll_intrusive_search(&list, &key, key_match, &data);
+    bench_sink += ((object_t *)data)->key;
+  }
+  GET_TIME;
+  report("intrusive search", BENCH_SEARCHES, &diff);
+
+  // The plain list frees the objects
+  ll_destroy(head);
+  free(objects);
+} // bench_intrusive()
+
+/*!
+* @brief Hash an object or a key by its key, the key is the first member of
+*        the object so both are read the same way
+* @param[in] data object or key
+* @return hash of the key
+*/
+static uint32_t key_hash(void * data)
+{
+  uint64_t key = *(uint64_t *)data;
+
+  // Fibonacci hashing spreads sequential keys over the buckets
+  return (uint32_t)((key * 0x9E3779B97F4A7C15ULL) >> 32);
+} // key_hash()
+
+/*!
+* @brief Look up objects by key with a search against the hash index
+*/
+static void bench_hash(void)
+{
+  struct timespec diff;
+  ll_hash_t * list;
+  node_t * head;
+  void * data;
+  int32_t index;
+  uint64_t key;
+
+  if (ll_init_pool(&head, BENCH_SLAB_NODES) != LL_ENUM_NO_ERROR ||
+      ll_hash_init(&list, key_hash, key_match) != LL_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create lists");
+    return;
+  }
+
+  // Each list owns its own copy of the objects
+  for (uint32_t i = 0; i < BENCH_OBJECTS; i++)
+  {
+    data = malloc(sizeof(object_t));
+    ((object_t *)data)->key = i;
+    ll_insert(head, data, INSERT_AT_END);
+  }
+  START_TIME;
+  for (uint32_t i = 0; i < BENCH_OBJECTS; i++)
+  {
+    data = malloc(sizeof(object_t));
+    ((object_t *)data)->key = i;
+    ll_hash_insert(list, data, INSERT_AT_END);
+  }
+  GET_TIME;
+  report("hash build", BENCH_OBJECTS, &diff);
+
+  // A search visits half the list on average
+  START_TIME;
+  for (uint32_t i = 0; i < BENCH_SEARCHES; i++)
+  {
+    key = (i * 7919) % BENCH_OBJECTS;
+    ll_search(head, &key, key_match, &index);
+    bench_sink += index;
+  }
+  GET_TIME;
+  report("search by key", BENCH_SEARCHES, &diff);
+
+  START_TIME;
+  for (uint32_t i = 0; i < BENCH_LOOKUPS; i++)
+  {
+    key = (i * 7919) % BENCH_OBJECTS;
+    ll_hash_lookup(list, &key, &data);
+    bench_sink += ((object_t *)data)->key;
+  }
+  GET_TIME;
+  report("hash lookup", BENCH_LOOKUPS, &diff);
+
+  // Remove by key then put back so the list stays the same size
+  START_TIME;
+  for (uint32_t i = 0; i < BENCH_LOOKUPS; i++)
+  {
+    key = (i * 7919) % BENCH_OBJECTS;
+    ll_hash_remove_key(list, &key, &data);
+    ll_hash_insert(list, data, INSERT_AT_END);
+  }
+  GET_TIME;
+  report("hash remove/insert", BENCH_LOOKUPS, &diff);
+
+  ll_destroy(head);
+  ll_hash_destroy(list);
+} // bench_hash()
+
+/*!
+* @brief Compare function matching the first timestamp later than data1,
+*        the timestamps are stored in the data pointers
+* @param[in] data1 timestamp being placed
+* @param[in] data2 timestamp visited
+* @return 1 if data2 is later
+*/
+static uint8_t stamp_later(void * data1, void * data2)
+{
+  return (uintptr_t)data2 > (uintptr_t)data1;
+} // stamp_later()
+
+/*!
+* @brief Compare function ordering timestamps for the skip list
+* @param[in] data1 first timestamp
+* @param[in] data2 second timestamp
+* @return 1 if data1 is earlier
+*/
+static uint8_t stamp_less(void * data1, void * data2)
+{
+  return (uintptr_t)data1 < (uintptr_t)data2;
+} // stamp_less()
+
+/*!
+* @brief Keep random timestamps in order with search and insert on a plain
+*        list against a skip list
+*/
+static void bench_skip(void)
+{
+  struct timespec diff;
+  uintptr_t * stamps;
+  ll_skip_t * skip;
+  node_t * head;
+  void * data;
+  int32_t index;
+
+  if ((stamps = malloc(BENCH_STAMPS * sizeof(*stamps))) == NULL ||
+      ll_init_pool(&head, BENCH_SLAB_NODES) != LL_ENUM_NO_ERROR ||
+      ll_skip_init(&skip, stamp_less) != LL_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create lists");
+    return;
+  }
+  for (uint32_t i = 0; i < BENCH_STAMPS; i++)
+  {
+    stamps[i] = 1 + random() % (BENCH_STAMPS * 4);
+  }
+
+  // One walk to find the position and another to insert there
+  START_TIME;
+  for (uint32_t i = 0; i < BENCH_STAMPS; i++)
+  {
+    if (ll_search(head, (void *)stamps[i], stamp_later, &index) != LL_ENUM_NO_ERROR)
+    {
+      index = INSERT_AT_END;
+    }
+    ll_insert(head, (void *)stamps[i], index);
+  }
+  GET_TIME;
+  report("sorted list insert", BENCH_STAMPS, &diff);
+
+  START_TIME;
+  for (uint32_t i = 0; i < BENCH_STAMPS; i++)
+  {
+    ll_skip_insert(skip, (void *)stamps[i]);
+  }
+  GET_TIME;
+  report("skip insert", BENCH_STAMPS, &diff);
+
+  START_TIME;
+  for (uint32_t i = 0; i < BENCH_STAMPS; i++)
+  {
+    ll_skip_lookup(skip, (void *)stamps[i], &data);
+    bench_sink += (uintptr_t)data;
+  }
+  GET_TIME;
+  report("skip lookup", BENCH_STAMPS, &diff);
+
+  // The data are integers so empty the lists before destroying them
+  START_TIME;
+  for (uint32_t i = 0; i < BENCH_STAMPS; i++)
+  {
+    ll_skip_remove(skip, (void *)stamps[i], &data);
+    bench_sink += (uintptr_t)data;
+  }
+  GET_TIME;
+  report("skip remove", BENCH_STAMPS, &diff);
+
+  drain(head);
+  ll_skip_destroy(skip);
+  free(stamps);
+} // bench_skip()
+
+/*!
+* @brief Allocate an object for a config list
+* @param[in] key key of the object
+* @return the object
+*/
+static object_t * object_new(uint64_t key)
+{
+  object_t * object = malloc(sizeof(*object));
+
+  object->key = key;
+  return object;
+} // object_new()
+
+/*!
+* @brief Reader searching the mutex wrapped plain list
+* @param[in] param pointer to readers_t
+* @return NULL
+*/
+static void * mutex_reader(void * param)
+{
+  readers_t * readers = (readers_t *)param;
+  uint64_t sum = 0;
+  int32_t index;
+  uint64_t key;
+
+  for (uint32_t i = 0; i < readers->reads; i++)
+  {
+    key = i % BENCH_CONFIG_SIZE;
+    pthread_mutex_lock(&config_lock);
+    ll_search(readers->head, &key, key_match, &index);
+    pthread_mutex_unlock(&config_lock);
+    sum += index;
+  }
+  __atomic_fetch_add(&bench_sink, sum, __ATOMIC_RELAXED);
+
+  return NULL;
+} // mutex_reader()
+
+/*!
+* @brief Reader searching the rcu list in read sections
+* @param[in] param pointer to readers_t
+* @return NULL
+*/
+static void * rcu_reader(void * param)
+{
+  readers_t * readers = (readers_t *)param;
+  uint64_t sum = 0;
+  uint32_t reader;
+  void * data;
+  uint64_t key;
+
+  if (ll_rcu_register(readers->rcu, &reader) != LL_ENUM_NO_ERROR)
+  {
+    return NULL;
+  }
+  for (uint32_t i = 0; i < readers->reads; i++)
+  {
+    key = i % BENCH_CONFIG_SIZE;
+    ll_rcu_read_lock(readers->rcu, reader);
+    if (ll_rcu_search(readers->rcu, &key, key_match, &data) == LL_ENUM_NO_ERROR)
+    {
+      sum += ((object_t *)data)->key;
+    }
+    ll_rcu_read_unlock(readers->rcu, reader);
+  }
+  ll_rcu_unregister(readers->rcu, reader);
+  __atomic_fetch_add(&bench_sink, sum, __ATOMIC_RELAXED);
+
+  return NULL;
+} // rcu_reader()
+
+/*!
+* @brief Writer replacing one config entry every BENCH_UPDATE_USEC on both
+*        lists until the readers are done
+* @param[in] param pointer to readers_t
+* @return NULL
+*/
+static void * config_writer(void * param)
+{
+  readers_t * readers = (readers_t *)param;
+  void * data;
+  uint64_t key;
+
+  for (uint32_t i = 0; !__atomic_load_n(&readers->done, __ATOMIC_RELAXED); i++)
+  {
+    key = i % BENCH_CONFIG_SIZE;
+
+    // Move the entry to the end of the plain list
+    pthread_mutex_lock(&config_lock);
+    ll_remove(readers->head, &data, 0);
+    ll_insert(readers->head, data, INSERT_AT_END);
+    pthread_mutex_unlock(&config_lock);
+
+    // Replace the entry with a new copy on the rcu list
+    ll_rcu_remove(readers->rcu, &key, key_match);
+    ll_rcu_insert(readers->rcu, object_new(key), INSERT_AT_END);
+
+    usleep(BENCH_UPDATE_USEC);
+  }
+
+  return NULL;
+} // config_writer()
+
+/*!
+* @brief Run reader threads against a list while the writer updates it
+* @param[in] name name to report
+* @param[in] readers lists to use
+* @param[in] func reader thread function
+* @param[in] threads number of reader threads
+*/
+static void readers_run(const char * name,
+                        readers_t * readers,
+                        void * (*func)(void *),
+                        uint32_t threads)
+{
+  pthread_t reader_threads[threads];
+  pthread_t writer;
+  struct timespec diff;
+  char label[32];
+
+  readers->reads = BENCH_READS / threads;
+  readers->done = 0;
+  pthread_create(&writer, NULL, config_writer, readers);
+
+  START_TIME;
+  for (uint32_t i = 0; i < threads; i++)
+  {
+    pthread_create(&reader_threads[i], NULL, func, readers);
+  }
+  for (uint32_t i = 0; i < threads; i++)
+  {
+    pthread_join(reader_threads[i], NULL);
+  }
+  GET_TIME;
+
+  __atomic_store_n(&readers->done, 1, __ATOMIC_RELAXED);
+  pthread_join(writer, NULL);
+
+  snprintf(label, sizeof(label), "%s %2u readers", name, threads);
+  report(label, (uint64_t)readers->reads * threads, &diff);
+} // readers_run()
+
+/*!
+* @brief Read mostly config list with 1 to the number of cores reader
+*        threads, a mutex wrapped plain list against the rcu list
+*/
+static void bench_concurrent(void)
+{
+  long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  readers_t readers;
+
+  if (ll_init(&readers.head) != LL_ENUM_NO_ERROR ||
+      ll_rcu_init(&readers.rcu) != LL_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create lists");
+    return;
+  }
+  for (uint64_t key = 0; key < BENCH_CONFIG_SIZE; key++)
+  {
+    ll_insert(readers.head, object_new(key), INSERT_AT_END);
+    ll_rcu_insert(readers.rcu, object_new(key), INSERT_AT_END);
+  }
+
+  for (uint32_t threads = 1; threads <= cores; threads++)
+  {
+    readers_run("mutex", &readers, mutex_reader, threads);
+    readers_run("rcu", &readers, rcu_reader, threads);
+  }
+
+  ll_destroy(readers.head);
+  ll_rcu_destroy(readers.rcu);
+} // bench_concurrent()
+
+/*!
+* @brief qsort comparison for integers stored in data pointers
+* @param[in] a pointer to the first data pointer
+* @param[in] b pointer to the second data pointer
+* @return negative, zero or positive as a sorts before, with or after b
+*/
+static int stamp_cmp(const void * a, const void * b)
+{
+  uintptr_t x = *(const uintptr_t *)a;
+  uintptr_t y = *(const uintptr_t *)b;
+
+  return (x > y) - (x < y);
+} // stamp_cmp()
+
+/*!
+* @brief Fill a list with BENCH_SORT_SIZE random integers
+* @param[in] head list to fill
+*/
+static void fill_random(node_t * head)
+{
+  srandom(1);
+  for (uint32_t i = 0; i < BENCH_SORT_SIZE; i++)
+  {
+    ll_insert(head, (void *)(uintptr_t)(1 + random()), INSERT_AT_END);
+  }
+} // fill_random()
+
+/*!
+* @brief Sort a list by copying the data out, sorting and reinserting
+*        against relinking it in place
+*/
+static void bench_sort(void)
+{
+  struct timespec diff;
+  uintptr_t * copy;
+  node_t * head;
+  node_t * other;
+  uint32_t count;
+
+  if ((copy = malloc(BENCH_SORT_SIZE * sizeof(*copy))) == NULL ||
+      ll_init_pool(&head, BENCH_SLAB_NODES) != LL_ENUM_NO_ERROR ||
+      ll_init_pool(&other, BENCH_SLAB_NODES) != LL_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create lists");
+    return;
+  }
+
+  // Drain to an array, qsort it and append it back
+  fill_random(head);
+  START_TIME;
+  count = 0;
+  while (ll_remove(head, (void **)&copy[count], 0) == LL_ENUM_NO_ERROR)
+  {
+    count++;
+  }
+  qsort(copy, count, sizeof(*copy), stamp_cmp);
+  for (uint32_t i = 0; i < count; i++)
+  {
+    ll_insert(head, (void *)copy[i], INSERT_AT_END);
+  }
+  GET_TIME;
+  report("copy sort", BENCH_SORT_SIZE, &diff);
+  drain_nodes(head);
+
+  // Relink in place
+  fill_random(head);
+  START_TIME;
+  ll_sort(head, stamp_less);
+  GET_TIME;
+  report("ll_sort", BENCH_SORT_SIZE, &diff);
+
+  // Merge a second sorted list into the first
+  fill_random(other);
+  ll_sort(other, stamp_less);
+  START_TIME;
+  ll_merge(head, other, stamp_less);
+  GET_TIME;
+  report("ll_merge", BENCH_SORT_SIZE * 2, &diff);
+
+  drain(head);
+  drain(other);
+  free(copy);
+} // bench_sort()
+
+/*!
+* @brief Print function that only keeps the data alive
+* @param[in] data data of the item
+* @param[in] index not used
+*/
+static void sink_print(void * data, uint32_t index)
+{
+  bench_sink += (uintptr_t)data;
+} // sink_print()
+
+/*!
+* @brief Free a batch of node sized allocations in random order so later
+*        nodes come back scattered, like a heap that has been running a
+*        while
+* @param[in] count number of allocations to scatter
+*/
+static void age_heap(uint32_t count)
+{
+  void ** blocks;
+  void * swap;
+  uint32_t j;
+
+  if ((blocks = malloc(count * sizeof(*blocks))) == NULL)
+  {
+    return;
+  }
+  for (uint32_t i = 0; i < count; i++)
+  {
+    blocks[i] = malloc(3 * sizeof(void *));
+  }
+  for (uint32_t i = count - 1; i > 0; i--)
+  {
+    j = random() % (i + 1);
+    swap = blocks[i];
+    blocks[i] = blocks[j];
+    blocks[j] = swap;
+  }
+  for (uint32_t i = 0; i < count; i++)
+  {
+    free(blocks[i]);
+  }
+  free(blocks);
+} // age_heap()
+
+/*!
+* @brief Search and dump a node list and an unrolled list of one size
+* @param[in] size number of items in the lists
+*/
+static void unrolled_size(uint32_t size)
+{
+  struct timespec diff;
+  ll_unrolled_t * unrolled;
+  node_t * fresh;
+  node_t * aged;
+  char name[32];
+  void * data;
+  int32_t index;
+  uint32_t walks = BENCH_VISITS / size;
+
+  // Nodes of the fresh list sit in allocation order, the aged list's do not
+  ll_init(&fresh);
+  ll_unrolled_init(&unrolled);
+  for (uintptr_t i = 1; i <= size; i++)
+  {
+    ll_insert(fresh, (void *)i, INSERT_AT_END);
+    ll_unrolled_insert(unrolled, (void *)i, INSERT_AT_END);
+  }
+  age_heap(size);
+  ll_init(&aged);
+  for (uintptr_t i = 1; i <= size; i++)
+  {
+    ll_insert(aged, (void *)i, INSERT_AT_END);
+  }
+
+  // Every search misses so it walks the whole list
+  START_TIME;
+  for (uint32_t i = 0; i < walks; i++)
+  {
+    ll_search(fresh, (void *)&index, never_match, &index);
+  }
+  GET_TIME;
+  snprintf(name, sizeof(name), "node %u search", size);
+  report(name, (uint64_t)walks * size, &diff);
+
+  START_TIME;
+  for (uint32_t i = 0; i < walks; i++)
+  {
+    ll_search(aged, (void *)&index, never_match, &index);
+  }
+  GET_TIME;
+  snprintf(name, sizeof(name), "aged %u search", size);
+  report(name, (uint64_t)walks * size, &diff);
+
+  START_TIME;
+  for (uint32_t i = 0; i < walks; i++)
+  {
+    ll_unrolled_search(unrolled, (void *)&index, never_match, &index);
+  }
+  GET_TIME;
+  snprintf(name, sizeof(name), "unrolled %u search", size);
+  report(name, (uint64_t)walks * size, &diff);
+
+  START_TIME;
+  for (uint32_t i = 0; i < walks; i++)
+  {
+    ll_dump(aged, sink_print);
+  }
+  GET_TIME;
+  snprintf(name, sizeof(name), "aged %u dump", size);
+  report(name, (uint64_t)walks * size, &diff);
+
+  START_TIME;
+  for (uint32_t i = 0; i < walks; i++)
+  {
+    ll_unrolled_dump(unrolled, sink_print);
+  }
+  GET_TIME;
+  snprintf(name, sizeof(name), "unrolled %u dump", size);
+  report(name, (uint64_t)walks * size, &diff);
+
+  // The data are integers so empty the lists before destroying them
+  drain(fresh);
+  drain(aged);
+  while (ll_unrolled_remove(unrolled, &data, REMOVE_AT_END) == LL_ENUM_NO_ERROR)
+  {
+    bench_sink += (uintptr_t)data;
+  }
+  ll_unrolled_destroy(unrolled);
+} // unrolled_size()
+
+/*!
+* @brief Walk node lists and unrolled lists of growing size
+*/
+static void bench_unrolled(void)
+{
+  for (uint32_t size = 1000; size <= 100000; size *= 10)
+  {
+    unrolled_size(size);
+  }
+} // bench_unrolled()
+
+/*!
+* @brief Build and drain a list one item at a time against with whole
+*        arrays, then join two lists item by item against splicing
+* @param[in] name name to report
+* @param[in] slab_nodes nodes per slab, 0 for a heap list
+*/
+static void bulk_lists(const char * name, uint32_t slab_nodes)
+{
+  struct timespec diff;
+  char label[64];
+  void ** array;
+  void * data;
+  node_t * head;
+  node_t * other;
+  int32_t count;
+
+  if ((array = malloc(BENCH_BULK_SIZE * sizeof(*array))) == NULL ||
+      (slab_nodes ? ll_init_pool(&head, slab_nodes) : ll_init(&head)) != LL_ENUM_NO_ERROR ||
+      (slab_nodes ? ll_init_pool(&other, slab_nodes) : ll_init(&other)) != LL_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not create lists");
+    return;
+  }
+  for (uint32_t i = 0; i < BENCH_BULK_SIZE; i++)
+  {
+    array[i] = (void *)(uintptr_t)(i + 1);
+  }
+
+  // One call per item
+  START_TIME;
+  for (uint32_t i = 0; i < BENCH_BULK_SIZE; i++)
+  {
+    ll_insert(head, array[i], INSERT_AT_END);
+  }
+  for (uint32_t i = 0; i < BENCH_BULK_SIZE; i++)
+  {
+    ll_remove(head, &array[i], 0);
+  }
+  GET_TIME;
+  snprintf(label, sizeof(label), "%s insert/remove", name);
+  report(label, BENCH_BULK_SIZE, &diff);
+
+  // One call each way
+  START_TIME;
+  ll_from_array(head, array, BENCH_BULK_SIZE, INSERT_AT_END);
+  ll_to_array(head, array, BENCH_BULK_SIZE, &count);
+  GET_TIME;
+  snprintf(label, sizeof(label), "%s from/to array", name);
+  report(label, BENCH_BULK_SIZE, &diff);
+
+  // Join other onto head an item at a time
+  ll_from_array(other, array, BENCH_BULK_SIZE, INSERT_AT_END);
+  START_TIME;
+  while (ll_remove(other, &data, 0) == LL_ENUM_NO_ERROR)
+  {
+    ll_insert(head, data, INSERT_AT_END);
+  }
+  GET_TIME;
+  snprintf(label, sizeof(label), "%s move items", name);
+  report(label, BENCH_BULK_SIZE, &diff);
+
+  // And back again in one splice
+  START_TIME;
+  ll_splice(other, INSERT_AT_END, head, 0, BENCH_BULK_SIZE);
+  GET_TIME;
+  snprintf(label, sizeof(label), "%s splice", name);
+  report(label, BENCH_BULK_SIZE, &diff);
+
+  drain(head);
+  drain(other);
+  free(array);
+} // bulk_lists()
+
+/*!
+* @brief Bulk operations on heap lists, where splice moves nodes as they
+*        are, and on pooled lists where it copies
+*/
+static void bench_bulk(void)
+{
+  bulk_lists("heap", 0);
+  bulk_lists("pool", BENCH_SLAB_NODES);
+} // bench_bulk()
+
+/*!
+* @brief Insert and remove at random indices in a node list, an unrolled
+*        list and an indexed sequence of one size
+* @param[in] size number of items kept in the lists
+*/
+static void indexed_size(uint32_t size)
+{
+  struct timespec diff;
+  ll_unrolled_t * unrolled;
+  ll_indexed_t * indexed;
+  node_t * head;
+  char name[32];
+  void * data;
+  int32_t * inserts;
+  int32_t * removes;
+  uint32_t walked = (uint64_t)BENCH_POSITIONS * 1000 / size;
+
+  if ((inserts = malloc(BENCH_POSITIONS * sizeof(*inserts))) == NULL ||
+      (removes = malloc(BENCH_POSITIONS * sizeof(*removes))) == NULL)
+  {
+    LOG_ERROR("Could not allocate indices");
+    free(inserts);
+    return;
+  }
+
+  // Same indices for every list, the size stays put between pairs
+  srandom(1);
+  for (uint32_t i = 0; i < BENCH_POSITIONS; i++)
+  {
+    inserts[i] = random() % (size + 1);
+    removes[i] = random() % (size + 1);
+  }
+  ll_init(&head);
+  ll_unrolled_init(&unrolled);
+  ll_indexed_init(&indexed);
+  for (uintptr_t i = 1; i <= size; i++)
+  {
+    ll_insert(head, (void *)i, INSERT_AT_END);
+    ll_unrolled_insert(unrolled, (void *)i, INSERT_AT_END);
+    ll_indexed_insert(indexed, (void *)i, INSERT_AT_END);
+  }
+
+  START_TIME;
+  for (uint32_t i = 0; i < walked; i++)
+  {
+    ll_insert(head, (void *)(uintptr_t)i, inserts[i]);
+    ll_remove(head, &data, removes[i]);
+  }
+  GET_TIME;
+  snprintf(name, sizeof(name), "node %u positional", size);
+  report(name, walked * 2, &diff);
+
+  START_TIME;
+  for (uint32_t i = 0; i < walked; i++)
+  {
+    ll_unrolled_insert(unrolled, (void *)(uintptr_t)i, inserts[i]);
+    ll_unrolled_remove(unrolled, &data, removes[i]);
+  }
+  GET_TIME;
+  snprintf(name, sizeof(name), "unrolled %u positional", size);
+  report(name, walked * 2, &diff);
+
+  START_TIME;
+  for (uint32_t i = 0; i < BENCH_POSITIONS; i++)
+  {
+    ll_indexed_insert(indexed, (void *)(uintptr_t)i, inserts[i]);
+    ll_indexed_remove(indexed, &data, removes[i]);
+  }
+  GET_TIME;
+  snprintf(name, sizeof(name), "indexed %u positional", size);
+  report(name, BENCH_POSITIONS * 2, &diff);
+
+  START_TIME;
+  for (uint32_t i = 0; i < BENCH_POSITIONS; i++)
+  {
+    ll_indexed_get(indexed, &data, removes[i] % size);
+    bench_sink += (uintptr_t)data;
+  }
+  GET_TIME;
+  snprintf(name, sizeof(name), "indexed %u get", size);
+  report(name, BENCH_POSITIONS, &diff);
+
+  // The data are integers so empty the lists before destroying them
+  drain(head);
+  while (ll_unrolled_remove(unrolled, &data, REMOVE_AT_END) == LL_ENUM_NO_ERROR)
+  {
+    bench_sink += (uintptr_t)data;
+  }
+  ll_unrolled_destroy(unrolled);
+  while (ll_indexed_remove(indexed, &data, REMOVE_AT_END) == LL_ENUM_NO_ERROR)
+  {
+    bench_sink += (uintptr_t)data;
+  }
+  ll_indexed_destroy(indexed);
+  free(inserts);
+  free(removes);
+} // indexed_size()
+
+/*!
+* @brief Positional inserts and removes on lists of growing size
+*/
+static void bench_indexed(void)
+{
+  for (uint32_t size = 1000; size <= 100000; size *= 10)
+  {
+    indexed_size(size);
+  }
+} // bench_indexed()
+
+// Benchmarks that can be selected on the command line
+static const bench_t benches[] = {
+  {"churn", bench_churn},
+  {"ends", bench_ends},
+  {"filter", bench_filter},
+  {"intrusive", bench_intrusive},
+  {"hash", bench_hash},
+  {"skip", bench_skip},
+  {"concurrent", bench_concurrent},
+  {"sort", bench_sort},
+  {"unrolled", bench_unrolled},
+  {"bulk", bench_bulk},
+  {"indexed", bench_indexed}
+};
+
+/*!
+* @brief Main function
+* @param[in] argc argument count
+* @param[in] argv argument values, optional name of the benchmark to run
+* @return 0
+*/
+int main(int argc, char * argv[])
+{
+  // Initialize log and timer
+  log_init();
+  timer = profiler_init();
+
+  FUNC_ENTRY;
+
+  // Run all benchmarks or the one requested
+  for (uint32_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++)
+  {
+    if (argc < 2 || strcmp(argv[1], benches[i].name) == 0)
+    {
+      benches[i].func();
+    }
+  }
+
+  // Destroy log
+  log_destroy();
+  return 0;
+}
@@ -9,9 +9,21 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef __linux__
+#include <unistd.h>
+#endif // __linux__
 #include "circbuf.h"
 #include "log.h"
 
+// Statistics are compiled out unless built with CB_STATS
+#ifdef CB_STATS
+#define CB_STAT_ADD(buf, field, n) ((buf)->stats.field += (n))
+#define CB_STAT_SAMPLE(buf) circbuf_stats_sample(buf)
+#else
+#define CB_STAT_ADD(buf, field, n)
+#define CB_STAT_SAMPLE(buf)
+#endif // CB_STATS
+
 // Circular buffer structure
 struct circbuf
 {
@@ -20,8 +32,221 @@ struct circbuf
   void ** tail;
   uint32_t count;
   uint32_t length;
+  uint8_t overwrite;
+  DROPFUNC drop;
+  uint64_t dropped;
+  int32_t notify_fd;
+  uint8_t notify_events;
+  uint32_t min_length;
+  uint32_t max_length;
+  uint32_t shrink_after;
+  uint32_t quiet;
+#ifdef CB_STATS
+  cb_stats_t stats;
+#endif // CB_STATS
 };
 
+/*
+ * \brief circbuf_set_span: sets head, tail and count from the index of the
+ *                          first item and the number of items
+ *
+ * \param buf: pointer to the circular buffer structure
+ * \param first: index of the item at tail
+ * \param count: number of items in the buffer
+ *
+ */
+static inline void circbuf_set_span(circbuf_t * buf, uint32_t first, uint32_t count)
+{
+  buf->count = count;
+
+  // An empty buffer starts over at the beginning
+  if (count == 0)
+  {
+    buf->head = buf->buffer;
+    buf->tail = buf->buffer;
+    return;
+  }
+
+  // Tail points at the first item and head points at the last item
+  buf->tail = buf->buffer + first;
+  buf->head = buf->buffer + (first + count - 1) % buf->length;
+} // circbuf_set_span()
+
+#ifdef CB_STATS
+/*
+ * \brief circbuf_stats_sample: records the current occupancy in the high
+ *                             water mark and the histogram
+ *
+ * \param buf: pointer to the circular buffer structure
+ *
+ */
+static inline void circbuf_stats_sample(circbuf_t * buf)
+{
+  if (buf->count > buf->stats.high_water)
+  {
+    buf->stats.high_water = buf->count;
+  }
+  buf->stats.histogram[(uint64_t)buf->count * CB_STATS_BUCKETS / ((uint64_t)buf->length + 1)]++;
+} // circbuf_stats_sample()
+#endif // CB_STATS
+
+/*
+ * \brief circbuf_notify: signals the notify descriptor if the event was
+ *                       asked for
+ *
+ * \param buf: pointer to the circular buffer structure
+ * \param event: CB_NOTIFY_NOT_EMPTY or CB_NOTIFY_NOT_FULL
+ *
+ */
+static inline void circbuf_notify(circbuf_t * buf, uint8_t event)
+{
+#ifdef __linux__
+  uint64_t one = 1;
+
+  // Errors are ignored, an eventfd only fails when its counter is about to
+  // overflow and then it is already readable
+  if (buf->notify_fd >= 0 && (buf->notify_events & event))
+  {
+    if (write(buf->notify_fd, &one, sizeof(one)) < 0)
+    {
+      LOG_LOW("Could not signal notify descriptor");
+    }
+  }
+#endif // __linux__
+} // circbuf_notify()
+
+/*
+ * \brief circbuf_drop_oldest: drops items from tail to make room when in
+ *                            overwrite mode
+ *
+ * \param buf: pointer to the circular buffer structure
+ * \param count: number of items to drop, no more than the buffer holds
+ *
+ */
+static void circbuf_drop_oldest(circbuf_t * buf, uint32_t count)
+{
+  uint32_t first = buf->tail - buf->buffer;
+
+  // Let the owner release each dropped item
+  if (buf->drop != NULL)
+  {
+    for (uint32_t i = 0; i < count; i++)
+    {
+      buf->drop(buf->buffer[(first + i) % buf->length]);
+    }
+  }
+
+  // Move tail past the dropped items
+  buf->dropped += count;
+  circbuf_set_span(buf, (first + count) % buf->length, buf->count - count);
+} // circbuf_drop_oldest()
+
+/*
+ * \brief circbuf_resize: moves the items into a new buffer of a different
+ *                       length, the items start at the beginning of the new
+ *                       buffer so any wrap is undone
+ *
+ * \param buf: pointer to the circular buffer structure
+ * \param length: new length, no smaller than the number of items
+ * \return: success or error
+ *
+ */
+static cb_enum_t circbuf_resize(circbuf_t * buf, uint32_t length)
+{
+  void ** buffer;
+  uint32_t first;
+  uint32_t chunk;
+
+  // Allocate the new buffer
+  if ((buffer = malloc(sizeof(void *) * length)) == NULL)
+  {
+    return CB_ENUM_ALLOC_FAILURE;
+  }
+
+  // Copy from tail up to the end of the old buffer then the wrapped part
+  first = buf->tail - buf->buffer;
+  chunk = buf->length - first;
+  if (chunk > buf->count)
+  {
+    chunk = buf->count;
+  }
+  memcpy(buffer, buf->buffer + first, chunk * sizeof(void *));
+  memcpy(buffer + chunk, buf->buffer, (buf->count - chunk) * sizeof(void *));
+
+  // Swap buffers and start the items at the beginning
+  free(buf->buffer);
+  buf->buffer = buffer;
+  buf->length = length;
+  circbuf_set_span(buf, 0, buf->count);
+
+  return CB_ENUM_NO_ERROR;
+} // circbuf_resize()
+
+/*
+ * \brief circbuf_grow: doubles the length of a growable buffer until there
+ *                     is room for count more items or max length is reached
+ *
+ * \param buf: pointer to the circular buffer structure
+ * \param count: number of items that need room
+ *
+ */
+static void circbuf_grow(circbuf_t * buf, uint32_t count)
+{
+  uint64_t needed = (uint64_t)buf->count + count;
+  uint64_t length = buf->length;
+
+  // Grow geometrically so adds stay O(1) amortized
+  while (length < needed && length < buf->max_length)
+  {
+    length *= 2;
+  }
+  if (length > buf->max_length)
+  {
+    length = buf->max_length;
+  }
+
+  // A failed allocation leaves the buffer as it was, the add then sees it
+  // full
+  if (length > buf->length && circbuf_resize(buf, (uint32_t)length) != CB_ENUM_NO_ERROR)
+  {
+    LOG_ERROR("Could not grow circbuf to %llu items", (unsigned long long)length);
+  }
+} // circbuf_grow()
+
+/*
+ * \brief circbuf_check_shrink: halves the length of a growable buffer once
+ *                             it has been at most a quarter full for
+ *                             shrink_after removes in a row
+ *
+ * \param buf: pointer to the circular buffer structure
+ *
+ */
+static void circbuf_check_shrink(circbuf_t * buf)
+{
+  uint32_t length;
+
+  // Any remove with the buffer more than a quarter full restarts the count
+  if (buf->count > buf->length / 4)
+  {
+    buf->quiet = 0;
+    return;
+  }
+  if (++buf->quiet < buf->shrink_after)
+  {
+    return;
+  }
+
+  // Halving leaves the buffer at most half full so it does not grow again
+  // right away.  A failed allocation just keeps the larger buffer.
+  buf->quiet = 0;
+  length = buf->length / 2;
+  if (length < buf->min_length)
+  {
+    length = buf->min_length;
+  }
+  circbuf_resize(buf, length);
+} // circbuf_check_shrink()
+
 cb_enum_t circbuf_init(circbuf_t ** buf, uint16_t length)
 {
   FUNC_ENTRY;
@@ -48,10 +273,22 @@ cb_enum_t circbuf_init(circbuf_t ** buf, uint16_t length)
   }
 
   // Set the remaining elements of the circular buffer
-  (*buf)->head     = (*buf)->buffer;
-  (*buf)->tail     = (*buf)->buffer;
-  (*buf)->length   = length;
-  (*buf)->count    = 0;
+  (*buf)->head      = (*buf)->buffer;
+  (*buf)->tail      = (*buf)->buffer;
+  (*buf)->length    = length;
+  (*buf)->count     = 0;
+  (*buf)->overwrite = 0;
+  (*buf)->drop      = NULL;
+  (*buf)->dropped   = 0;
+  (*buf)->notify_fd = -1;
+  (*buf)->notify_events = 0;
+  (*buf)->min_length = length;
+  (*buf)->max_length = length;
+  (*buf)->shrink_after = 0;
+  (*buf)->quiet     = 0;
+#ifdef CB_STATS
+  memset(&(*buf)->stats, 0, sizeof(cb_stats_t));
+#endif // CB_STATS
 
   // Make buffer all zeros
   memset((*buf)->buffer, 0, length);
@@ -60,6 +297,49 @@ cb_enum_t circbuf_init(circbuf_t ** buf, uint16_t length)
   return CB_ENUM_NO_ERROR;
 } // circbuf_init()
 
+cb_enum_t circbuf_init_growable(circbuf_t ** buf,
+                                uint32_t length,
+                                uint32_t max_length,
+                                uint32_t shrink_after)
+{
+  FUNC_ENTRY;
+
+  // Check for null pointers
+  CB_CHECK_NULL(buf);
+
+  // Make sure sizes are valid
+  if (length <= 0 || max_length < length)
+  {
+    return CB_ENUM_NO_LENGTH;
+  }
+
+  // Allocate the new circular buffer
+  if ((*buf = malloc(sizeof(circbuf_t))) == NULL)
+  {
+    return CB_ENUM_ALLOC_FAILURE;
+  }
+  memset(*buf, 0, sizeof(circbuf_t));
+
+  // Allocate the internal buffer at the starting length
+  if (((*buf)->buffer = calloc(length, sizeof(void *))) == NULL)
+  {
+    free(*buf);
+    return CB_ENUM_ALLOC_FAILURE;
+  }
+
+  // Set the remaining elements of the circular buffer
+  (*buf)->head         = (*buf)->buffer;
+  (*buf)->tail         = (*buf)->buffer;
+  (*buf)->length       = length;
+  (*buf)->notify_fd    = -1;
+  (*buf)->min_length   = length;
+  (*buf)->max_length   = max_length;
+  (*buf)->shrink_after = shrink_after;
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_init_growable()
+
 cb_enum_t circbuf_add_item(circbuf_t * buf, void * payload)
 {
   FUNC_ENTRY;
@@ -68,10 +348,23 @@ cb_enum_t circbuf_add_item(circbuf_t * buf, void * payload)
   CB_CHECK_NULL(buf);
   CB_CHECK_NULL(buf->buffer);
 
-  // Make sure there is room in the buffer
+  // Make sure there is room in the buffer, a growable buffer makes room by
+  // growing and overwrite mode makes room by dropping the oldest item
   if (buf->count == buf->length)
   {
-    return CB_ENUM_FULL;
+    if (buf->length < buf->max_length)
+    {
+      circbuf_grow(buf, 1);
+    }
+    if (buf->count == buf->length)
+    {
+      if (!buf->overwrite)
+      {
+        CB_STAT_ADD(buf, full, 1);
+        return CB_ENUM_FULL;
+      }
+      circbuf_drop_oldest(buf, 1);
+    }
   }
 
   // Wrap buffer if needed
@@ -88,8 +381,13 @@ cb_enum_t circbuf_add_item(circbuf_t * buf, void * payload)
   // Set head to payload
   *(buf->head) = payload;
 
-  // Increment count
-  buf->count++;
+  // Increment count and signal the first item
+  if (buf->count++ == 0)
+  {
+    circbuf_notify(buf, CB_NOTIFY_NOT_EMPTY);
+  }
+  CB_STAT_ADD(buf, adds, 1);
+  CB_STAT_SAMPLE(buf);
 
   // Return success
   return CB_ENUM_NO_ERROR;
@@ -107,14 +405,19 @@ cb_enum_t circbuf_remove_item(circbuf_t * buf, void ** payload)
   // Make sure there is an item to read
   if (buf->count == 0)
   {
+    CB_STAT_ADD(buf, empty, 1);
     return CB_ENUM_EMPTY;
   }
 
   // Put tail in payload
   *payload = *buf->tail;
 
-  // Decrement count
-  buf->count--;
+  // Decrement count and signal the first free slot, a growable buffer is
+  // only full at its max length
+  if (buf->count-- == buf->length && buf->length == buf->max_length)
+  {
+    circbuf_notify(buf, CB_NOTIFY_NOT_FULL);
+  }
 
   // Wrap buffer if needed
   if ((buf->tail) - (buf->buffer) == buf->length - 1)
@@ -127,11 +430,206 @@ cb_enum_t circbuf_remove_item(circbuf_t * buf, void ** payload)
     // No wrap is necessary increment head
     buf->tail++;
   }
+  CB_STAT_ADD(buf, removes, 1);
+  CB_STAT_SAMPLE(buf);
+
+  // Give memory back once a grown buffer has been quiet for a while
+  if (buf->shrink_after != 0 && buf->length > buf->min_length)
+  {
+    circbuf_check_shrink(buf);
+  }
 
   // Return success
   return CB_ENUM_NO_ERROR;
 } // circbuf_remove_item()
 
+cb_enum_t circbuf_add_items(circbuf_t * buf,
+                            void ** payloads,
+                            uint32_t count,
+                            uint32_t * added)
+{
+  FUNC_ENTRY;
+
+  uint32_t first;
+  uint32_t pos;
+  uint32_t chunk;
+  uint32_t previous;
+
+  // Check for null pointer
+  CB_CHECK_NULL(buf);
+  CB_CHECK_NULL(buf->buffer);
+  CB_CHECK_NULL(payloads);
+  CB_CHECK_NULL(added);
+
+  *added = 0;
+
+  // A growable buffer grows to fit as many items as it can
+  if (count > buf->length - buf->count && buf->length < buf->max_length)
+  {
+    circbuf_grow(buf, count);
+  }
+
+  // In overwrite mode only the newest length payloads can be kept, the
+  // rest are dropped along with as many old items as needed to fit them
+  if (buf->overwrite)
+  {
+    if (count > buf->length)
+    {
+      for (uint32_t i = 0; buf->drop != NULL && i < count - buf->length; i++)
+      {
+        buf->drop(payloads[i]);
+      }
+      buf->dropped += count - buf->length;
+      payloads += count - buf->length;
+      count = buf->length;
+    }
+    if (count > buf->length - buf->count)
+    {
+      circbuf_drop_oldest(buf, count - (buf->length - buf->count));
+    }
+  }
+
+  // Make sure there is room in the buffer
+  if (buf->count == buf->length)
+  {
+    CB_STAT_ADD(buf, full, 1);
+    return CB_ENUM_FULL;
+  }
+
+  // Only add as many items as there is room for
+  if (count > buf->length - buf->count)
+  {
+    count = buf->length - buf->count;
+  }
+
+  // Find the first free slot after the last item
+  first = (buf->count == 0) ? 0 : buf->tail - buf->buffer;
+  pos = (first + buf->count) % buf->length;
+
+  // Copy up to the end of the buffer then wrap to the beginning
+  chunk = buf->length - pos;
+  if (chunk > count)
+  {
+    chunk = count;
+  }
+  memcpy(buf->buffer + pos, payloads, chunk * sizeof(void *));
+  memcpy(buf->buffer, payloads + chunk, (count - chunk) * sizeof(void *));
+
+  // Move head, update count and signal the first items, an empty batch
+  // adds nothing to signal
+  previous = buf->count;
+  circbuf_set_span(buf, first, buf->count + count);
+  *added = count;
+  if (previous == 0 && count != 0)
+  {
+    circbuf_notify(buf, CB_NOTIFY_NOT_EMPTY);
+  }
+  CB_STAT_ADD(buf, adds, count);
+  CB_STAT_SAMPLE(buf);
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_add_items()
+
+cb_enum_t circbuf_remove_items(circbuf_t * buf,
+                               void ** payloads,
+                               uint32_t count,
+                               uint32_t * removed)
+{
+  FUNC_ENTRY;
+
+  uint32_t first;
+  uint32_t chunk;
+  uint32_t previous;
+
+  // Check for null pointer
+  CB_CHECK_NULL(buf);
+  CB_CHECK_NULL(buf->buffer);
+  CB_CHECK_NULL(payloads);
+  CB_CHECK_NULL(removed);
+
+  // Make sure there is an item to read
+  *removed = 0;
+  if (buf->count == 0)
+  {
+    CB_STAT_ADD(buf, empty, 1);
+    return CB_ENUM_EMPTY;
+  }
+
+  // Only remove as many items as there are
+  if (count > buf->count)
+  {
+    count = buf->count;
+  }
+
+  // Copy from tail up to the end of the buffer then wrap to the beginning
+  first = buf->tail - buf->buffer;
+  chunk = buf->length - first;
+  if (chunk > count)
+  {
+    chunk = count;
+  }
+  memcpy(payloads, buf->buffer + first, chunk * sizeof(void *));
+  memcpy(payloads + chunk, buf->buffer, (count - chunk) * sizeof(void *));
+
+  // Move tail, update count and signal the first free slots.  An empty
+  // batch frees nothing and a growable buffer is only full at its max
+  // length.
+  previous = buf->count;
+  circbuf_set_span(buf, (first + count) % buf->length, buf->count - count);
+  *removed = count;
+  if (previous == buf->length && count != 0 && buf->length == buf->max_length)
+  {
+    circbuf_notify(buf, CB_NOTIFY_NOT_FULL);
+  }
+  CB_STAT_ADD(buf, removes, count);
+  CB_STAT_SAMPLE(buf);
+
+  // Give memory back once a grown buffer has been quiet for a while
+  if (buf->shrink_after != 0 && buf->length > buf->min_length)
+  {
+    circbuf_check_shrink(buf);
+  }
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_remove_items()
+
+cb_enum_t circbuf_peek_spans(circbuf_t * buf, cb_span_t * first, cb_span_t * second)
+{
+  uint32_t start;
+
+  // Check for null pointer
+  CB_CHECK_NULL(buf);
+  CB_CHECK_NULL(buf->buffer);
+  CB_CHECK_NULL(first);
+  CB_CHECK_NULL(second);
+
+  // Start with two empty spans
+  first->items = buf->tail;
+  first->count = 0;
+  second->items = buf->buffer;
+  second->count = 0;
+
+  // Make sure there is an item to read
+  if (buf->count == 0)
+  {
+    return CB_ENUM_EMPTY;
+  }
+
+  // First span runs from tail to the last item or the end of the buffer,
+  // whatever is left over wraps to the beginning
+  start = buf->tail - buf->buffer;
+  first->count = buf->length - start;
+  if (first->count > buf->count)
+  {
+    first->count = buf->count;
+  }
+  second->count = buf->count - first->count;
+
+  return CB_ENUM_NO_ERROR;
+} // circbuf_peek_spans()
+
 cb_enum_t circbuf_peek(circbuf_t * buf, uint32_t index, void ** payload)
 {
   FUNC_ENTRY;
@@ -207,18 +705,23 @@ cb_enum_t circbuf_destroy(circbuf_t * buf)
 
 cb_enum_t circbuf_dump(circbuf_t * buf, PRINTFUNC func)
 {
-  void * current;
+  cb_span_t spans[2];
+  uint32_t index = 0;
 
   // Check for null pointers
   CB_CHECK_NULL(buf);
   CB_CHECK_NULL(buf->buffer);
 
-  // Loop over length printing data at index if it exists
-  for (uint32_t i = 0; i < buf->count; i++)
+  // Walk the contiguous spans printing each item instead of peeking at
+  // every index
+  if (circbuf_peek_spans(buf, &spans[0], &spans[1]) == CB_ENUM_NO_ERROR)
   {
-    if (circbuf_peek(buf, i, &current) == CB_ENUM_NO_ERROR)
+    for (uint32_t i = 0; i < 2; i++)
     {
-      func(current, i);
+      for (uint32_t j = 0; j < spans[i].count; j++)
+      {
+        func(spans[i].items[j], index++);
+      }
     }
   }
 
@@ -226,13 +729,64 @@ cb_enum_t circbuf_dump(circbuf_t * buf, PRINTFUNC func)
   return CB_ENUM_NO_ERROR;
 }
 
+cb_enum_t circbuf_set_overwrite(circbuf_t * buf, uint8_t enable, DROPFUNC func)
+{
+  FUNC_ENTRY;
+
+  // Check null pointer
+  CB_CHECK_NULL(buf);
+
+  // Set the mode and the function for dropped items
+  buf->overwrite = enable;
+  buf->drop = func;
+
+  return CB_ENUM_NO_ERROR;
+} // circbuf_set_overwrite()
+
+cb_enum_t circbuf_dropped(circbuf_t * buf, uint64_t * dropped)
+{
+  // Check null pointers
+  CB_CHECK_NULL(buf);
+  CB_CHECK_NULL(dropped);
+
+  *dropped = buf->dropped;
+
+  return CB_ENUM_NO_ERROR;
+} // circbuf_dropped()
+
+cb_enum_t circbuf_set_notify(circbuf_t * buf, int32_t fd, uint8_t events)
+{
+  FUNC_ENTRY;
+
+  // Check null pointer
+  CB_CHECK_NULL(buf);
+
+  // Set the descriptor and the transitions to signal
+  buf->notify_fd = fd;
+  buf->notify_events = (fd >= 0) ? events : 0;
+
+  return CB_ENUM_NO_ERROR;
+} // circbuf_set_notify()
+
+cb_enum_t circbuf_length(circbuf_t * buf, uint32_t * length)
+{
+  // Check null pointers
+  CB_CHECK_NULL(buf);
+  CB_CHECK_NULL(length);
+
+  *length = buf->length;
+
+  return CB_ENUM_NO_ERROR;
+} // circbuf_length()
+
 cb_enum_t circbuf_full(circbuf_t * buf)
 {
   // Check null pointer
   CB_CHECK_NULL(buf);
 
-  // Buffer is full return success
-  if (buf->length == buf->count)
+  // Buffer is full return success, a growable buffer is only full at its
+  // max length
+  if (buf->length == buf->count && buf->length == buf->max_length)
   {
     return CB_ENUM_FULL;
   }
@@ -256,6 +810,64 @@ cb_enum_t circbuf_empty(circbuf_t * buf)
   return CB_ENUM_FAILURE;
 } // circbuf_empty()
 
+cb_enum_t circbuf_stats(circbuf_t * buf, cb_stats_t * stats)
+{
+  // Check null pointers
+  CB_CHECK_NULL(buf);
+  CB_CHECK_NULL(stats);
+
+#ifdef CB_STATS
+  *stats = buf->stats;
+  return CB_ENUM_NO_ERROR;
+#else
+  memset(stats, 0, sizeof(cb_stats_t));
+  return CB_ENUM_FAILURE;
+#endif // CB_STATS
+} // circbuf_stats()
+
+cb_enum_t circbuf_stats_reset(circbuf_t * buf)
+{
+  // Check null pointer
+  CB_CHECK_NULL(buf);
+
+#ifdef CB_STATS
+  memset(&buf->stats, 0, sizeof(cb_stats_t));
+  buf->stats.high_water = buf->count;
+  return CB_ENUM_NO_ERROR;
+#else
+  return CB_ENUM_FAILURE;
+#endif // CB_STATS
+} // circbuf_stats_reset()
+
+cb_enum_t circbuf_stats_dump(circbuf_t * buf, PRINTFUNC func)
+{
+  cb_stats_t stats;
+
+  // Check null pointers
+  CB_CHECK_NULL(buf);
+  CB_CHECK_NULL(func);
+
+  // Take a snapshot so the counters are consistent while printing
+  if (circbuf_stats(buf, &stats) != CB_ENUM_NO_ERROR)
+  {
+    return CB_ENUM_FAILURE;
+  }
+
+  LOG_HIGH("adds %llu, removes %llu, full %llu, empty %llu, high water %u of %u",
+           (unsigned long long)stats.adds,
+           (unsigned long long)stats.removes,
+           (unsigned long long)stats.full,
+           (unsigned long long)stats.empty,
+           stats.high_water,
+           buf->length);
+  for (uint32_t i = 0; i < CB_STATS_BUCKETS; i++)
+  {
+    func(&stats.histogram[i], i);
+  }
+
+  return CB_ENUM_NO_ERROR;
+} // circbuf_stats_dump()
+
 #ifdef UNITTEST
 // This is a test function used to set buffer to null
 cb_enum_t circbuf_null_buffer(circbuf_t * buf)
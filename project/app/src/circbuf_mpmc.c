@@ -0,0 +1,239 @@
+/** @file circbuf_mpmc.c
+*
+* @brief Implementation of lock-free bounded multi producer/multi consumer
+*        circular buffer.  Every slot carries a sequence number which tells
+*        producers and consumers whose turn it is to use the slot, so the
+*        only shared writes are a compare and swap on head or tail.
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "circbuf_mpmc.h"
+#include "log.h"
+
+// Atomic helpers for the shared positions and slot sequences
+#define LOAD_RELAXED(x) __atomic_load_n(&(x), __ATOMIC_RELAXED)
+#define LOAD_ACQUIRE(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(x, val) __atomic_store_n(&(x), val, __ATOMIC_RELEASE)
+#define CAS_RELAXED(x, expected, val) \
+  __atomic_compare_exchange_n(&(x), expected, val, 1, \
+                              __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+
+// Slot in the buffer.  A slot is free for position pos when its sequence
+// is pos and holds data for position pos when its sequence is pos + 1.
+typedef struct mpmc_slot
+{
+  uint32_t sequence;
+  void * payload;
+} mpmc_slot_t;
+
+// Circular buffer structure, head and tail are on their own cache lines
+// so producers and consumers do not contend with each other
+struct circbuf_mpmc
+{
+  uint32_t head;
+  uint8_t head_pad[CB_CACHE_LINE_SIZE - sizeof(uint32_t)];
+
+  uint32_t tail;
+  uint8_t tail_pad[CB_CACHE_LINE_SIZE - sizeof(uint32_t)];
+
+  // Read only after initialization
+  mpmc_slot_t * slots;
+  uint32_t mask;
+};
+
+cb_enum_t circbuf_mpmc_init(circbuf_mpmc_t ** buf, uint16_t length)
+{
+  FUNC_ENTRY;
+
+  uint32_t size = 2;
+
+  // Check for null pointers
+  CB_CHECK_NULL(buf);
+
+  // Make sure size is valid
+  if (length <= 0)
+  {
+    return CB_ENUM_NO_LENGTH;
+  }
+
+  // Round the length up to a power of two so positions can be masked.
+  // Start at two, with one slot a producer a lap ahead sees the sequence
+  // of a free slot and overwrites an item nobody has removed.
+  while (size < length)
+  {
+    size <<= 1;
+  }
+
+  // Allocate the new circular buffer on a cache line boundary, malloc only
+  // promises 16 bytes so the padded head and tail could still share a line
+  if (posix_memalign((void **)buf, CB_CACHE_LINE_SIZE, sizeof(circbuf_mpmc_t)) != 0)
+  {
+    *buf = NULL;
+    return CB_ENUM_ALLOC_FAILURE;
+  }
+  memset(*buf, 0, sizeof(circbuf_mpmc_t));
+
+  // Allocate the slots the same way so no slot straddles two lines
+  if (posix_memalign((void **)&(*buf)->slots, CB_CACHE_LINE_SIZE, sizeof(mpmc_slot_t) * size) != 0)
+  {
+    free(*buf);
+    *buf = NULL;
+    return CB_ENUM_ALLOC_FAILURE;
+  }
+
+  // Every slot starts free for its own position
+  for (uint32_t i = 0; i < size; i++)
+  {
+    (*buf)->slots[i].sequence = i;
+    (*buf)->slots[i].payload = NULL;
+  }
+  (*buf)->mask = size - 1;
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_mpmc_init()
+
+cb_enum_t circbuf_mpmc_destroy(circbuf_mpmc_t * buf)
+{
+  FUNC_ENTRY;
+
+  // Check for null pointers
+  CB_CHECK_NULL(buf);
+  CB_CHECK_NULL(buf->slots);
+
+  // Free the slots and structure
+  free(buf->slots);
+  free(buf);
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_mpmc_destroy()
+
+cb_enum_t circbuf_mpmc_add_item(circbuf_mpmc_t * buf, void * payload)
+{
+  mpmc_slot_t * slot;
+  uint32_t pos;
+  int32_t diff;
+
+  // Check for null pointer
+  CB_CHECK_NULL(buf);
+
+  // Claim a position at head
+  pos = LOAD_RELAXED(buf->head);
+  for (;;)
+  {
+    slot = &buf->slots[pos & buf->mask];
+    diff = (int32_t)(LOAD_ACQUIRE(slot->sequence) - pos);
+
+    // Slot is free, try to take it.  On failure pos is reloaded.
+    if (diff == 0)
+    {
+      if (CAS_RELAXED(buf->head, &pos, pos + 1))
+      {
+        break;
+      }
+    }
+    // Slot still holds data from the last lap so the buffer is full
+    else if (diff < 0)
+    {
+      return CB_ENUM_FULL;
+    }
+    // Another producer took the slot, catch up to head
+    else
+    {
+      pos = LOAD_RELAXED(buf->head);
+    }
+  }
+
+  // Write the payload then publish it to consumers
+  slot->payload = payload;
+  STORE_RELEASE(slot->sequence, pos + 1);
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_mpmc_add_item()
+
+cb_enum_t circbuf_mpmc_remove_item(circbuf_mpmc_t * buf, void ** payload)
+{
+  mpmc_slot_t * slot;
+  uint32_t pos;
+  int32_t diff;
+
+  // Check for null pointer
+  CB_CHECK_NULL(buf);
+  CB_CHECK_NULL(payload);
+
+  // Claim a position at tail
+  pos = LOAD_RELAXED(buf->tail);
+  for (;;)
+  {
+    slot = &buf->slots[pos & buf->mask];
+    diff = (int32_t)(LOAD_ACQUIRE(slot->sequence) - (pos + 1));
+
+    // Slot holds data, try to take it.  On failure pos is reloaded.
+    if (diff == 0)
+    {
+      if (CAS_RELAXED(buf->tail, &pos, pos + 1))
+      {
+        break;
+      }
+    }
+    // Slot has not been written yet so the buffer is empty
+    else if (diff < 0)
+    {
+      return CB_ENUM_EMPTY;
+    }
+    // Another consumer took the slot, catch up to tail
+    else
+    {
+      pos = LOAD_RELAXED(buf->tail);
+    }
+  }
+
+  // Read the payload then free the slot for the next lap
+  *payload = slot->payload;
+  STORE_RELEASE(slot->sequence, pos + buf->mask + 1);
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_mpmc_remove_item()
+
+cb_enum_t circbuf_mpmc_full(circbuf_mpmc_t * buf)
+{
+  uint32_t tail;
+
+  // Check null pointer
+  CB_CHECK_NULL(buf);
+
+  // Read tail first so head can never appear to be behind it
+  tail = LOAD_ACQUIRE(buf->tail);
+
+  // Buffer is full when head is a whole lap ahead of tail
+  if (LOAD_ACQUIRE(buf->head) - tail > buf->mask)
+  {
+    return CB_ENUM_FULL;
+  }
+
+  // Buffer is not full return failure
+  return CB_ENUM_FAILURE;
+} // circbuf_mpmc_full()
+
+cb_enum_t circbuf_mpmc_empty(circbuf_mpmc_t * buf)
+{
+  // Check null pointer
+  CB_CHECK_NULL(buf);
+
+  // Buffer is empty when head and tail meet
+  if (LOAD_ACQUIRE(buf->head) == LOAD_ACQUIRE(buf->tail))
+  {
+    return CB_ENUM_EMPTY;
+  }
+
+  // Buffer is not empty return failure
+  return CB_ENUM_FAILURE;
+} // circbuf_mpmc_empty()
@@ -0,0 +1,462 @@
+/** @file circbuf_shard.c
+*
+* @brief Implementation of a sharded pool of circular buffers.  Each shard
+*        is a lock-free mpmc circbuf on its own cache lines, so producers on
+*        different CPUs never touch the same head and a consumer only goes
+*        to another shard when its own is empty, taking a batch at a time.
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#define _GNU_SOURCE
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "circbuf_mpmc.h"
+#include "circbuf_shard.h"
+#include "log.h"
+
+// Statistics are only ever added to and read, never used for ordering.
+// The spill fields are also read without the lock to skip empty spills.
+#define ADD_RELAXED(x, val) __atomic_fetch_add(&(x), val, __ATOMIC_RELAXED)
+#define SUB_RELAXED(x, val) __atomic_fetch_sub(&(x), val, __ATOMIC_RELAXED)
+#define LOAD_RELAXED(x) __atomic_load_n(&(x), __ATOMIC_RELAXED)
+#define STORE_RELAXED(x, val) __atomic_store_n(&(x), val, __ATOMIC_RELAXED)
+
+// Bytes of a shard in use and the padding that rounds it to whole lines
+#define SHARD_USED (sizeof(circbuf_mpmc_t *) + 3 * sizeof(uint64_t) + \
+                    CB_SHARD_STEAL_BATCH * sizeof(void *) + 5 * sizeof(uint32_t))
+#define SHARD_PAD ((CB_CACHE_LINE_SIZE - SHARD_USED % CB_CACHE_LINE_SIZE) % CB_CACHE_LINE_SIZE)
+
+// One shard and the statistics of the consumers that call it home, padded
+// so neighboring shards do not share a cache line.  The spill holds items
+// a steal took beyond what its remove needed, spill[spill_first] up to
+// spill[spill_count] are waiting and all came from shard spill_from.  It is
+// only touched by the consumer holding spill_lock.  spilled counts the
+// items of this shard waiting in any spill, they are older than its ring.
+typedef struct shard
+{
+  circbuf_mpmc_t * buf;
+  uint64_t steals;
+  uint64_t stolen;
+  uint64_t failed_steals;
+  void * spill[CB_SHARD_STEAL_BATCH];
+  uint32_t spill_lock;
+  uint32_t spill_first;
+  uint32_t spill_count;
+  uint32_t spill_from;
+  uint32_t spilled;
+  uint8_t pad[SHARD_PAD];
+} shard_t;
+
+// Sharded pool structure
+struct circbuf_shard
+{
+  shard_t * shards;
+  uint32_t count;
+#ifdef UNITTEST
+  int32_t home;
+#endif // UNITTEST
+};
+
+/*
+ * \brief circbuf_shard_home: gets the shard of the calling CPU
+ *
+ * \param pool: pointer to the pool structure
+ * \return: index of the shard
+ *
+ */
+static inline uint32_t circbuf_shard_home(circbuf_shard_t * pool)
+{
+  int cpu = sched_getcpu();
+
+#ifdef UNITTEST
+  // Let tests move a consumer between shards
+  cpu = (pool->home < 0) ? cpu : pool->home;
+#endif // UNITTEST
+
+  // Fall back to the first shard if the CPU is unknown
+  return (cpu < 0) ? 0 : (uint32_t)cpu % pool->count;
+} // circbuf_shard_home()
+
+/*
+ * \brief circbuf_shard_spill_lock: tries to take a shard's spill without
+ *                                  waiting
+ *
+ * \param shard: pointer to the shard
+ * \return: 1 if the spill is now held, 0 if another consumer holds it
+ *
+ */
+static inline uint8_t circbuf_shard_spill_lock(shard_t * shard)
+{
+  // Read first so a held lock is not bounced between cores
+  return LOAD_RELAXED(shard->spill_lock) == 0 &&
+         __atomic_exchange_n(&shard->spill_lock, 1, __ATOMIC_ACQUIRE) == 0;
+} // circbuf_shard_spill_lock()
+
+/*
+ * \brief circbuf_shard_spill_unlock: releases a shard's spill
+ *
+ * \param shard: pointer to the shard
+ *
+ */
+static inline void circbuf_shard_spill_unlock(shard_t * shard)
+{
+  __atomic_store_n(&shard->spill_lock, 0, __ATOMIC_RELEASE);
+} // circbuf_shard_spill_unlock()
+
+/*
+ * \brief circbuf_shard_spill_take: moves items out of a held spill oldest
+ *                                  first, an emptied spill starts over at
+ *                                  the front
+ *
+ * \param pool: pointer to the pool structure
+ * \param shard: pointer to the shard, its spill must be held
+ * \param payloads: array where removed payloads will be placed
+ * \param count: number of payloads wanted
+ * \return: number of payloads moved
+ *
+ */
+static uint32_t circbuf_shard_spill_take(circbuf_shard_t * pool,
+                                         shard_t * shard,
+                                         void ** payloads,
+                                         uint32_t count)
+{
+  uint32_t taken = 0;
+
+  while (taken < count && shard->spill_first < shard->spill_count)
+  {
+    payloads[taken++] = shard->spill[shard->spill_first];
+    STORE_RELAXED(shard->spill_first, shard->spill_first + 1);
+  }
+  if (shard->spill_first == shard->spill_count)
+  {
+    STORE_RELAXED(shard->spill_count, 0);
+    STORE_RELAXED(shard->spill_first, 0);
+  }
+  SUB_RELAXED(pool->shards[shard->spill_from].spilled, taken);
+  return taken;
+} // circbuf_shard_spill_take()
+
+/*
+ * \brief circbuf_shard_unspill: moves items of a shard out of whichever
+ *                               spills hold them.  They were stolen from
+ *                               the front of its ring so they go before
+ *                               anything still in it.
+ *
+ * \param pool: pointer to the pool structure
+ * \param from: index of the shard the items came from
+ * \param payloads: array where removed payloads will be placed
+ * \param count: number of payloads wanted
+ * \return: number of payloads moved
+ *
+ */
+static uint32_t circbuf_shard_unspill(circbuf_shard_t * pool,
+                                      uint32_t from,
+                                      void ** payloads,
+                                      uint32_t count)
+{
+  shard_t * holder;
+  uint32_t taken = 0;
+
+  for (uint32_t i = 0; i < pool->count && taken < count && LOAD_RELAXED(pool->shards[from].spilled) != 0; i++)
+  {
+    // Only lock spills that look like they hold items of this shard
+    holder = &pool->shards[i];
+    if (LOAD_RELAXED(holder->spill_first) != LOAD_RELAXED(holder->spill_count) &&
+        LOAD_RELAXED(holder->spill_from) == from && circbuf_shard_spill_lock(holder))
+    {
+      if (holder->spill_from == from)
+      {
+        taken += circbuf_shard_spill_take(pool, holder, &payloads[taken], count - taken);
+      }
+      circbuf_shard_spill_unlock(holder);
+    }
+  }
+  return taken;
+} // circbuf_shard_unspill()
+
+cb_enum_t circbuf_shard_init(circbuf_shard_t ** pool, uint32_t shards, uint16_t length)
+{
+  FUNC_ENTRY;
+
+  long cpus;
+
+  // Check for null pointers
+  CB_CHECK_NULL(pool);
+
+  // Make sure size is valid
+  if (length <= 0)
+  {
+    return CB_ENUM_NO_LENGTH;
+  }
+
+  // Default to one shard per CPU
+  if (shards == 0)
+  {
+    cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    shards = (cpus > 0) ? (uint32_t)cpus : 1;
+  }
+
+  // Allocate the pool and the shards, the shards on a cache line boundary
+  // so the padding keeps each on its own lines
+  if ((*pool = malloc(sizeof(circbuf_shard_t))) == NULL)
+  {
+    return CB_ENUM_ALLOC_FAILURE;
+  }
+  if (posix_memalign((void **)&(*pool)->shards, CB_CACHE_LINE_SIZE, shards * sizeof(shard_t)) != 0)
+  {
+    free(*pool);
+    return CB_ENUM_ALLOC_FAILURE;
+  }
+  memset((*pool)->shards, 0, shards * sizeof(shard_t));
+  (*pool)->count = shards;
+#ifdef UNITTEST
+  (*pool)->home = -1;
+#endif // UNITTEST
+
+  // Create the buffer for each shard
+  for (uint32_t i = 0; i < shards; i++)
+  {
+    if (circbuf_mpmc_init(&(*pool)->shards[i].buf, length) != CB_ENUM_NO_ERROR)
+    {
+      (*pool)->count = i;
+      circbuf_shard_destroy(*pool);
+      return CB_ENUM_ALLOC_FAILURE;
+    }
+  }
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_shard_init()
+
+cb_enum_t circbuf_shard_destroy(circbuf_shard_t * pool)
+{
+  FUNC_ENTRY;
+
+  // Check for null pointers
+  CB_CHECK_NULL(pool);
+  CB_CHECK_NULL(pool->shards);
+
+  // Free every shard then the pool
+  for (uint32_t i = 0; i < pool->count; i++)
+  {
+    circbuf_mpmc_destroy(pool->shards[i].buf);
+  }
+  free(pool->shards);
+  free(pool);
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_shard_destroy()
+
+cb_enum_t circbuf_shard_add_item(circbuf_shard_t * pool, void * payload)
+{
+  uint32_t added;
+
+  return circbuf_shard_add_items(pool, &payload, 1, &added);
+} // circbuf_shard_add_item()
+
+cb_enum_t circbuf_shard_remove_item(circbuf_shard_t * pool, void ** payload)
+{
+  uint32_t removed;
+
+  return circbuf_shard_remove_items(pool, payload, 1, &removed);
+} // circbuf_shard_remove_item()
+
+cb_enum_t circbuf_shard_add_items(circbuf_shard_t * pool,
+                                  void ** payloads,
+                                  uint32_t count,
+                                  uint32_t * added)
+{
+  uint32_t home;
+  uint32_t index;
+
+  // Check for null pointers
+  CB_CHECK_NULL(pool);
+  CB_CHECK_NULL(payloads);
+  CB_CHECK_NULL(added);
+
+  // Fill the local shard first, moving on to the next shard each time
+  // one is full until every shard has been tried
+  *added = 0;
+  home = circbuf_shard_home(pool);
+  index = home;
+  while (*added < count)
+  {
+    if (circbuf_mpmc_add_item(pool->shards[index].buf, payloads[*added]) == CB_ENUM_NO_ERROR)
+    {
+      (*added)++;
+      continue;
+    }
+    if (++index == pool->count)
+    {
+      index = 0;
+    }
+    if (index == home)
+    {
+      break;
+    }
+  }
+
+  // Full only if nothing could be added
+  return (*added == 0 && count != 0) ? CB_ENUM_FULL : CB_ENUM_NO_ERROR;
+} // circbuf_shard_add_items()
+
+cb_enum_t circbuf_shard_remove_items(circbuf_shard_t * pool,
+                                     void ** payloads,
+                                     uint32_t count,
+                                     uint32_t * removed)
+{
+  shard_t * local;
+  shard_t * victim;
+  uint32_t home;
+  uint32_t index;
+  uint32_t stolen;
+  uint8_t spill;
+
+  // Check for null pointers
+  CB_CHECK_NULL(pool);
+  CB_CHECK_NULL(payloads);
+  CB_CHECK_NULL(removed);
+
+  // Drain the local shard first, starting with any of its items an
+  // earlier steal left in a spill so the shard keeps its order
+  home = circbuf_shard_home(pool);
+  local = &pool->shards[home];
+  *removed = circbuf_shard_unspill(pool, home, payloads, count);
+  while (*removed < count &&
+         circbuf_mpmc_remove_item(local->buf, &payloads[*removed]) == CB_ENUM_NO_ERROR)
+  {
+    (*removed)++;
+  }
+  if (*removed == count)
+  {
+    return CB_ENUM_NO_ERROR;
+  }
+
+  // Then what an earlier steal left in the local spill.  When another
+  // consumer holds it this remove steals just what it needs.
+  spill = circbuf_shard_spill_lock(local);
+  if (spill)
+  {
+    *removed += circbuf_shard_spill_take(pool, local, &payloads[*removed], count - *removed);
+    if (*removed == count)
+    {
+      circbuf_shard_spill_unlock(local);
+      return CB_ENUM_NO_ERROR;
+    }
+  }
+
+  // Steal the rest from the other shards in order, each spilled items
+  // first.  Once the caller has enough, up to CB_SHARD_STEAL_BATCH more
+  // come from the same shard into the local spill so the next removes on
+  // this CPU stay local.  The spill is empty and held here so they always
+  // fit, unlike pushing them into a bounded shard that producers may have
+  // filled meanwhile.
+  for (index = (home + 1) % pool->count; index != home && *removed < count;
+       index = (index + 1) % pool->count)
+  {
+    victim = &pool->shards[index];
+    stolen = circbuf_shard_unspill(pool, index, &payloads[*removed], count - *removed);
+    *removed += stolen;
+    while (*removed < count &&
+           circbuf_mpmc_remove_item(victim->buf, &payloads[*removed]) == CB_ENUM_NO_ERROR)
+    {
+      (*removed)++;
+      stolen++;
+    }
+    if (spill && *removed == count)
+    {
+      STORE_RELAXED(local->spill_from, index);
+      while (local->spill_count < CB_SHARD_STEAL_BATCH &&
+             circbuf_mpmc_remove_item(victim->buf, &local->spill[local->spill_count]) == CB_ENUM_NO_ERROR)
+      {
+        ADD_RELAXED(victim->spilled, 1);
+        STORE_RELAXED(local->spill_count, local->spill_count + 1);
+        stolen++;
+      }
+    }
+    if (stolen != 0)
+    {
+      ADD_RELAXED(local->steals, 1);
+      ADD_RELAXED(local->stolen, stolen);
+    }
+  }
+  if (spill)
+  {
+    circbuf_shard_spill_unlock(local);
+  }
+
+  // Empty only if nothing could be removed anywhere
+  if (*removed == 0 && count != 0)
+  {
+    ADD_RELAXED(pool->shards[home].failed_steals, 1);
+    return CB_ENUM_EMPTY;
+  }
+
+  return CB_ENUM_NO_ERROR;
+} // circbuf_shard_remove_items()
+
+cb_enum_t circbuf_shard_empty(circbuf_shard_t * pool)
+{
+  // Check null pointer
+  CB_CHECK_NULL(pool);
+
+  // Any shard or spill holding an item means not empty
+  for (uint32_t i = 0; i < pool->count; i++)
+  {
+    if (circbuf_mpmc_empty(pool->shards[i].buf) != CB_ENUM_EMPTY ||
+        LOAD_RELAXED(pool->shards[i].spill_first) != LOAD_RELAXED(pool->shards[i].spill_count))
+    {
+      return CB_ENUM_FAILURE;
+    }
+  }
+
+  return CB_ENUM_EMPTY;
+} // circbuf_shard_empty()
+
+cb_enum_t circbuf_shard_count(circbuf_shard_t * pool, uint32_t * shards)
+{
+  // Check null pointers
+  CB_CHECK_NULL(pool);
+  CB_CHECK_NULL(shards);
+
+  *shards = pool->count;
+
+  return CB_ENUM_NO_ERROR;
+} // circbuf_shard_count()
+
+cb_enum_t circbuf_shard_stats(circbuf_shard_t * pool, cb_shard_stats_t * stats)
+{
+  // Check null pointers
+  CB_CHECK_NULL(pool);
+  CB_CHECK_NULL(stats);
+
+  // Sum the statistics of every shard
+  memset(stats, 0, sizeof(cb_shard_stats_t));
+  for (uint32_t i = 0; i < pool->count; i++)
+  {
+    stats->steals += LOAD_RELAXED(pool->shards[i].steals);
+    stats->stolen += LOAD_RELAXED(pool->shards[i].stolen);
+    stats->failed_steals += LOAD_RELAXED(pool->shards[i].failed_steals);
+  }
+
+  return CB_ENUM_NO_ERROR;
+} // circbuf_shard_stats()
+
+#ifdef UNITTEST
+// This is a test function used to pin the home shard, -1 goes back to the CPU
+cb_enum_t circbuf_shard_set_home(circbuf_shard_t * pool, int32_t home)
+{
+  // Check for null pointer
+  CB_CHECK_NULL(pool);
+
+  pool->home = home;
+
+  return CB_ENUM_NO_ERROR;
+} // circbuf_shard_set_home()
+#endif // UNITTEST
@@ -0,0 +1,447 @@
+/** @file circbuf_shm.c
+*
+* @brief Implementation of single producer/single consumer circular buffer
+*        in shared memory.  Everything the two processes share lives in the
+*        mapping and is addressed by slot index, never by pointer, because
+*        each process can map the segment at a different address.
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "circbuf_shm.h"
+#include "futex.h"
+#include "log.h"
+#include "project_defs.h"
+
+// Atomic helpers for the shared indices and wait flags
+#define LOAD_ACQUIRE(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define LOAD_RELAXED(x) __atomic_load_n(&(x), __ATOMIC_RELAXED)
+#define STORE_RELEASE(x, val) __atomic_store_n(&(x), val, __ATOMIC_RELEASE)
+#define STORE_RELAXED(x, val) __atomic_store_n(&(x), val, __ATOMIC_RELAXED)
+#define EXCHANGE_RELAXED(x, val) __atomic_exchange_n(&(x), val, __ATOMIC_RELAXED)
+#define FULL_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+// Marks a segment as an initialized circbuf
+#define CIRCBUF_SHM_MAGIC (0x43425348)
+
+// Header at the start of the shared segment, the item slots follow it.
+// Each wait flag sits on the cache line of the side that reads it on every
+// operation, the other side only writes it before going to sleep.
+typedef struct circbuf_shm_hdr
+{
+  // Producer cache line
+  uint32_t head;
+  uint32_t tail_cache;
+  uint32_t consumer_waiting;
+  uint8_t producer_pad[CB_CACHE_LINE_SIZE - 3 * sizeof(uint32_t)];
+
+  // Consumer cache line
+  uint32_t tail;
+  uint32_t head_cache;
+  uint32_t producer_waiting;
+  uint8_t consumer_pad[CB_CACHE_LINE_SIZE - 3 * sizeof(uint32_t)];
+
+  // Set once when the segment is created
+  uint32_t magic;
+  uint32_t slots;
+  uint32_t item_size;
+  uint8_t info_pad[CB_CACHE_LINE_SIZE - 3 * sizeof(uint32_t)];
+} circbuf_shm_hdr_t;
+
+// Process local handle for the shared segment
+struct circbuf_shm
+{
+  circbuf_shm_hdr_t * hdr;
+  uint8_t * items;
+  size_t map_size;
+
+  // Copies of the checked header sizes.  The peer can rewrite the shared
+  // header at any time, so copies and wraps only ever use these.
+  uint32_t slots;
+  uint32_t item_size;
+
+  // Process that created the segment, only it unlinks the name.  A child
+  // that inherits the handle across fork is not the owner.
+  pid_t owner;
+  char name[FILE_NAME_MAX];
+};
+
+/*
+ * \brief circbuf_shm_map: maps a shared segment and creates the handle
+ *
+ * \param buf: pointer to a pointer for the circular buffer handle
+ * \param fd: file descriptor of the segment or -1 for anonymous memory
+ * \param map_size: size of the segment
+ * \return: success or error
+ *
+ */
+static cb_enum_t circbuf_shm_map(circbuf_shm_t ** buf, int fd, size_t map_size)
+{
+  int flags = (fd < 0) ? MAP_SHARED | MAP_ANONYMOUS : MAP_SHARED;
+
+  // Allocate the process local handle
+  if ((*buf = malloc(sizeof(circbuf_shm_t))) == NULL)
+  {
+    return CB_ENUM_ALLOC_FAILURE;
+  }
+  memset(*buf, 0, sizeof(circbuf_shm_t));
+
+  // Map the segment shared so writes are seen by the other process
+  (*buf)->hdr = mmap(NULL, map_size, PROT_READ | PROT_WRITE, flags, fd, 0);
+  if ((*buf)->hdr == MAP_FAILED)
+  {
+    LOG_ERROR("mmap failed with error: %s", strerror(errno));
+    free(*buf);
+    return CB_ENUM_ALLOC_FAILURE;
+  }
+  (*buf)->items = (uint8_t *)((*buf)->hdr + 1);
+  (*buf)->map_size = map_size;
+
+  return CB_ENUM_NO_ERROR;
+} // circbuf_shm_map()
+
+cb_enum_t circbuf_shm_init(circbuf_shm_t ** buf,
+                           const char * name,
+                           uint16_t length,
+                           uint32_t item_size)
+{
+  FUNC_ENTRY;
+
+  circbuf_shm_hdr_t * hdr;
+  cb_enum_t res;
+  size_t map_size;
+  int fd = -1;
+
+  // Check for null pointers
+  CB_CHECK_NULL(buf);
+
+  // Make sure sizes are valid
+  if (length <= 0 || item_size == 0)
+  {
+    return CB_ENUM_NO_LENGTH;
+  }
+
+  // One slot is always left open so head == tail means empty
+  map_size = sizeof(circbuf_shm_hdr_t) + ((size_t)length + 1) * item_size;
+
+  // Create a new named segment, it is an error if it already exists
+  if (name != NULL)
+  {
+    fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+      LOG_ERROR("shm_open %s failed with error: %s", name, strerror(errno));
+      return CB_ENUM_FAILURE;
+    }
+    if (ftruncate(fd, map_size) != 0)
+    {
+      LOG_ERROR("ftruncate failed with error: %s", strerror(errno));
+      close(fd);
+      shm_unlink(name);
+      return CB_ENUM_ALLOC_FAILURE;
+    }
+  }
+
+  // Map the segment, the descriptor is not needed after that
+  res = circbuf_shm_map(buf, fd, map_size);
+  if (fd >= 0)
+  {
+    close(fd);
+  }
+  if (res != CB_ENUM_NO_ERROR)
+  {
+    if (name != NULL)
+    {
+      shm_unlink(name);
+    }
+    return res;
+  }
+
+  // Remember the name so the creator can unlink it
+  if (name != NULL)
+  {
+    strncpy((*buf)->name, name, FILE_NAME_MAX - 1);
+  }
+  (*buf)->owner = getpid();
+
+  // Fill out the header, the magic is written last so a process opening
+  // the segment never sees a partial header
+  hdr = (*buf)->hdr;
+  memset(hdr, 0, sizeof(*hdr));
+  hdr->slots = (uint32_t)length + 1;
+  hdr->item_size = item_size;
+  (*buf)->slots = hdr->slots;
+  (*buf)->item_size = item_size;
+  STORE_RELEASE(hdr->magic, CIRCBUF_SHM_MAGIC);
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_shm_init()
+
+cb_enum_t circbuf_shm_open(circbuf_shm_t ** buf, const char * name)
+{
+  FUNC_ENTRY;
+
+  circbuf_shm_hdr_t * hdr;
+  struct stat info;
+  cb_enum_t res;
+  int fd;
+
+  // Check for null pointers
+  CB_CHECK_NULL(buf);
+  CB_CHECK_NULL(name);
+
+  // Open the existing segment and find its size
+  fd = shm_open(name, O_RDWR, 0);
+  if (fd < 0)
+  {
+    LOG_ERROR("shm_open %s failed with error: %s", name, strerror(errno));
+    return CB_ENUM_FAILURE;
+  }
+  if (fstat(fd, &info) != 0 || info.st_size < sizeof(circbuf_shm_hdr_t))
+  {
+    LOG_ERROR("%s is not a circbuf segment", name);
+    close(fd);
+    return CB_ENUM_FAILURE;
+  }
+
+  // Map the segment, the descriptor is not needed after that
+  res = circbuf_shm_map(buf, fd, info.st_size);
+  close(fd);
+  if (res != CB_ENUM_NO_ERROR)
+  {
+    return res;
+  }
+
+  // Make sure the creator finished setting up the segment and that the
+  // slots it describes fit in what was mapped.  A truncated, stale or
+  // foreign segment would otherwise send the copies past the mapping.
+  // The sizes are read once and kept so a later rewrite can not change them.
+  hdr = (*buf)->hdr;
+  if (LOAD_ACQUIRE(hdr->magic) == CIRCBUF_SHM_MAGIC)
+  {
+    (*buf)->slots = LOAD_RELAXED(hdr->slots);
+    (*buf)->item_size = LOAD_RELAXED(hdr->item_size);
+  }
+  if ((*buf)->slots < 2 || (*buf)->item_size == 0 ||
+      sizeof(circbuf_shm_hdr_t) + (size_t)(*buf)->slots * (*buf)->item_size > (*buf)->map_size ||
+      LOAD_RELAXED(hdr->head) >= (*buf)->slots || LOAD_RELAXED(hdr->tail) >= (*buf)->slots)
+  {
+    LOG_ERROR("%s is not a circbuf segment", name);
+    munmap((*buf)->hdr, (*buf)->map_size);
+    free(*buf);
+    return CB_ENUM_FAILURE;
+  }
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_shm_open()
+
+cb_enum_t circbuf_shm_destroy(circbuf_shm_t * buf)
+{
+  FUNC_ENTRY;
+
+  // Check for null pointers
+  CB_CHECK_NULL(buf);
+  CB_CHECK_NULL(buf->hdr);
+
+  // Unmap the segment, the creator also removes the name
+  munmap(buf->hdr, buf->map_size);
+  if (buf->owner == getpid() && buf->name[0] != '\0')
+  {
+    shm_unlink(buf->name);
+  }
+
+  // Free the handle
+  free(buf);
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_shm_destroy()
+
+cb_enum_t circbuf_shm_add_item(circbuf_shm_t * buf, const void * item)
+{
+  circbuf_shm_hdr_t * hdr;
+  uint32_t head;
+  uint32_t next;
+
+  // Check for null pointers
+  CB_CHECK_NULL(buf);
+  CB_CHECK_NULL(item);
+
+  // Head is only written by the producer, but it lives in the shared
+  // mapping so it is checked before it picks a slot
+  hdr = buf->hdr;
+  head = LOAD_RELAXED(hdr->head);
+  if (head >= buf->slots)
+  {
+    return CB_ENUM_FAILURE;
+  }
+  next = head + 1;
+  if (next == buf->slots)
+  {
+    next = 0;
+  }
+
+  // Only go to the consumer cache line when the cached tail says full
+  if (next == hdr->tail_cache)
+  {
+    hdr->tail_cache = LOAD_ACQUIRE(hdr->tail);
+    if (next == hdr->tail_cache)
+    {
+      return CB_ENUM_FULL;
+    }
+  }
+
+  // Copy the item in then publish it to the consumer
+  memcpy(buf->items + (size_t)head * buf->item_size, item, buf->item_size);
+  STORE_RELEASE(hdr->head, next);
+
+  // Wake the consumer if it went to sleep on an empty buffer.  The fence
+  // pairs with the one in circbuf_shm_remove_item_wait so either the
+  // consumer sees the new head or this side sees the flag.  Clearing the
+  // flag means a burst of adds makes at most one wake call.
+  FULL_FENCE();
+  if (LOAD_RELAXED(hdr->consumer_waiting) && EXCHANGE_RELAXED(hdr->consumer_waiting, 0))
+  {
+    futex_wake(&hdr->head, 1, 1);
+  }
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_shm_add_item()
+
+cb_enum_t circbuf_shm_remove_item(circbuf_shm_t * buf, void * item)
+{
+  circbuf_shm_hdr_t * hdr;
+  uint32_t tail;
+  uint32_t next;
+
+  // Check for null pointers
+  CB_CHECK_NULL(buf);
+  CB_CHECK_NULL(item);
+
+  // Tail is only written by the consumer, but it lives in the shared
+  // mapping so it is checked before it picks a slot
+  hdr = buf->hdr;
+  tail = LOAD_RELAXED(hdr->tail);
+  if (tail >= buf->slots)
+  {
+    return CB_ENUM_FAILURE;
+  }
+
+  // Only go to the producer cache line when the cached head says empty
+  if (tail == hdr->head_cache)
+  {
+    hdr->head_cache = LOAD_ACQUIRE(hdr->head);
+    if (tail == hdr->head_cache)
+    {
+      return CB_ENUM_EMPTY;
+    }
+  }
+
+  // Copy the item out then hand the slot back to the producer
+  memcpy(item, buf->items + (size_t)tail * buf->item_size, buf->item_size);
+  next = tail + 1;
+  if (next == buf->slots)
+  {
+    next = 0;
+  }
+  STORE_RELEASE(hdr->tail, next);
+
+  // Wake the producer if it went to sleep on a full buffer
+  FULL_FENCE();
+  if (LOAD_RELAXED(hdr->producer_waiting) && EXCHANGE_RELAXED(hdr->producer_waiting, 0))
+  {
+    futex_wake(&hdr->tail, 1, 1);
+  }
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_shm_remove_item()
+
+cb_enum_t circbuf_shm_add_item_wait(circbuf_shm_t * buf, const void * item)
+{
+  circbuf_shm_hdr_t * hdr;
+  cb_enum_t res;
+  uint32_t next;
+  uint32_t tail;
+
+  // Check for null pointers
+  CB_CHECK_NULL(buf);
+  CB_CHECK_NULL(item);
+  hdr = buf->hdr;
+
+  // Sleep on tail while full
+  while ((res = circbuf_shm_add_item(buf, item)) == CB_ENUM_FULL)
+  {
+    // Announce the wait then check again so a remove in between is seen
+    STORE_RELAXED(hdr->producer_waiting, 1);
+    FULL_FENCE();
+    tail = LOAD_RELAXED(hdr->tail);
+    next = LOAD_RELAXED(hdr->head) + 1;
+    if (next == buf->slots)
+    {
+      next = 0;
+    }
+    if (next == tail)
+    {
+      futex_wait(&hdr->tail, tail, NULL, 1);
+    }
+    STORE_RELAXED(hdr->producer_waiting, 0);
+  }
+
+  return res;
+} // circbuf_shm_add_item_wait()
+
+cb_enum_t circbuf_shm_remove_item_wait(circbuf_shm_t * buf, void * item)
+{
+  circbuf_shm_hdr_t * hdr;
+  cb_enum_t res;
+  uint32_t head;
+
+  // Check for null pointers
+  CB_CHECK_NULL(buf);
+  CB_CHECK_NULL(item);
+  hdr = buf->hdr;
+
+  // Sleep on head while empty
+  while ((res = circbuf_shm_remove_item(buf, item)) == CB_ENUM_EMPTY)
+  {
+    // Announce the wait then check again so an add in between is seen
+    STORE_RELAXED(hdr->consumer_waiting, 1);
+    FULL_FENCE();
+    head = LOAD_RELAXED(hdr->head);
+    if (head == hdr->tail)
+    {
+      futex_wait(&hdr->head, head, NULL, 1);
+    }
+    STORE_RELAXED(hdr->consumer_waiting, 0);
+  }
+
+  return res;
+} // circbuf_shm_remove_item_wait()
+
+cb_enum_t circbuf_shm_empty(circbuf_shm_t * buf)
+{
+  // Check null pointer
+  CB_CHECK_NULL(buf);
+
+  // Buffer is empty when head and tail meet
+  if (LOAD_ACQUIRE(buf->hdr->head) == LOAD_ACQUIRE(buf->hdr->tail))
+  {
+    return CB_ENUM_EMPTY;
+  }
+
+  // Buffer is not empty return failure
+  return CB_ENUM_FAILURE;
+} // circbuf_shm_empty()
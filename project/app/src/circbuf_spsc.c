@@ -0,0 +1,384 @@
+/** @file circbuf_spsc.c
+*
+* @brief Implementation of lock-free single producer/single consumer
+*        circular buffer
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "circbuf_spsc.h"
+#include "futex.h"
+#include "log.h"
+
+// Load/store an index or wait flag shared between producer and consumer
+#define LOAD_ACQUIRE(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define LOAD_RELAXED(x) __atomic_load_n(&(x), __ATOMIC_RELAXED)
+#define STORE_RELEASE(x, val) __atomic_store_n(&(x), val, __ATOMIC_RELEASE)
+#define STORE_RELAXED(x, val) __atomic_store_n(&(x), val, __ATOMIC_RELAXED)
+#define EXCHANGE_RELAXED(x, val) __atomic_exchange_n(&(x), val, __ATOMIC_RELAXED)
+#define FULL_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+// Nanoseconds in a second
+#define NSEC_PER_SEC (1000000000L)
+
+// Circular buffer structure.  Head is only written by the producer and tail
+// is only written by the consumer, each side keeps a cached copy of the
+// other index so it only reads the shared cache line when it looks full or
+// empty.  The wait flag of each side sits on the line the other side
+// already touches on every operation so checking it costs no extra miss.
+struct circbuf_spsc
+{
+  // Producer cache line
+  uint32_t head;
+  uint32_t tail_cache;
+  uint32_t consumer_waiting;
+  uint8_t producer_pad[CB_CACHE_LINE_SIZE - 3 * sizeof(uint32_t)];
+
+  // Consumer cache line
+  uint32_t tail;
+  uint32_t head_cache;
+  uint32_t producer_waiting;
+  uint8_t consumer_pad[CB_CACHE_LINE_SIZE - 3 * sizeof(uint32_t)];
+
+  // Read only after initialization.  One slot is always left open so that
+  // head == tail means empty without a shared count.
+  void ** buffer;
+  uint32_t slots;
+};
+
+/*
+ * \brief circbuf_spsc_bad_timeout: checks a timeout is one futex_wait takes,
+ *                                 it fails a bad one with EINVAL which would
+ *                                 look like a wake up and spin to the deadline
+ *
+ * \param timeout: relative timeout or NULL
+ * \return: 1 if the timeout is negative or tv_nsec is out of range
+ *
+ */
+static inline uint8_t circbuf_spsc_bad_timeout(const struct timespec * timeout)
+{
+  return timeout != NULL &&
+         (timeout->tv_sec < 0 || timeout->tv_nsec < 0 || timeout->tv_nsec >= NSEC_PER_SEC);
+} // circbuf_spsc_bad_timeout()
+
+/*
+ * \brief circbuf_spsc_deadline: converts a relative timeout into an
+ *                              absolute monotonic deadline
+ *
+ * \param timeout: relative timeout
+ * \param deadline: memory location where the deadline will be placed
+ *
+ */
+static void circbuf_spsc_deadline(const struct timespec * timeout,
+                                  struct timespec * deadline)
+{
+  clock_gettime(CLOCK_MONOTONIC, deadline);
+  deadline->tv_sec += timeout->tv_sec;
+  deadline->tv_nsec += timeout->tv_nsec;
+  if (deadline->tv_nsec >= NSEC_PER_SEC)
+  {
+    deadline->tv_sec++;
+    deadline->tv_nsec -= NSEC_PER_SEC;
+  }
+} // circbuf_spsc_deadline()
+
+/*
+ * \brief circbuf_spsc_remaining: gets the time left until a deadline
+ *
+ * \param deadline: absolute monotonic deadline
+ * \param remaining: memory location where the time left will be placed
+ * \return: 1 if there is time left or 0 if the deadline has passed
+ *
+ */
+static uint8_t circbuf_spsc_remaining(const struct timespec * deadline,
+                                      struct timespec * remaining)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  remaining->tv_sec = deadline->tv_sec - now.tv_sec;
+  remaining->tv_nsec = deadline->tv_nsec - now.tv_nsec;
+  if (remaining->tv_nsec < 0)
+  {
+    remaining->tv_sec--;
+    remaining->tv_nsec += NSEC_PER_SEC;
+  }
+
+  return remaining->tv_sec >= 0;
+} // circbuf_spsc_remaining()
+
+cb_enum_t circbuf_spsc_init(circbuf_spsc_t ** buf, uint16_t length)
+{
+  FUNC_ENTRY;
+
+  // Check for null pointers
+  CB_CHECK_NULL(buf);
+
+  // Make sure size is valid
+  if (length <= 0)
+  {
+    return CB_ENUM_NO_LENGTH;
+  }
+
+  // Allocate the new circular buffer on a cache line boundary, malloc only
+  // promises 16 bytes so the padded lines could still straddle
+  if (posix_memalign((void **)buf, CB_CACHE_LINE_SIZE, sizeof(circbuf_spsc_t)) != 0)
+  {
+    *buf = NULL;
+    return CB_ENUM_ALLOC_FAILURE;
+  }
+  memset(*buf, 0, sizeof(circbuf_spsc_t));
+
+  // Allocate the internal buffer with the open slot
+  (*buf)->slots = (uint32_t)length + 1;
+  if (((*buf)->buffer = calloc((*buf)->slots, sizeof(void *))) == NULL)
+  {
+    free(*buf);
+    return CB_ENUM_ALLOC_FAILURE;
+  }
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_spsc_init()
+
+cb_enum_t circbuf_spsc_destroy(circbuf_spsc_t * buf)
+{
+  FUNC_ENTRY;
+
+  // Check for null pointers
+  CB_CHECK_NULL(buf);
+  CB_CHECK_NULL(buf->buffer);
+
+  // Free the buffer and structure
+  free(buf->buffer);
+  free(buf);
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_spsc_destroy()
+
+cb_enum_t circbuf_spsc_add_item(circbuf_spsc_t * buf, void * payload)
+{
+  uint32_t head;
+  uint32_t next;
+
+  // Check for null pointer
+  CB_CHECK_NULL(buf);
+
+  // Head is only written by this thread so no ordering is needed to read it
+  head = buf->head;
+  next = head + 1;
+  if (next == buf->slots)
+  {
+    next = 0;
+  }
+
+  // Only go to the consumer cache line when the cached tail says full
+  if (next == buf->tail_cache)
+  {
+    buf->tail_cache = LOAD_ACQUIRE(buf->tail);
+    if (next == buf->tail_cache)
+    {
+      return CB_ENUM_FULL;
+    }
+  }
+
+  // Write the payload then publish it to the consumer
+  buf->buffer[head] = payload;
+  STORE_RELEASE(buf->head, next);
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_spsc_add_item()
+
+cb_enum_t circbuf_spsc_remove_item(circbuf_spsc_t * buf, void ** payload)
+{
+  uint32_t tail;
+  uint32_t next;
+
+  // Check for null pointer
+  CB_CHECK_NULL(buf);
+  CB_CHECK_NULL(payload);
+
+  // Tail is only written by this thread so no ordering is needed to read it
+  tail = buf->tail;
+
+  // Only go to the producer cache line when the cached head says empty
+  if (tail == buf->head_cache)
+  {
+    buf->head_cache = LOAD_ACQUIRE(buf->head);
+    if (tail == buf->head_cache)
+    {
+      return CB_ENUM_EMPTY;
+    }
+  }
+
+  // Read the payload then hand the slot back to the producer
+  *payload = buf->buffer[tail];
+  next = tail + 1;
+  if (next == buf->slots)
+  {
+    next = 0;
+  }
+  STORE_RELEASE(buf->tail, next);
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_spsc_remove_item()
+
+cb_enum_t circbuf_spsc_add_item_wait(circbuf_spsc_t * buf,
+                                     void * payload,
+                                     const struct timespec * timeout)
+{
+  struct timespec deadline;
+  struct timespec remaining;
+  cb_enum_t res;
+  uint32_t next;
+  uint32_t tail;
+
+  // Check for null pointer and a timeout that can not be waited on
+  CB_CHECK_NULL(buf);
+  if (circbuf_spsc_bad_timeout(timeout))
+  {
+    return CB_ENUM_FAILURE;
+  }
+
+  // Only read the clock once the buffer has been found full
+  if ((res = circbuf_spsc_add_item(buf, payload)) == CB_ENUM_FULL &&
+      timeout != NULL)
+  {
+    circbuf_spsc_deadline(timeout, &deadline);
+  }
+
+  // Sleep on tail while full
+  while (res == CB_ENUM_FULL)
+  {
+    if (timeout != NULL && !circbuf_spsc_remaining(&deadline, &remaining))
+    {
+      return CB_ENUM_FULL;
+    }
+
+    // Announce the wait then check again so a remove in between is seen
+    STORE_RELAXED(buf->producer_waiting, 1);
+    FULL_FENCE();
+    tail = LOAD_RELAXED(buf->tail);
+    next = buf->head + 1;
+    if (next == buf->slots)
+    {
+      next = 0;
+    }
+    if (next == tail)
+    {
+      futex_wait(&buf->tail, tail, (timeout != NULL) ? &remaining : NULL, 0);
+    }
+    STORE_RELAXED(buf->producer_waiting, 0);
+    res = circbuf_spsc_add_item(buf, payload);
+  }
+
+  // Wake the consumer if it went to sleep on an empty buffer.  The fence
+  // pairs with the one in circbuf_spsc_remove_item_wait so either the
+  // consumer sees the new head or this side sees the flag.  Clearing the
+  // flag means a burst of adds makes at most one wake call.
+  FULL_FENCE();
+  if (LOAD_RELAXED(buf->consumer_waiting) && EXCHANGE_RELAXED(buf->consumer_waiting, 0))
+  {
+    futex_wake(&buf->head, 1, 0);
+  }
+
+  return res;
+} // circbuf_spsc_add_item_wait()
+
+cb_enum_t circbuf_spsc_remove_item_wait(circbuf_spsc_t * buf,
+                                        void ** payload,
+                                        const struct timespec * timeout)
+{
+  struct timespec deadline;
+  struct timespec remaining;
+  cb_enum_t res;
+  uint32_t head;
+
+  // Check for null pointer and a timeout that can not be waited on
+  CB_CHECK_NULL(buf);
+  if (circbuf_spsc_bad_timeout(timeout))
+  {
+    return CB_ENUM_FAILURE;
+  }
+
+  // Only read the clock once the buffer has been found empty
+  if ((res = circbuf_spsc_remove_item(buf, payload)) == CB_ENUM_EMPTY &&
+      timeout != NULL)
+  {
+    circbuf_spsc_deadline(timeout, &deadline);
+  }
+
+  // Sleep on head while empty
+  while (res == CB_ENUM_EMPTY)
+  {
+    if (timeout != NULL && !circbuf_spsc_remaining(&deadline, &remaining))
+    {
+      return CB_ENUM_EMPTY;
+    }
+
+    // Announce the wait then check again so an add in between is seen
+    STORE_RELAXED(buf->consumer_waiting, 1);
+    FULL_FENCE();
+    head = LOAD_RELAXED(buf->head);
+    if (head == buf->tail)
+    {
+      futex_wait(&buf->head, head, (timeout != NULL) ? &remaining : NULL, 0);
+    }
+    STORE_RELAXED(buf->consumer_waiting, 0);
+    res = circbuf_spsc_remove_item(buf, payload);
+  }
+
+  // Wake the producer if it went to sleep on a full buffer
+  FULL_FENCE();
+  if (LOAD_RELAXED(buf->producer_waiting) && EXCHANGE_RELAXED(buf->producer_waiting, 0))
+  {
+    futex_wake(&buf->tail, 1, 0);
+  }
+
+  return res;
+} // circbuf_spsc_remove_item_wait()
+
+cb_enum_t circbuf_spsc_full(circbuf_spsc_t * buf)
+{
+  uint32_t next;
+
+  // Check null pointer
+  CB_CHECK_NULL(buf);
+
+  // Buffer is full when head is one behind tail
+  next = LOAD_ACQUIRE(buf->head) + 1;
+  if (next == buf->slots)
+  {
+    next = 0;
+  }
+  if (next == LOAD_ACQUIRE(buf->tail))
+  {
+    return CB_ENUM_FULL;
+  }
+
+  // Buffer is not full return failure
+  return CB_ENUM_FAILURE;
+} // circbuf_spsc_full()
+
+cb_enum_t circbuf_spsc_empty(circbuf_spsc_t * buf)
+{
+  // Check null pointer
+  CB_CHECK_NULL(buf);
+
+  // Buffer is empty when head and tail meet
+  if (LOAD_ACQUIRE(buf->head) == LOAD_ACQUIRE(buf->tail))
+  {
+    return CB_ENUM_EMPTY;
+  }
+
+  // Buffer is not empty return failure
+  return CB_ENUM_FAILURE;
+} // circbuf_spsc_empty()
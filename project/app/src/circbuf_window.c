@@ -0,0 +1,396 @@
+/** @file circbuf_window.c
+*
+* @brief Implementation of sliding window statistics.  The samples are kept
+*        in their own ring so the one leaving is known.  Min and max come
+*        from monotonic deques of sample positions, the front of each is the
+*        answer and every sample enters and leaves each deque at most once.
+*        The sum is kept running and rebuilt once per window so rounding
+*        error can not build up.
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "circbuf_window.h"
+#include "log.h"
+
+// Deque of sample positions, stored as a ring as long as the window
+typedef struct window_deque
+{
+  uint64_t * positions;
+  uint32_t first;
+  uint32_t count;
+} window_deque_t;
+
+// Window structure
+struct circbuf_window
+{
+  double * samples;
+  uint32_t length;
+  uint32_t count;
+  uint64_t next;
+  double sum;
+  uint32_t evicted;
+  window_deque_t min;
+  window_deque_t max;
+  uint32_t * histogram;
+  uint16_t buckets;
+  double low;
+  double width;
+};
+
+/*
+ * \brief circbuf_window_sample: gets the sample at a position
+ *
+ * \param win: pointer to the window structure
+ * \param position: position of a sample still in the window
+ * \return: the sample
+ *
+ */
+static inline double circbuf_window_sample(circbuf_window_t * win, uint64_t position)
+{
+  return win->samples[position % win->length];
+} // circbuf_window_sample()
+
+/*
+ * \brief circbuf_window_bucket: gets the histogram bucket of a sample
+ *
+ * \param win: pointer to the window structure
+ * \param sample: sample to place
+ * \return: index of the bucket
+ *
+ */
+static inline uint32_t circbuf_window_bucket(circbuf_window_t * win, double sample)
+{
+  double offset = (sample - win->low) / win->width;
+
+  // Samples out of range land in the end buckets
+  if (offset < 0)
+  {
+    return 0;
+  }
+  if (offset >= win->buckets)
+  {
+    return win->buckets - 1;
+  }
+  return (uint32_t)offset;
+} // circbuf_window_bucket()
+
+/*
+ * \brief circbuf_window_push: adds the newest position to a deque after
+ *                             dropping every position the new sample
+ *                             replaces as the answer
+ *
+ * \param win: pointer to the window structure
+ * \param deque: deque to add to
+ * \param sample: newest sample
+ * \param smallest: non zero for the min deque, 0 for the max deque
+ *
+ */
+static inline void circbuf_window_push(circbuf_window_t * win,
+                                       window_deque_t * deque,
+                                       double sample,
+                                       uint8_t smallest)
+{
+  double back;
+
+  // Older samples that can never be the answer again are dropped
+  while (deque->count != 0)
+  {
+    back = circbuf_window_sample(win,
+             deque->positions[(deque->first + deque->count - 1) % win->length]);
+    if ((smallest && back < sample) || (!smallest && back > sample))
+    {
+      break;
+    }
+    deque->count--;
+  }
+
+  deque->positions[(deque->first + deque->count) % win->length] = win->next;
+  deque->count++;
+} // circbuf_window_push()
+
+/*
+ * \brief circbuf_window_pop: drops a position leaving the window from the
+ *                            front of a deque if it is there
+ *
+ * \param win: pointer to the window structure
+ * \param deque: deque to drop from
+ * \param position: position leaving the window
+ *
+ */
+static inline void circbuf_window_pop(circbuf_window_t * win,
+                                      window_deque_t * deque,
+                                      uint64_t position)
+{
+  if (deque->count != 0 && deque->positions[deque->first] == position)
+  {
+    deque->first = (deque->first + 1) % win->length;
+    deque->count--;
+  }
+} // circbuf_window_pop()
+
+cb_enum_t circbuf_window_init(circbuf_window_t ** win,
+                              uint16_t length,
+                              double low,
+                              double high,
+                              uint16_t buckets)
+{
+  FUNC_ENTRY;
+
+  // Check for null pointers
+  CB_CHECK_NULL(win);
+
+  // Make sure sizes are valid
+  if (length <= 0 || (buckets != 0 && !(high > low)))
+  {
+    return CB_ENUM_NO_LENGTH;
+  }
+
+  // Allocate the window and its arrays
+  if ((*win = calloc(1, sizeof(circbuf_window_t))) == NULL)
+  {
+    return CB_ENUM_ALLOC_FAILURE;
+  }
+  (*win)->samples = malloc(sizeof(double) * length);
+  (*win)->min.positions = malloc(sizeof(uint64_t) * length);
+  (*win)->max.positions = malloc(sizeof(uint64_t) * length);
+  if (buckets != 0)
+  {
+    (*win)->histogram = calloc(buckets, sizeof(uint32_t));
+  }
+  if ((*win)->samples == NULL || (*win)->min.positions == NULL ||
+      (*win)->max.positions == NULL || (buckets != 0 && (*win)->histogram == NULL))
+  {
+    circbuf_window_destroy(*win);
+    return CB_ENUM_ALLOC_FAILURE;
+  }
+
+  // Set the remaining elements of the window
+  (*win)->length  = length;
+  (*win)->buckets = buckets;
+  (*win)->low     = low;
+  (*win)->width   = (buckets != 0) ? (high - low) / buckets : 0;
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_window_init()
+
+cb_enum_t circbuf_window_destroy(circbuf_window_t * win)
+{
+  FUNC_ENTRY;
+
+  // Check for null pointers
+  CB_CHECK_NULL(win);
+
+  // Free the arrays then the window
+  free(win->samples);
+  free(win->min.positions);
+  free(win->max.positions);
+  free(win->histogram);
+  free(win);
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_window_destroy()
+
+cb_enum_t circbuf_window_add(circbuf_window_t * win, double sample)
+{
+  uint64_t oldest;
+  double leaving;
+
+  // Check for null pointer
+  CB_CHECK_NULL(win);
+
+  // NaN fails every comparison and inf can not be summed back out, either
+  // would corrupt the deques, the sum and the histogram bucket
+  if (!isfinite(sample))
+  {
+    return CB_ENUM_FAILURE;
+  }
+
+  // Take the oldest sample out of every aggregate once the window is full
+  if (win->count == win->length)
+  {
+    oldest = win->next - win->length;
+    leaving = circbuf_window_sample(win, oldest);
+    win->sum -= leaving;
+    circbuf_window_pop(win, &win->min, oldest);
+    circbuf_window_pop(win, &win->max, oldest);
+    if (win->histogram != NULL)
+    {
+      win->histogram[circbuf_window_bucket(win, leaving)]--;
+    }
+    win->count--;
+    win->evicted++;
+  }
+
+  // Store the sample and add it to every aggregate
+  win->samples[win->next % win->length] = sample;
+  win->sum += sample;
+  circbuf_window_push(win, &win->min, sample, 1);
+  circbuf_window_push(win, &win->max, sample, 0);
+  if (win->histogram != NULL)
+  {
+    win->histogram[circbuf_window_bucket(win, sample)]++;
+  }
+  win->next++;
+  win->count++;
+
+  // Rebuild the sum once per window so rounding error can not build up
+  if (win->evicted == win->length)
+  {
+    win->evicted = 0;
+    win->sum = 0;
+    for (uint32_t i = 0; i < win->length; i++)
+    {
+      win->sum += win->samples[i];
+    }
+  }
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // circbuf_window_add()
+
+cb_enum_t circbuf_window_count(circbuf_window_t * win, uint32_t * count)
+{
+  // Check for null pointers
+  CB_CHECK_NULL(win);
+  CB_CHECK_NULL(count);
+
+  *count = win->count;
+
+  return CB_ENUM_NO_ERROR;
+} // circbuf_window_count()
+
+cb_enum_t circbuf_window_min(circbuf_window_t * win, double * min)
+{
+  // Check for null pointers
+  CB_CHECK_NULL(win);
+  CB_CHECK_NULL(min);
+
+  // The front of the min deque is the smallest sample
+  if (win->count == 0)
+  {
+    return CB_ENUM_EMPTY;
+  }
+  *min = circbuf_window_sample(win, win->min.positions[win->min.first]);
+
+  return CB_ENUM_NO_ERROR;
+} // circbuf_window_min()
+
+cb_enum_t circbuf_window_max(circbuf_window_t * win, double * max)
+{
+  // Check for null pointers
+  CB_CHECK_NULL(win);
+  CB_CHECK_NULL(max);
+
+  // The front of the max deque is the largest sample
+  if (win->count == 0)
+  {
+    return CB_ENUM_EMPTY;
+  }
+  *max = circbuf_window_sample(win, win->max.positions[win->max.first]);
+
+  return CB_ENUM_NO_ERROR;
+} // circbuf_window_max()
+
+cb_enum_t circbuf_window_sum(circbuf_window_t * win, double * sum)
+{
+  // Check for null pointers
+  CB_CHECK_NULL(win);
+  CB_CHECK_NULL(sum);
+
+  if (win->count == 0)
+  {
+    return CB_ENUM_EMPTY;
+  }
+  *sum = win->sum;
+
+  return CB_ENUM_NO_ERROR;
+} // circbuf_window_sum()
+
+cb_enum_t circbuf_window_mean(circbuf_window_t * win, double * mean)
+{
+  // Check for null pointers
+  CB_CHECK_NULL(win);
+  CB_CHECK_NULL(mean);
+
+  if (win->count == 0)
+  {
+    return CB_ENUM_EMPTY;
+  }
+  *mean = win->sum / win->count;
+
+  return CB_ENUM_NO_ERROR;
+} // circbuf_window_mean()
+
+cb_enum_t circbuf_window_percentile(circbuf_window_t * win, double percent, double * value)
+{
+  double rank;
+  double seen = 0;
+  double min;
+  double max;
+  uint32_t i;
+
+  // Check for null pointers
+  CB_CHECK_NULL(win);
+  CB_CHECK_NULL(value);
+
+  // Make sure there is something to answer from
+  if (win->histogram == NULL)
+  {
+    return CB_ENUM_FAILURE;
+  }
+  if (!(percent >= 0 && percent <= 100))
+  {
+    return CB_ENUM_BAD_INDEX;
+  }
+  if (win->count == 0)
+  {
+    return CB_ENUM_EMPTY;
+  }
+
+  // The ends are known exactly
+  circbuf_window_min(win, &min);
+  circbuf_window_max(win, &max);
+  if (percent == 0 || percent == 100)
+  {
+    *value = (percent == 0) ? min : max;
+    return CB_ENUM_NO_ERROR;
+  }
+
+  // Find the bucket holding the rank then place the value inside it by how
+  // far into the bucket the rank is
+  rank = percent / 100 * win->count;
+  for (i = 0; i < win->buckets - 1; i++)
+  {
+    if (seen + win->histogram[i] >= rank && win->histogram[i] != 0)
+    {
+      break;
+    }
+    seen += win->histogram[i];
+  }
+  *value = win->low + win->width * i;
+  if (win->histogram[i] != 0)
+  {
+    *value += win->width * (rank - seen) / win->histogram[i];
+  }
+
+  // End buckets also hold out of range samples, the exact min and max keep
+  // the answer inside the window
+  if (*value < min)
+  {
+    *value = min;
+  }
+  if (*value > max)
+  {
+    *value = max;
+  }
+
+  return CB_ENUM_NO_ERROR;
+} // circbuf_window_percentile()
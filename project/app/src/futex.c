@@ -0,0 +1,42 @@
+/** @file futex.c
+*
+* @brief Thin wrappers around the futex system call
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <errno.h>
+#include <linux/futex.h>
+#include <stdint.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "futex.h"
+
+int32_t futex_wait(uint32_t * addr,
+                   uint32_t val,
+                   const struct timespec * timeout,
+                   uint8_t shared)
+{
+  int32_t op = shared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE;
+  int32_t ret;
+
+  // Interrupted or spurious returns are treated as a wake up, callers
+  // always recheck their condition
+  ret = syscall(SYS_futex, addr, op, val, timeout, NULL, 0);
+  if (ret < 0 && errno != ETIMEDOUT)
+  {
+    ret = 0;
+  }
+
+  return ret;
+} // futex_wait()
+
+int32_t futex_wake(uint32_t * addr, uint32_t count, uint8_t shared)
+{
+  int32_t op = shared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE;
+
+  return syscall(SYS_futex, addr, op, count, NULL, NULL, 0);
+} // futex_wake()
@@ -20,54 +20,138 @@ struct node
   void * data;
 };
 
-ll_enum_t ll_init(node_t ** head)
+// Levels of pending runs kept by ll_sort, enough for any int32_t count
+#define LL_SORT_LEVELS (32)
+
+// Block of nodes handed out by a list's node pool
+typedef struct ll_slab
 {
-  FUNC_ENTRY;
+  struct ll_slab * next;
+  node_t nodes[];
+} ll_slab_t;
 
-  LL_CHECK_NULL(head);
+// List header, head is the first member so the node_t pointer handed to
+// users is also a pointer to the list
+typedef struct list
+{
+  node_t head;
+  node_t * tail;
+  int32_t count;
+  uint32_t slab_nodes;
+  ll_slab_t * slabs;
+  node_t * free_nodes;
+} list_t;
+
+/*
+ * \brief ll_node_alloc: gets a node from the list's pool, adding a slab
+ *                       when the free list is empty, or from malloc when the
+ *                       list has no pool
+ *
+ * \param list: pointer to the list
+ * \return: the node or NULL if allocation failed
+ *
+ */
+static node_t * ll_node_alloc(list_t * list)
+{
+  node_t * node;
+  ll_slab_t * slab;
 
-  // Alloc a new head
-  if ((*head = malloc(sizeof(node_t))) == NULL)
+  // No pool, every node comes from the heap
+  if (list->slab_nodes == 0)
   {
-    return LL_ENUM_ALLOC_FAILURE;
+    return malloc(sizeof(node_t));
   }
 
-  // Memset head
-  memset(*head, 0, sizeof(**head));
+  // Carve a new slab into the free list
+  if (list->free_nodes == NULL)
+  {
+    if ((slab = malloc(sizeof(*slab) + list->slab_nodes * sizeof(node_t))) == NULL)
+    {
+      return NULL;
+    }
+    slab->next = list->slabs;
+    list->slabs = slab;
+    for (uint32_t i = 0; i < list->slab_nodes; i++)
+    {
+      slab->nodes[i].next = list->free_nodes;
+      list->free_nodes = &slab->nodes[i];
+    }
+  }
 
-  return  LL_ENUM_NO_ERROR;
-} // ll_init()
+  // Pop the first free node
+  node = list->free_nodes;
+  list->free_nodes = node->next;
+  return node;
+} // ll_node_alloc()
 
-ll_enum_t ll_insert(node_t * head, void * data, int32_t index)
+/*
+ * \brief ll_node_free: returns a node to the list's pool or to the heap
+ *
+ * \param list: pointer to the list
+ * \param node: node to release
+ *
+ */
+static void ll_node_free(list_t * list, node_t * node)
 {
-  FUNC_ENTRY;
+  if (list->slab_nodes == 0)
+  {
+    free(node);
+    return;
+  }
 
-  LL_CHECK_NULL(head);
-  LL_CHECK_NULL(data);
+  // Push onto the free list, slabs are only released on destroy
+  node->next = list->free_nodes;
+  list->free_nodes = node;
+} // ll_node_free()
 
-  node_t * current = head;
-  node_t * new = NULL;
-  volatile int32_t count = 0;
+/*
+ * \brief ll_node_at: finds the node at a position, walking from whichever
+ *                    end of the list is closer
+ *
+ * \param list: pointer to the list
+ * \param position: position of the node, 0 to count - 1
+ * \return: the node
+ *
+ */
+static node_t * ll_node_at(list_t * list, int32_t position)
+{
+  node_t * current;
 
-  // Look for index of end of list
-  while (current->next != NULL)
+  // Walk forward from the first node
+  if (position < list->count / 2)
   {
-    current = current->next;
-    if (count != INSERT_AT_END && count == index)
+    current = list->head.next;
+    while (position-- > 0)
     {
-      break;
+      current = current->next;
     }
-    count++;
+    return current;
   }
 
-  // Couldn't find index
-  if (index != INSERT_AT_END && count != index)
+  // Walk backward from the tail
+  current = list->tail;
+  for (int32_t i = list->count - 1; i > position; i--)
   {
-    return LL_ENUM_INDEX_TOO_LARGE;
+    current = current->prev;
   }
+  return current;
+} // ll_node_at()
+
+/*
+ * \brief ll_link_after: creates a node for data and links it after current
+ *
+ * \param list: pointer to the list
+ * \param current: node the new node goes after, may be the head
+ * \param data: pointer to data for the new node
+ * \return: success or error
+ *
+ */
+static ll_enum_t ll_link_after(list_t * list, node_t * current, void * data)
+{
+  node_t * new;
 
   // Create a new node
-  if ((new = malloc(sizeof(*new))) == NULL)
+  if ((new = ll_node_alloc(list)) == NULL)
   {
     return LL_ENUM_ALLOC_FAILURE;
   }
@@ -82,47 +166,354 @@ ll_enum_t ll_insert(node_t * head, void * data, int32_t index)
   {
     new->next->prev = new;
   }
+  else
+  {
+    list->tail = new;
+  }
+  list->count++;
+
+  return LL_ENUM_NO_ERROR;
+} // ll_link_after()
+
+/*
+ * \brief ll_unlink: unlinks a node and releases it
+ *
+ * \param list: pointer to the list
+ * \param current: node to unlink, must not be the head
+ * \return: data held by the node
+ *
+ */
+static void * ll_unlink(list_t * list, node_t * current)
+{
+  void * data = current->data;
+
+  current->prev->next = current->next;
+  if (current->next != NULL)
+  {
+    current->next->prev = current->prev;
+  }
+  else
+  {
+    list->tail = current->prev;
+  }
+  list->count--;
+
+  // Free the current node
+  ll_node_free(list, current);
+  return data;
+} // ll_unlink()
+
+/*
+ * \brief ll_merge_chains: merges two sorted NULL terminated chains onto the
+ *                         end of tail, only next links are set
+ *
+ * \param first: chain taken from first when items are equal
+ * \param second: the other chain
+ * \param less: comparison function returning 1 when data1 sorts before
+ *              data2
+ * \param tail: node the merged chain is linked after
+ * \return: last node of the merged chain
+ *
+ */
+static node_t * ll_merge_chains(node_t * first,
+                                node_t * second,
+                                COMPAREFUNC less,
+                                node_t * tail)
+{
+  // Only take from second when it sorts strictly before, for stability
+  while (first != NULL && second != NULL)
+  {
+    if (less(second->data, first->data))
+    {
+      tail->next = second;
+      second = second->next;
+    }
+    else
+    {
+      tail->next = first;
+      first = first->next;
+    }
+    tail = tail->next;
+  }
+
+  // Append whichever chain is left
+  tail->next = first != NULL ? first : second;
+  while (tail->next != NULL)
+  {
+    tail = tail->next;
+  }
+  return tail;
+} // ll_merge_chains()
+
+/*
+ * \brief ll_relink: sets the prev links and tail from the next links
+ *
+ * \param list: pointer to the list
+ *
+ */
+static void ll_relink(list_t * list)
+{
+  node_t * prev = &list->head;
+
+  for (node_t * current = list->head.next; current != NULL; current = current->next)
+  {
+    current->prev = prev;
+    prev = current;
+  }
+  list->tail = prev;
+} // ll_relink()
+
+/*
+ * \brief ll_chain_alloc: gets count nodes for a list linked into a NULL
+ *                        terminated chain, next and prev are set inside the
+ *                        chain
+ *
+ * \param list: list the nodes will belong to
+ * \param count: number of nodes, at least 1
+ * \param last: last node of the chain
+ * \return: first node of the chain, NULL if allocation failed in which
+ *          case nothing is kept
+ *
+ */
+static node_t * ll_chain_alloc(list_t * list, int32_t count, node_t ** last)
+{
+  node_t * first = NULL;
+  node_t * node;
+
+  // Build from the back so each node goes on the front
+  for (int32_t i = 0; i < count; i++)
+  {
+    if ((node = ll_node_alloc(list)) == NULL)
+    {
+      while (first != NULL)
+      {
+        node = first->next;
+        ll_node_free(list, first);
+        first = node;
+      }
+      return NULL;
+    }
+    node->next = first;
+    if (first != NULL)
+    {
+      first->prev = node;
+    }
+    else
+    {
+      *last = node;
+    }
+    first = node;
+  }
+  return first;
+} // ll_chain_alloc()
+
+/*
+ * \brief ll_link_chain: links a chain of nodes owned by list after current
+ *
+ * \param list: pointer to the list
+ * \param current: node the chain goes after, may be the head
+ * \param first: first node of the chain
+ * \param last: last node of the chain
+ * \param count: number of nodes in the chain
+ *
+ */
+static void ll_link_chain(list_t * list,
+                          node_t * current,
+                          node_t * first,
+                          node_t * last,
+                          int32_t count)
+{
+  first->prev = current;
+  last->next = current->next;
+  if (last->next != NULL)
+  {
+    last->next->prev = last;
+  }
+  else
+  {
+    list->tail = last;
+  }
+  current->next = first;
+  list->count += count;
+} // ll_link_chain()
+
+/*
+ * \brief ll_adopt: takes a range of nodes off other as a chain of nodes
+ *                  owned by list.  Heap nodes move as they are in O(1),
+ *                  nodes from or for a pool are swapped for nodes from the
+ *                  right allocator.
+ *
+ * \param list: list the chain will belong to
+ * \param other: list the range is taken from
+ * \param first: first node of the range
+ * \param last: last node of the range
+ * \param count: number of nodes in the range, at least 1
+ * \param chain_last: last node of the chain
+ * \return: first node of the NULL terminated chain, NULL if allocation
+ *          failed in which case both lists are unchanged
+ *
+ */
+static node_t * ll_adopt(list_t * list,
+                         list_t * other,
+                         node_t * first,
+                         node_t * last,
+                         int32_t count,
+                         node_t ** chain_last)
+{
+  node_t * chain = first;
+  node_t * node;
+  node_t * next;
+
+  // Get every new node before touching other
+  if ((list->slab_nodes != 0 || other->slab_nodes != 0) &&
+      (chain = ll_chain_alloc(list, count, chain_last)) == NULL)
+  {
+    return NULL;
+  }
+
+  // Unlink the range from other
+  first->prev->next = last->next;
+  if (last->next != NULL)
+  {
+    last->next->prev = first->prev;
+  }
+  else
+  {
+    other->tail = first->prev;
+  }
+  other->count -= count;
+  last->next = NULL;
+
+  // Heap nodes are the chain
+  if (chain == first)
+  {
+    *chain_last = last;
+    return chain;
+  }
+
+  // Move the data across and give the old nodes back to other
+  node = chain;
+  while (first != NULL)
+  {
+    next = first->next;
+    node->data = first->data;
+    ll_node_free(other, first);
+    node = node->next;
+    first = next;
+  }
+  return chain;
+} // ll_adopt()
+
+ll_enum_t ll_init(node_t ** head)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(head);
+
+  list_t * list;
+
+  // Alloc a new list
+  if ((list = malloc(sizeof(*list))) == NULL)
+  {
+    return LL_ENUM_ALLOC_FAILURE;
+  }
+
+  // Memset list, an empty list's tail is the head
+  memset(list, 0, sizeof(*list));
+  list->tail = &list->head;
+  *head = &list->head;
 
   return  LL_ENUM_NO_ERROR;
-} // ll_insert()
+} // ll_init()
 
-ll_enum_t ll_remove(node_t * head, void ** data, int32_t index)
+ll_enum_t ll_init_pool(node_t ** head, uint32_t slab_nodes)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(head);
+
+  ll_enum_t res;
+
+  // A slab must hold at least one node
+  if (slab_nodes == 0)
+  {
+    return LL_ENUM_FAILURE;
+  }
+
+  // Create the list then turn on the pool
+  if ((res = ll_init(head)) != LL_ENUM_NO_ERROR)
+  {
+    return res;
+  }
+  ((list_t *)*head)->slab_nodes = slab_nodes;
+
+  return  LL_ENUM_NO_ERROR;
+} // ll_init_pool()
+
+ll_enum_t ll_insert(node_t * head, void * data, int32_t index)
 {
   FUNC_ENTRY;
 
   LL_CHECK_NULL(head);
   LL_CHECK_NULL(data);
 
-  node_t * current = head;
-  int32_t count = -1;
+  list_t * list = (list_t *)head;
+  node_t * current;
+  int32_t position = index;
 
-  // Look for index
-  while (current->next != NULL)
+  // Negative indices count back from the end, -1 appends
+  if (position < 0)
   {
-    if (count != REMOVE_AT_END && count == index)
-    {
-      break;
-    }
-    current = current->next;
-    count++;
+    position += list->count + 1;
   }
 
   // Couldn't find index
-  if (index != REMOVE_AT_END && count != index)
+  if (position < 0 || position > list->count)
   {
     return LL_ENUM_INDEX_TOO_LARGE;
   }
 
-  // Node was found, remove and set data pointer
-  *data = current->data;
-  current->prev->next = current->next;
-  if (current->next != NULL)
+  // Find the node the new node goes after
+  if (position == list->count)
   {
-    current->next->prev = current->prev;
+    current = list->tail;
+  }
+  else if (position == 0)
+  {
+    current = head;
+  }
+  else
+  {
+    current = ll_node_at(list, position - 1);
   }
 
-  // Free the current node
-  free(current);
+  return ll_link_after(list, current, data);
+} // ll_insert()
+
+ll_enum_t ll_remove(node_t * head, void ** data, int32_t index)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(head);
+  LL_CHECK_NULL(data);
+
+  list_t * list = (list_t *)head;
+  int32_t position = index;
+
+  // Negative indices count back from the end, -1 is the last node
+  if (position < 0)
+  {
+    position += list->count;
+  }
+
+  // Couldn't find index
+  if (position < 0 || position >= list->count)
+  {
+    return LL_ENUM_INDEX_TOO_LARGE;
+  }
+
+  // Node was found, remove and set data pointer
+  *data = ll_unlink(list, ll_node_at(list, position));
 
   return  LL_ENUM_NO_ERROR;
 } // ll_remove()
@@ -154,25 +545,447 @@ ll_enum_t ll_search(node_t * head, void * data, COMPAREFUNC func, int32_t * inde
   return LL_DATA_NOT_FOUND;
 } // ll_search()
 
-ll_enum_t ll_size(node_t * head, int32_t * size)
+ll_enum_t ll_search_cursor(node_t * head, void * data, COMPAREFUNC func, ll_cursor_t * cursor)
 {
   FUNC_ENTRY;
 
   LL_CHECK_NULL(head);
-  LL_CHECK_NULL(size);
+  LL_CHECK_NULL(data);
+  LL_CHECK_NULL(func);
+  LL_CHECK_NULL(cursor);
 
-  node_t * current = head;
-  uint32_t count = 0;
+  node_t * current = head->next;
+  int32_t count = 0;
 
-  // Loop until the end is found
-  while(current->next != NULL)
+  // Look through node using compare function to find data
+  while (current != NULL)
   {
+    if (func(data, current->data))
+    {
+      // Data was found leave the cursor on it
+      cursor->head = head;
+      cursor->node = current;
+      cursor->index = count;
+      return  LL_ENUM_NO_ERROR;
+    }
     current = current->next;
     count++;
   }
+  return LL_DATA_NOT_FOUND;
+} // ll_search_cursor()
+
+ll_enum_t ll_cursor_first(node_t * head, ll_cursor_t * cursor)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(head);
+  LL_CHECK_NULL(cursor);
 
-  // Set size
-  *size = count;
+  // An empty list leaves the cursor at the end
+  cursor->head = head;
+  cursor->node = head->next;
+  cursor->index = 0;
+  return  LL_ENUM_NO_ERROR;
+} // ll_cursor_first()
+
+ll_enum_t ll_cursor_last(node_t * head, ll_cursor_t * cursor)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(head);
+  LL_CHECK_NULL(cursor);
+
+  // Step back from the end onto the last node
+  cursor->head = head;
+  cursor->node = NULL;
+  return ll_cursor_prev(cursor);
+} // ll_cursor_last()
+
+ll_enum_t ll_cursor_next(ll_cursor_t * cursor)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(cursor);
+  LL_CHECK_NULL(cursor->head);
+
+  // The end wraps around to the first node
+  if (cursor->node == NULL)
+  {
+    cursor->node = cursor->head->next;
+    cursor->index = 0;
+  }
+  else
+  {
+    cursor->node = cursor->node->next;
+    cursor->index++;
+  }
+  return  LL_ENUM_NO_ERROR;
+} // ll_cursor_next()
+
+ll_enum_t ll_cursor_prev(ll_cursor_t * cursor)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(cursor);
+  LL_CHECK_NULL(cursor->head);
+
+  list_t * list = (list_t *)cursor->head;
+
+  // The end wraps around to the last node and the first node steps to the
+  // end, the head stands in for the end while moving
+  if (cursor->node == NULL)
+  {
+    cursor->node = list->tail;
+    cursor->index = list->count - 1;
+  }
+  else
+  {
+    cursor->node = cursor->node->prev;
+    cursor->index--;
+  }
+  if (cursor->node == cursor->head)
+  {
+    cursor->node = NULL;
+    cursor->index = list->count;
+  }
+  return  LL_ENUM_NO_ERROR;
+} // ll_cursor_prev()
+
+ll_enum_t ll_cursor_get(ll_cursor_t * cursor, void ** data)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(cursor);
+  LL_CHECK_NULL(data);
+
+  // Nothing to get at the end
+  if (cursor->node == NULL)
+  {
+    return LL_ENUM_INDEX_NON_EXISTENT;
+  }
+  *data = cursor->node->data;
+  return  LL_ENUM_NO_ERROR;
+} // ll_cursor_get()
+
+ll_enum_t ll_cursor_index(ll_cursor_t * cursor, int32_t * index)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(cursor);
+  LL_CHECK_NULL(index);
+
+  *index = cursor->index;
+  return  LL_ENUM_NO_ERROR;
+} // ll_cursor_index()
+
+ll_enum_t ll_cursor_insert_before(ll_cursor_t * cursor, void * data)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(cursor);
+  LL_CHECK_NULL(cursor->head);
+  LL_CHECK_NULL(data);
+
+  list_t * list = (list_t *)cursor->head;
+  node_t * current = cursor->node == NULL ? list->tail : cursor->node->prev;
+  ll_enum_t res;
+
+  // The cursor stays on its node which moves up one index
+  if ((res = ll_link_after(list, current, data)) == LL_ENUM_NO_ERROR)
+  {
+    cursor->index++;
+  }
+  return res;
+} // ll_cursor_insert_before()
+
+ll_enum_t ll_cursor_insert_after(ll_cursor_t * cursor, void * data)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(cursor);
+  LL_CHECK_NULL(cursor->head);
+  LL_CHECK_NULL(data);
+
+  node_t * current = cursor->node == NULL ? cursor->head : cursor->node;
+  ll_enum_t res;
+
+  // After the end is the front of the list which pushes the end back
+  res = ll_link_after((list_t *)cursor->head, current, data);
+  if (res == LL_ENUM_NO_ERROR && cursor->node == NULL)
+  {
+    cursor->index++;
+  }
+  return res;
+} // ll_cursor_insert_after()
+
+ll_enum_t ll_cursor_remove(ll_cursor_t * cursor, void ** data)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(cursor);
+  LL_CHECK_NULL(cursor->head);
+  LL_CHECK_NULL(data);
+
+  node_t * next;
+
+  // Nothing to remove at the end
+  if (cursor->node == NULL)
+  {
+    return LL_ENUM_INDEX_NON_EXISTENT;
+  }
+
+  // The cursor moves to the next node which takes over the index
+  next = cursor->node->next;
+  *data = ll_unlink((list_t *)cursor->head, cursor->node);
+  cursor->node = next;
+  return  LL_ENUM_NO_ERROR;
+} // ll_cursor_remove()
+
+ll_enum_t ll_sort(node_t * head, COMPAREFUNC less)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(head);
+  LL_CHECK_NULL(less);
+
+  node_t * pending[LL_SORT_LEVELS] = {NULL};
+  node_t * current = head->next;
+  node_t * carry;
+  node_t sorted;
+  uint32_t level;
+
+  // Take nodes off the front one at a time.  pending[i] holds a sorted run
+  // of 2^i nodes, a new node carries up through the full levels like a
+  // binary counter so equal sized runs are merged while still in cache.
+  while (current != NULL)
+  {
+    carry = current;
+    current = current->next;
+    carry->next = NULL;
+    for (level = 0; level < LL_SORT_LEVELS - 1 && pending[level] != NULL; level++)
+    {
+      // The pending run came first in the list, it wins ties
+      ll_merge_chains(pending[level], carry, less, &sorted);
+      carry = sorted.next;
+      pending[level] = NULL;
+    }
+    if (pending[level] != NULL)
+    {
+      ll_merge_chains(pending[level], carry, less, &sorted);
+      carry = sorted.next;
+    }
+    pending[level] = carry;
+  }
+
+  // Merge the runs left over, higher levels hold earlier nodes
+  carry = NULL;
+  for (level = 0; level < LL_SORT_LEVELS; level++)
+  {
+    if (pending[level] != NULL)
+    {
+      ll_merge_chains(pending[level], carry, less, &sorted);
+      carry = sorted.next;
+    }
+  }
+  head->next = carry;
+
+  ll_relink((list_t *)head);
+  return  LL_ENUM_NO_ERROR;
+} // ll_sort()
+
+ll_enum_t ll_merge(node_t * head, node_t * other, COMPAREFUNC less)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(head);
+  LL_CHECK_NULL(other);
+  LL_CHECK_NULL(less);
+
+  list_t * list = (list_t *)head;
+  list_t * from = (list_t *)other;
+  int32_t count = from->count;
+  node_t * chain;
+  node_t * last;
+
+  // Merging a list into itself would lose it
+  if (head == other)
+  {
+    return LL_ENUM_FAILURE;
+  }
+  if (count == 0)
+  {
+    return  LL_ENUM_NO_ERROR;
+  }
+
+  if ((chain = ll_adopt(list, from, other->next, from->tail, count, &last)) == NULL)
+  {
+    return LL_ENUM_ALLOC_FAILURE;
+  }
+
+  // One merge pass over both lists
+  ll_merge_chains(head->next, chain, less, head);
+  list->count += count;
+  ll_relink(list);
+  return  LL_ENUM_NO_ERROR;
+} // ll_merge()
+
+ll_enum_t ll_from_array(node_t * head, void ** data, int32_t count, int32_t index)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(head);
+  LL_CHECK_NULL(data);
+
+  list_t * list = (list_t *)head;
+  int32_t position = index;
+  node_t * first;
+  node_t * last;
+  node_t * node;
+
+  // Negative indices count back from the end, -1 appends
+  if (position < 0)
+  {
+    position += list->count + 1;
+  }
+
+  // Couldn't find index
+  if (position < 0 || position > list->count || count < 0)
+  {
+    return LL_ENUM_INDEX_TOO_LARGE;
+  }
+  if (count == 0)
+  {
+    return  LL_ENUM_NO_ERROR;
+  }
+
+  // Every node is allocated before the list is touched
+  for (int32_t i = 0; i < count; i++)
+  {
+    LL_CHECK_NULL(data[i]);
+  }
+  if ((first = ll_chain_alloc(list, count, &last)) == NULL)
+  {
+    return LL_ENUM_ALLOC_FAILURE;
+  }
+  node = first;
+  for (int32_t i = 0; i < count; i++)
+  {
+    node->data = data[i];
+    node = node->next;
+  }
+
+  // One walk to the insert point from the closer end
+  ll_link_chain(list,
+                position == 0 ? head : ll_node_at(list, position - 1),
+                first,
+                last,
+                count);
+  return  LL_ENUM_NO_ERROR;
+} // ll_from_array()
+
+ll_enum_t ll_to_array(node_t * head, void ** data, int32_t length, int32_t * count)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(head);
+  LL_CHECK_NULL(data);
+  LL_CHECK_NULL(count);
+
+  list_t * list = (list_t *)head;
+  node_t * current = head->next;
+  node_t * next;
+
+  // Move data off the front until the list or the buffer runs out
+  *count = 0;
+  while (current != NULL && *count < length)
+  {
+    next = current->next;
+    data[*count] = current->data;
+    ll_node_free(list, current);
+    (*count)++;
+    current = next;
+  }
+
+  // Whatever is left starts at current
+  head->next = current;
+  list->count -= *count;
+  if (current != NULL)
+  {
+    current->prev = head;
+  }
+  else
+  {
+    list->tail = head;
+  }
+  return  LL_ENUM_NO_ERROR;
+} // ll_to_array()
+
+ll_enum_t ll_splice(node_t * head, int32_t index, node_t * other, int32_t first, int32_t count)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(head);
+  LL_CHECK_NULL(other);
+
+  list_t * list = (list_t *)head;
+  list_t * from = (list_t *)other;
+  int32_t position = index;
+  int32_t start = first;
+  node_t * current;
+  node_t * chain;
+  node_t * last;
+
+  // Moving inside one list is not supported
+  if (head == other)
+  {
+    return LL_ENUM_FAILURE;
+  }
+
+  // Negative indices count back from the end as for insert and remove
+  if (position < 0)
+  {
+    position += list->count + 1;
+  }
+  if (start < 0)
+  {
+    start += from->count;
+  }
+
+  // Couldn't find index or the range runs off the end, compared against
+  // what is left after start so a huge count can not overflow
+  if (position < 0 || position > list->count ||
+      start < 0 || start > from->count || count < 0 || count > from->count - start)
+  {
+    return LL_ENUM_INDEX_TOO_LARGE;
+  }
+  if (count == 0)
+  {
+    return  LL_ENUM_NO_ERROR;
+  }
+
+  // Find both ends of the range and the insert point, each from its closer
+  // end so a whole list moved to either end of another takes no walk
+  current = position == 0 ? head : ll_node_at(list, position - 1);
+  chain = ll_node_at(from, start);
+  last = ll_node_at(from, start + count - 1);
+  if ((chain = ll_adopt(list, from, chain, last, count, &last)) == NULL)
+  {
+    return LL_ENUM_ALLOC_FAILURE;
+  }
+
+  ll_link_chain(list, current, chain, last, count);
+  return  LL_ENUM_NO_ERROR;
+} // ll_splice()
+
+ll_enum_t ll_size(node_t * head, int32_t * size)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(head);
+  LL_CHECK_NULL(size);
+
+  // The header keeps the count
+  *size = ((list_t *)head)->count;
   return  LL_ENUM_NO_ERROR;
 } // ll_size()
 
@@ -202,19 +1015,32 @@ ll_enum_t ll_destroy(node_t * head)
 
   LL_CHECK_NULL(head);
 
-  node_t * current = head;
-  uint32_t count = 0;
+  list_t * list = (list_t *)head;
+  node_t * current = head->next;
+  node_t * next;
+  ll_slab_t * slab;
 
-  // Loop over list freeing data and nodes
-  while(current->next != NULL)
+  // Loop over list freeing data, nodes are freed one by one without a pool
+  while(current != NULL)
   {
-    current = current->next;
+    next = current->next;
     free(current->data);
-    free(current->prev);
-    count++;
+    if (list->slab_nodes == 0)
+    {
+      free(current);
+    }
+    current = next;
+  }
+
+  // Release the pool a whole slab at a time
+  while (list->slabs != NULL)
+  {
+    slab = list->slabs;
+    list->slabs = slab->next;
+    free(slab);
   }
 
-  // Free the last node
-  free(current);
+  // Free the list
+  free(list);
   return  LL_ENUM_NO_ERROR;
 } // ll_destroy()
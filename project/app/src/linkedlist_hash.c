@@ -0,0 +1,334 @@
+/** @file linkedlist_hash.c
+*
+* @brief Implementation of linked list with a hash index.  Items live on an
+*        intrusive list for order and on a chained hash table for keys.
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "linkedlist_hash.h"
+#include "linkedlist_intrusive.h"
+#include "log.h"
+
+// Buckets in a new index, always a power of two
+#define LL_HASH_MIN_BUCKETS (16)
+
+// Item on the list and in one hash chain
+typedef struct entry
+{
+  ll_link_t link;
+  struct entry * chain;
+  uint32_t hash;
+  void * data;
+} entry_t;
+
+// Hash indexed list structure
+struct ll_hash
+{
+  ll_intrusive_t order;
+  entry_t ** buckets;
+  uint32_t mask;
+  HASHFUNC hash;
+  COMPAREFUNC equal;
+};
+
+/*
+ * \brief ll_hash_find: finds the chain slot pointing at the entry with a key
+ *
+ * \param list: pointer to the list
+ * \param key: key passed to the equal function
+ * \param hash: hash of the key
+ * \return: slot pointing at the entry, the slot points at NULL if not found
+ *
+ */
+static entry_t ** ll_hash_find(ll_hash_t * list, void * key, uint32_t hash)
+{
+  entry_t ** slot = &list->buckets[hash & list->mask];
+
+  // The stored hash skips most calls to equal
+  while (*slot != NULL &&
+         ((*slot)->hash != hash || !list->equal(key, (*slot)->data)))
+  {
+    slot = &(*slot)->chain;
+  }
+  return slot;
+} // ll_hash_find()
+
+/*
+ * \brief ll_hash_grow: doubles the buckets and rehashes every entry from the
+ *                      stored hashes
+ *
+ * \param list: pointer to the list
+ * \return: success or error
+ *
+ */
+static ll_enum_t ll_hash_grow(ll_hash_t * list)
+{
+  uint32_t length = (list->mask + 1) * 2;
+  entry_t ** buckets;
+  entry_t * entry;
+
+  if ((buckets = calloc(length, sizeof(*buckets))) == NULL)
+  {
+    return LL_ENUM_ALLOC_FAILURE;
+  }
+
+  // Chain every entry into the new buckets
+  for (ll_link_t * current = list->order.head.next;
+       current != &list->order.head;
+       current = current->next)
+  {
+    entry = LL_CONTAINER_OF(current, entry_t, link);
+    entry->chain = buckets[entry->hash & (length - 1)];
+    buckets[entry->hash & (length - 1)] = entry;
+  }
+
+  free(list->buckets);
+  list->buckets = buckets;
+  list->mask = length - 1;
+  return LL_ENUM_NO_ERROR;
+} // ll_hash_grow()
+
+/*
+ * \brief ll_hash_unchain: takes an entry out of its hash chain
+ *
+ * \param list: pointer to the list
+ * \param entry: entry to take out
+ * \return: data held by the entry
+ *
+ */
+static void * ll_hash_unchain(ll_hash_t * list, entry_t * entry)
+{
+  entry_t ** slot = &list->buckets[entry->hash & list->mask];
+
+  // Find the chain slot by identity so equal is not called
+  while (*slot != entry)
+  {
+    slot = &(*slot)->chain;
+  }
+  *slot = entry->chain;
+  return entry->data;
+} // ll_hash_unchain()
+
+ll_enum_t ll_hash_init(ll_hash_t ** list, HASHFUNC hash, COMPAREFUNC equal)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(hash);
+  LL_CHECK_NULL(equal);
+
+  // Alloc a new list and its buckets
+  if ((*list = malloc(sizeof(**list))) == NULL)
+  {
+    return LL_ENUM_ALLOC_FAILURE;
+  }
+  if (((*list)->buckets = calloc(LL_HASH_MIN_BUCKETS, sizeof(entry_t *))) == NULL)
+  {
+    free(*list);
+    *list = NULL;
+    return LL_ENUM_ALLOC_FAILURE;
+  }
+  (*list)->mask = LL_HASH_MIN_BUCKETS - 1;
+  (*list)->hash = hash;
+  (*list)->equal = equal;
+
+  return ll_intrusive_init(&(*list)->order, offsetof(entry_t, link));
+} // ll_hash_init()
+
+ll_enum_t ll_hash_destroy(ll_hash_t * list)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+
+  ll_link_t * current = list->order.head.next;
+  entry_t * entry;
+
+  // Loop over list freeing data and entries
+  while (current != &list->order.head)
+  {
+    entry = LL_CONTAINER_OF(current, entry_t, link);
+    current = current->next;
+    free(entry->data);
+    free(entry);
+  }
+
+  free(list->buckets);
+  free(list);
+  return LL_ENUM_NO_ERROR;
+} // ll_hash_destroy()
+
+ll_enum_t ll_hash_insert(ll_hash_t * list, void * data, int32_t index)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(data);
+
+  uint32_t hash = list->hash(data);
+  entry_t ** slot;
+  entry_t * entry;
+  ll_enum_t res;
+
+  // Keys are unique
+  slot = ll_hash_find(list, data, hash);
+  if (*slot != NULL)
+  {
+    return LL_ENUM_FAILURE;
+  }
+
+  // Create the entry and put it on the list at index
+  if ((entry = malloc(sizeof(*entry))) == NULL)
+  {
+    return LL_ENUM_ALLOC_FAILURE;
+  }
+  entry->hash = hash;
+  entry->data = data;
+  entry->chain = NULL;
+  if ((res = ll_intrusive_insert(&list->order, entry, index)) != LL_ENUM_NO_ERROR)
+  {
+    free(entry);
+    return res;
+  }
+
+  // The end of the chain is still where find stopped
+  *slot = entry;
+
+  // Keep the load at most one entry per bucket, a failed grow only makes
+  // chains longer
+  if ((uint32_t)list->order.count > list->mask + 1)
+  {
+    ll_hash_grow(list);
+  }
+
+  return LL_ENUM_NO_ERROR;
+} // ll_hash_insert()
+
+ll_enum_t ll_hash_remove(ll_hash_t * list, void ** data, int32_t index)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(data);
+
+  void * entry;
+  ll_enum_t res;
+
+  // Take the entry off the list by index, then out of the index
+  if ((res = ll_intrusive_remove(&list->order, &entry, index)) != LL_ENUM_NO_ERROR)
+  {
+    return res;
+  }
+  *data = ll_hash_unchain(list, entry);
+  free(entry);
+
+  return LL_ENUM_NO_ERROR;
+} // ll_hash_remove()
+
+ll_enum_t ll_hash_lookup(ll_hash_t * list, void * key, void ** data)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(key);
+  LL_CHECK_NULL(data);
+
+  entry_t * entry = *ll_hash_find(list, key, list->hash(key));
+
+  if (entry == NULL)
+  {
+    return LL_DATA_NOT_FOUND;
+  }
+  *data = entry->data;
+  return LL_ENUM_NO_ERROR;
+} // ll_hash_lookup()
+
+ll_enum_t ll_hash_remove_key(ll_hash_t * list, void * key, void ** data)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(key);
+  LL_CHECK_NULL(data);
+
+  entry_t * entry = *ll_hash_find(list, key, list->hash(key));
+
+  if (entry == NULL)
+  {
+    return LL_DATA_NOT_FOUND;
+  }
+  *data = ll_hash_unchain(list, entry);
+  ll_intrusive_unlink(&list->order, entry);
+  free(entry);
+  return LL_ENUM_NO_ERROR;
+} // ll_hash_remove_key()
+
+ll_enum_t ll_hash_search(ll_hash_t * list,
+                         void * data,
+                         COMPAREFUNC func,
+                         int32_t * index)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(data);
+  LL_CHECK_NULL(func);
+  LL_CHECK_NULL(index);
+
+  entry_t * entry;
+  int32_t count = 0;
+
+  // Look through the list using compare function to find data
+  for (ll_link_t * current = list->order.head.next;
+       current != &list->order.head;
+       current = current->next)
+  {
+    entry = LL_CONTAINER_OF(current, entry_t, link);
+    if (func(data, entry->data))
+    {
+      *index = count;
+      return LL_ENUM_NO_ERROR;
+    }
+    count++;
+  }
+  return LL_DATA_NOT_FOUND;
+} // ll_hash_search()
+
+ll_enum_t ll_hash_dump(ll_hash_t * list, PRINTFUNC func)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(func);
+
+  entry_t * entry;
+  uint32_t count = 0;
+
+  // Loop over list calling the print function
+  for (ll_link_t * current = list->order.head.next;
+       current != &list->order.head;
+       current = current->next)
+  {
+    entry = LL_CONTAINER_OF(current, entry_t, link);
+    func(entry->data, count);
+    count++;
+  }
+  return LL_ENUM_NO_ERROR;
+} // ll_hash_dump()
+
+ll_enum_t ll_hash_size(ll_hash_t * list, int32_t * size)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(size);
+
+  *size = list->order.count;
+  return LL_ENUM_NO_ERROR;
+} // ll_hash_size()
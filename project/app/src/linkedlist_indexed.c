@@ -0,0 +1,459 @@
+/** @file linkedlist_indexed.c
+*
+* @brief Implementation of indexed sequence as a treap.  Nodes are ordered
+*        by position and each carries its subtree size, so the index of a
+*        node is the size of everything left of it.  Random priorities keep
+*        the tree heap ordered, which bounds the expected depth by O(log n)
+*        whatever order the indices arrive in.
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "linkedlist_indexed.h"
+#include "log.h"
+
+// Node in the tree, size counts the node and both subtrees
+typedef struct tree_node
+{
+  struct tree_node * left;
+  struct tree_node * right;
+  void * data;
+  int32_t size;
+  uint32_t priority;
+} tree_node_t;
+
+// Indexed sequence structure
+struct ll_indexed
+{
+  tree_node_t * root;
+  uint32_t seed;
+};
+
+/*
+ * \brief ll_indexed_size_of: gets the size of a subtree
+ *
+ * \param node: root of the subtree, may be NULL
+ * \return: number of nodes in the subtree
+ *
+ */
+static inline int32_t ll_indexed_size_of(tree_node_t * node)
+{
+  return node == NULL ? 0 : node->size;
+} // ll_indexed_size_of()
+
+/*
+ * \brief ll_indexed_resize: sets a node's size from its children
+ *
+ * \param node: node to update
+ *
+ */
+static inline void ll_indexed_resize(tree_node_t * node)
+{
+  node->size = 1 + ll_indexed_size_of(node->left) + ll_indexed_size_of(node->right);
+} // ll_indexed_resize()
+
+/*
+ * \brief ll_indexed_rotate_right: lifts a node's left child above it
+ *
+ * \param node: node to rotate down
+ * \return: the new root of the subtree
+ *
+ */
+static tree_node_t * ll_indexed_rotate_right(tree_node_t * node)
+{
+  tree_node_t * left = node->left;
+
+  node->left = left->right;
+  left->right = node;
+  ll_indexed_resize(node);
+  ll_indexed_resize(left);
+  return left;
+} // ll_indexed_rotate_right()
+
+/*
+ * \brief ll_indexed_rotate_left: lifts a node's right child above it
+ *
+ * \param node: node to rotate down
+ * \return: the new root of the subtree
+ *
+ */
+static tree_node_t * ll_indexed_rotate_left(tree_node_t * node)
+{
+  tree_node_t * right = node->right;
+
+  node->right = right->left;
+  right->left = node;
+  ll_indexed_resize(node);
+  ll_indexed_resize(right);
+  return right;
+} // ll_indexed_rotate_left()
+
+/*
+ * \brief ll_indexed_insert_at: puts a node at a position in a subtree then
+ *                              rotates it up while it outranks its parent
+ *
+ * \param node: root of the subtree, may be NULL
+ * \param insert: node to insert, its children are NULL and size is 1
+ * \param position: index the node will have in the subtree
+ * \return: the new root of the subtree
+ *
+ */
+static tree_node_t * ll_indexed_insert_at(tree_node_t * node,
+                                          tree_node_t * insert,
+                                          int32_t position)
+{
+  int32_t left_size;
+
+  if (node == NULL)
+  {
+    return insert;
+  }
+
+  // Go left when the position is inside or just after the left subtree
+  node->size++;
+  left_size = ll_indexed_size_of(node->left);
+  if (position <= left_size)
+  {
+    node->left = ll_indexed_insert_at(node->left, insert, position);
+    if (node->left->priority > node->priority)
+    {
+      node = ll_indexed_rotate_right(node);
+    }
+  }
+  else
+  {
+    node->right = ll_indexed_insert_at(node->right, insert, position - left_size - 1);
+    if (node->right->priority > node->priority)
+    {
+      node = ll_indexed_rotate_left(node);
+    }
+  }
+  return node;
+} // ll_indexed_insert_at()
+
+/*
+ * \brief ll_indexed_join: joins two subtrees where every node of the first
+ *                         comes before every node of the second
+ *
+ * \param first: subtree that comes first, may be NULL
+ * \param second: subtree that comes second, may be NULL
+ * \return: root of the joined subtree
+ *
+ */
+static tree_node_t * ll_indexed_join(tree_node_t * first, tree_node_t * second)
+{
+  if (first == NULL)
+  {
+    return second;
+  }
+  if (second == NULL)
+  {
+    return first;
+  }
+
+  // The higher priority root stays on top
+  if (first->priority > second->priority)
+  {
+    first->right = ll_indexed_join(first->right, second);
+    ll_indexed_resize(first);
+    return first;
+  }
+  second->left = ll_indexed_join(first, second->left);
+  ll_indexed_resize(second);
+  return second;
+} // ll_indexed_join()
+
+/*
+ * \brief ll_indexed_remove_at: takes the node at a position out of a subtree
+ *
+ * \param node: root of the subtree, holds position
+ * \param position: index of the node in the subtree
+ * \param removed: the node taken out
+ * \return: the new root of the subtree
+ *
+ */
+static tree_node_t * ll_indexed_remove_at(tree_node_t * node,
+                                          int32_t position,
+                                          tree_node_t ** removed)
+{
+  int32_t left_size = ll_indexed_size_of(node->left);
+
+  // Found it, its subtrees take its place
+  if (position == left_size)
+  {
+    *removed = node;
+    return ll_indexed_join(node->left, node->right);
+  }
+
+  node->size--;
+  if (position < left_size)
+  {
+    node->left = ll_indexed_remove_at(node->left, position, removed);
+  }
+  else
+  {
+    node->right = ll_indexed_remove_at(node->right, position - left_size - 1, removed);
+  }
+  return node;
+} // ll_indexed_remove_at()
+
+/*
+ * \brief ll_indexed_find: looks through a subtree in order for data
+ *
+ * \param node: root of the subtree, may be NULL
+ * \param data: pointer to data for comparison in compare func
+ * \param func: comparison function used to find data
+ * \param count: index of the subtree's first node, moved past every node
+ *               looked at
+ * \return: the first matching node or NULL
+ *
+ */
+static tree_node_t * ll_indexed_find(tree_node_t * node,
+                                     void * data,
+                                     COMPAREFUNC func,
+                                     int32_t * count)
+{
+  tree_node_t * found;
+
+  if (node == NULL)
+  {
+    return NULL;
+  }
+  if ((found = ll_indexed_find(node->left, data, func, count)) != NULL)
+  {
+    return found;
+  }
+  if (func(data, node->data))
+  {
+    return node;
+  }
+  (*count)++;
+  return ll_indexed_find(node->right, data, func, count);
+} // ll_indexed_find()
+
+/*
+ * \brief ll_indexed_print: calls the print function on a subtree in order
+ *
+ * \param node: root of the subtree, may be NULL
+ * \param func: print function used to print data
+ * \param count: index of the subtree's first node, moved past the subtree
+ *
+ */
+static void ll_indexed_print(tree_node_t * node, PRINTFUNC func, uint32_t * count)
+{
+  if (node == NULL)
+  {
+    return;
+  }
+  ll_indexed_print(node->left, func, count);
+  func(node->data, *count);
+  (*count)++;
+  ll_indexed_print(node->right, func, count);
+} // ll_indexed_print()
+
+/*
+ * \brief ll_indexed_free: frees a subtree's nodes and data
+ *
+ * \param node: root of the subtree, may be NULL
+ *
+ */
+static void ll_indexed_free(tree_node_t * node)
+{
+  if (node == NULL)
+  {
+    return;
+  }
+  ll_indexed_free(node->left);
+  ll_indexed_free(node->right);
+  free(node->data);
+  free(node);
+} // ll_indexed_free()
+
+ll_enum_t ll_indexed_init(ll_indexed_t ** list)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+
+  // Alloc a new list, the tree starts empty
+  if ((*list = malloc(sizeof(**list))) == NULL)
+  {
+    return LL_ENUM_ALLOC_FAILURE;
+  }
+  (*list)->root = NULL;
+  (*list)->seed = 2463534242u;
+
+  return LL_ENUM_NO_ERROR;
+} // ll_indexed_init()
+
+ll_enum_t ll_indexed_destroy(ll_indexed_t * list)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+
+  ll_indexed_free(list->root);
+  free(list);
+  return LL_ENUM_NO_ERROR;
+} // ll_indexed_destroy()
+
+ll_enum_t ll_indexed_insert(ll_indexed_t * list, void * data, int32_t index)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(data);
+
+  int32_t size = ll_indexed_size_of(list->root);
+  int32_t position = index;
+  tree_node_t * node;
+
+  // Negative indices count back from the end, -1 appends
+  if (position < 0)
+  {
+    position += size + 1;
+  }
+
+  // Couldn't find index
+  if (position < 0 || position > size)
+  {
+    return LL_ENUM_INDEX_TOO_LARGE;
+  }
+
+  if ((node = malloc(sizeof(*node))) == NULL)
+  {
+    return LL_ENUM_ALLOC_FAILURE;
+  }
+  node->left = NULL;
+  node->right = NULL;
+  node->data = data;
+  node->size = 1;
+
+  // xorshift32 priority, only its order against other nodes matters
+  list->seed ^= list->seed << 13;
+  list->seed ^= list->seed >> 17;
+  list->seed ^= list->seed << 5;
+  node->priority = list->seed;
+
+  list->root = ll_indexed_insert_at(list->root, node, position);
+  return LL_ENUM_NO_ERROR;
+} // ll_indexed_insert()
+
+ll_enum_t ll_indexed_remove(ll_indexed_t * list, void ** data, int32_t index)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(data);
+
+  int32_t size = ll_indexed_size_of(list->root);
+  int32_t position = index;
+  tree_node_t * node;
+
+  // Negative indices count back from the end, -1 is the last item
+  if (position < 0)
+  {
+    position += size;
+  }
+
+  // Couldn't find index
+  if (position < 0 || position >= size)
+  {
+    return LL_ENUM_INDEX_TOO_LARGE;
+  }
+
+  list->root = ll_indexed_remove_at(list->root, position, &node);
+  *data = node->data;
+  free(node);
+  return LL_ENUM_NO_ERROR;
+} // ll_indexed_remove()
+
+ll_enum_t ll_indexed_get(ll_indexed_t * list, void ** data, int32_t index)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(data);
+
+  tree_node_t * node = list->root;
+  int32_t position = index;
+  int32_t left_size;
+
+  // Negative indices count back from the end, -1 is the last item
+  if (position < 0)
+  {
+    position += ll_indexed_size_of(node);
+  }
+
+  // Couldn't find index
+  if (position < 0 || position >= ll_indexed_size_of(node))
+  {
+    return LL_ENUM_INDEX_TOO_LARGE;
+  }
+
+  // Steer by the left subtree sizes
+  while (position != (left_size = ll_indexed_size_of(node->left)))
+  {
+    if (position < left_size)
+    {
+      node = node->left;
+    }
+    else
+    {
+      position -= left_size + 1;
+      node = node->right;
+    }
+  }
+  *data = node->data;
+  return LL_ENUM_NO_ERROR;
+} // ll_indexed_get()
+
+ll_enum_t ll_indexed_search(ll_indexed_t * list,
+                            void * data,
+                            COMPAREFUNC func,
+                            int32_t * index)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(data);
+  LL_CHECK_NULL(func);
+  LL_CHECK_NULL(index);
+
+  int32_t count = 0;
+
+  // Look through the tree in order using compare function to find data
+  if (ll_indexed_find(list->root, data, func, &count) == NULL)
+  {
+    return LL_DATA_NOT_FOUND;
+  }
+  *index = count;
+  return LL_ENUM_NO_ERROR;
+} // ll_indexed_search()
+
+ll_enum_t ll_indexed_dump(ll_indexed_t * list, PRINTFUNC func)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(func);
+
+  uint32_t count = 0;
+
+  ll_indexed_print(list->root, func, &count);
+  return LL_ENUM_NO_ERROR;
+} // ll_indexed_dump()
+
+ll_enum_t ll_indexed_size(ll_indexed_t * list, int32_t * size)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(size);
+
+  *size = ll_indexed_size_of(list->root);
+  return LL_ENUM_NO_ERROR;
+} // ll_indexed_size()
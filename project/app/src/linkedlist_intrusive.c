@@ -0,0 +1,199 @@
+/** @file linkedlist_intrusive.c
+*
+* @brief Implementation of intrusive doubly linked list.  The list is
+*        circular through its head so neither end needs a NULL check.
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "linkedlist_intrusive.h"
+#include "log.h"
+
+// Convert between an object and its link
+#define LINK(list, object) ((ll_link_t *)((char *)(object) + (list)->offset))
+#define OBJECT(list, link) ((void *)((char *)(link) - (list)->offset))
+
+/*
+ * \brief ll_intrusive_link_at: finds the link at a position, walking from
+ *                              whichever end of the list is closer
+ *
+ * \param list: pointer to the list
+ * \param position: position of the link, 0 to count, count gives the head
+ * \return: the link
+ *
+ */
+static ll_link_t * ll_intrusive_link_at(ll_intrusive_t * list, int32_t position)
+{
+  ll_link_t * current = &list->head;
+
+  // Walk forward from the head
+  if (position < list->count / 2)
+  {
+    for (int32_t i = -1; i < position; i++)
+    {
+      current = current->next;
+    }
+    return current;
+  }
+
+  // Walk backward from the head
+  for (int32_t i = list->count; i > position; i--)
+  {
+    current = current->prev;
+  }
+  return current;
+} // ll_intrusive_link_at()
+
+ll_enum_t ll_intrusive_init(ll_intrusive_t * list, size_t offset)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+
+  // An empty list points at itself
+  list->head.next = &list->head;
+  list->head.prev = &list->head;
+  list->offset = offset;
+  list->count = 0;
+
+  return LL_ENUM_NO_ERROR;
+} // ll_intrusive_init()
+
+ll_enum_t ll_intrusive_insert(ll_intrusive_t * list, void * object, int32_t index)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(object);
+
+  ll_link_t * link = LINK(list, object);
+  ll_link_t * next;
+  int32_t position = index;
+
+  // Negative indices count back from the end, -1 appends
+  if (position < 0)
+  {
+    position += list->count + 1;
+  }
+
+  // Couldn't find index
+  if (position < 0 || position > list->count)
+  {
+    return LL_ENUM_INDEX_TOO_LARGE;
+  }
+
+  // Link in front of the object at position, the head when appending
+  next = ll_intrusive_link_at(list, position);
+  link->next = next;
+  link->prev = next->prev;
+  next->prev->next = link;
+  next->prev = link;
+  list->count++;
+
+  return LL_ENUM_NO_ERROR;
+} // ll_intrusive_insert()
+
+ll_enum_t ll_intrusive_remove(ll_intrusive_t * list, void ** object, int32_t index)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(object);
+
+  int32_t position = index;
+
+  // Negative indices count back from the end, -1 is the last object
+  if (position < 0)
+  {
+    position += list->count;
+  }
+
+  // Couldn't find index
+  if (position < 0 || position >= list->count)
+  {
+    return LL_ENUM_INDEX_TOO_LARGE;
+  }
+
+  // Object was found, unlink it
+  *object = OBJECT(list, ll_intrusive_link_at(list, position));
+  return ll_intrusive_unlink(list, *object);
+} // ll_intrusive_remove()
+
+ll_enum_t ll_intrusive_unlink(ll_intrusive_t * list, void * object)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(object);
+
+  ll_link_t * link = LINK(list, object);
+
+  // Join the neighbours and clear the link so a stale use faults
+  link->prev->next = link->next;
+  link->next->prev = link->prev;
+  link->next = NULL;
+  link->prev = NULL;
+  list->count--;
+
+  return LL_ENUM_NO_ERROR;
+} // ll_intrusive_unlink()
+
+ll_enum_t ll_intrusive_search(ll_intrusive_t * list,
+                              void * data,
+                              COMPAREFUNC func,
+                              void ** object)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(data);
+  LL_CHECK_NULL(func);
+  LL_CHECK_NULL(object);
+
+  // Look through objects using compare function to find data
+  for (ll_link_t * current = list->head.next;
+       current != &list->head;
+       current = current->next)
+  {
+    if (func(data, OBJECT(list, current)))
+    {
+      *object = OBJECT(list, current);
+      return LL_ENUM_NO_ERROR;
+    }
+  }
+  return LL_DATA_NOT_FOUND;
+} // ll_intrusive_search()
+
+ll_enum_t ll_intrusive_dump(ll_intrusive_t * list, PRINTFUNC func)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(func);
+
+  uint32_t count = 0;
+
+  // Loop over list calling the print function
+  for (ll_link_t * current = list->head.next;
+       current != &list->head;
+       current = current->next)
+  {
+    func(OBJECT(list, current), count);
+    count++;
+  }
+  return LL_ENUM_NO_ERROR;
+} // ll_intrusive_dump()
+
+ll_enum_t ll_intrusive_size(ll_intrusive_t * list, int32_t * size)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(size);
+
+  *size = list->count;
+  return LL_ENUM_NO_ERROR;
+} // ll_intrusive_size()
@@ -0,0 +1,403 @@
+/** @file linkedlist_rcu.c
+*
+* @brief Implementation of concurrent linked list with lock free readers.
+*        Removed nodes are reclaimed by epochs: a reader publishes the
+*        global epoch when its read section starts, a writer tags each
+*        removed node with the epoch it was removed in and then moves the
+*        epoch on.  A node is freed once every reader in a read section
+*        published a later epoch, those readers started after the node was
+*        unlinked so none of them can reach it.
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "linkedlist_rcu.h"
+#include "log.h"
+
+// Atomic helpers for links and epochs shared with readers
+#define LOAD_RELAXED(x) __atomic_load_n(&(x), __ATOMIC_RELAXED)
+#define LOAD_ACQUIRE(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define STORE_RELAXED(x, val) __atomic_store_n(&(x), val, __ATOMIC_RELAXED)
+#define STORE_RELEASE(x, val) __atomic_store_n(&(x), val, __ATOMIC_RELEASE)
+#define FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+// Size the reader slots are padded to so readers do not share cache lines
+#define LL_RCU_CACHE_LINE_SIZE (64)
+
+// Node on the list, next is left alone when the node is removed so a reader
+// standing on it can still walk on
+typedef struct rcu_node
+{
+  struct rcu_node * next;
+  void * data;
+
+  // Only used after removal
+  struct rcu_node * retired;
+  uint64_t epoch;
+} rcu_node_t;
+
+// Reader slot, epoch is 0 outside a read section
+typedef struct rcu_reader
+{
+  uint64_t epoch;
+  uint32_t used;
+  uint8_t pad[LL_RCU_CACHE_LINE_SIZE - sizeof(uint64_t) - sizeof(uint32_t)];
+} rcu_reader_t;
+
+// Concurrent list structure
+struct ll_rcu
+{
+  rcu_reader_t readers[LL_RCU_MAX_READERS];
+
+  // Shared with readers
+  rcu_node_t head;
+  uint64_t epoch;
+  int32_t count;
+
+  // Only touched by writers holding the lock, newest removed node first
+  pthread_mutex_t lock;
+  rcu_node_t * retired;
+};
+
+/*
+ * \brief ll_rcu_reclaim: frees removed nodes that no read section can see,
+ *                        called with the writer lock held
+ *
+ * \param list: pointer to the list
+ *
+ */
+static void ll_rcu_reclaim(ll_rcu_t * list)
+{
+  uint64_t oldest = UINT64_MAX;
+  uint64_t epoch;
+  rcu_node_t ** slot = &list->retired;
+  rcu_node_t * node;
+  rcu_node_t * next;
+
+  // Pairs with the fence in ll_rcu_read_lock, a reader this scan misses
+  // will see the unlinks made before it.  The acquire pairs with
+  // ll_rcu_read_unlock so a finished section's reads happen before a free.
+  FENCE();
+  for (uint32_t i = 0; i < LL_RCU_MAX_READERS; i++)
+  {
+    epoch = LOAD_ACQUIRE(list->readers[i].epoch);
+    if (epoch != 0 && epoch < oldest)
+    {
+      oldest = epoch;
+    }
+  }
+
+  // The retired list is newest first, once one node is old enough so is
+  // the rest
+  while (*slot != NULL && (*slot)->epoch >= oldest)
+  {
+    slot = &(*slot)->retired;
+  }
+  node = *slot;
+  *slot = NULL;
+  while (node != NULL)
+  {
+    next = node->retired;
+    free(node->data);
+    free(node);
+    node = next;
+  }
+} // ll_rcu_reclaim()
+
+ll_enum_t ll_rcu_init(ll_rcu_t ** list)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+
+  // Alloc a new list on a cache line boundary, malloc only promises 16
+  // bytes so the padded reader slots could still share lines
+  if (posix_memalign((void **)list, LL_RCU_CACHE_LINE_SIZE, sizeof(**list)) != 0)
+  {
+    *list = NULL;
+    return LL_ENUM_ALLOC_FAILURE;
+  }
+
+  // Memset list, epoch 0 is kept for idle readers
+  memset(*list, 0, sizeof(**list));
+  (*list)->epoch = 1;
+  if (pthread_mutex_init(&(*list)->lock, NULL) != 0)
+  {
+    free(*list);
+    *list = NULL;
+    return LL_ENUM_FAILURE;
+  }
+
+  return LL_ENUM_NO_ERROR;
+} // ll_rcu_init()
+
+ll_enum_t ll_rcu_destroy(ll_rcu_t * list)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+
+  rcu_node_t * current = list->head.next;
+  rcu_node_t * next;
+
+  // Loop over list freeing data and nodes
+  while (current != NULL)
+  {
+    next = current->next;
+    free(current->data);
+    free(current);
+    current = next;
+  }
+
+  // Then the removed nodes still waiting
+  current = list->retired;
+  while (current != NULL)
+  {
+    next = current->retired;
+    free(current->data);
+    free(current);
+    current = next;
+  }
+
+  pthread_mutex_destroy(&list->lock);
+  free(list);
+  return LL_ENUM_NO_ERROR;
+} // ll_rcu_destroy()
+
+ll_enum_t ll_rcu_register(ll_rcu_t * list, uint32_t * reader)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(reader);
+
+  uint32_t expected;
+
+  // Claim the first free slot
+  for (uint32_t i = 0; i < LL_RCU_MAX_READERS; i++)
+  {
+    expected = 0;
+    if (__atomic_compare_exchange_n(&list->readers[i].used, &expected, 1, 0,
+                                    __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+      *reader = i;
+      return LL_ENUM_NO_ERROR;
+    }
+  }
+  return LL_ENUM_FAILURE;
+} // ll_rcu_register()
+
+ll_enum_t ll_rcu_unregister(ll_rcu_t * list, uint32_t reader)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+
+  if (reader >= LL_RCU_MAX_READERS)
+  {
+    return LL_ENUM_INDEX_TOO_LARGE;
+  }
+
+  STORE_RELEASE(list->readers[reader].epoch, 0);
+  STORE_RELEASE(list->readers[reader].used, 0);
+  return LL_ENUM_NO_ERROR;
+} // ll_rcu_unregister()
+
+ll_enum_t ll_rcu_read_lock(ll_rcu_t * list, uint32_t reader)
+{
+  LL_CHECK_NULL(list);
+
+  if (reader >= LL_RCU_MAX_READERS)
+  {
+    return LL_ENUM_INDEX_TOO_LARGE;
+  }
+
+  // Publish the epoch before reading any link.  If a writer's scan misses
+  // it the fences order this section after the writer's unlinks, and an
+  // epoch that is already stale only delays frees.
+  STORE_RELAXED(list->readers[reader].epoch, LOAD_RELAXED(list->epoch));
+  FENCE();
+  return LL_ENUM_NO_ERROR;
+} // ll_rcu_read_lock()
+
+ll_enum_t ll_rcu_read_unlock(ll_rcu_t * list, uint32_t reader)
+{
+  LL_CHECK_NULL(list);
+
+  if (reader >= LL_RCU_MAX_READERS)
+  {
+    return LL_ENUM_INDEX_TOO_LARGE;
+  }
+
+  // Every read in the section happens before the slot is cleared
+  STORE_RELEASE(list->readers[reader].epoch, 0);
+  return LL_ENUM_NO_ERROR;
+} // ll_rcu_read_unlock()
+
+ll_enum_t ll_rcu_search(ll_rcu_t * list,
+                        void * data,
+                        COMPAREFUNC func,
+                        void ** found)
+{
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(data);
+  LL_CHECK_NULL(func);
+  LL_CHECK_NULL(found);
+
+  // Look through list using compare function to find data
+  for (rcu_node_t * current = LOAD_ACQUIRE(list->head.next);
+       current != NULL;
+       current = LOAD_ACQUIRE(current->next))
+  {
+    if (func(data, current->data))
+    {
+      *found = current->data;
+      return LL_ENUM_NO_ERROR;
+    }
+  }
+  return LL_DATA_NOT_FOUND;
+} // ll_rcu_search()
+
+ll_enum_t ll_rcu_dump(ll_rcu_t * list, PRINTFUNC func)
+{
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(func);
+
+  uint32_t count = 0;
+
+  // Loop over list calling the print function
+  for (rcu_node_t * current = LOAD_ACQUIRE(list->head.next);
+       current != NULL;
+       current = LOAD_ACQUIRE(current->next))
+  {
+    func(current->data, count);
+    count++;
+  }
+  return LL_ENUM_NO_ERROR;
+} // ll_rcu_dump()
+
+ll_enum_t ll_rcu_insert(ll_rcu_t * list, void * data, int32_t index)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(data);
+
+  rcu_node_t * prev = &list->head;
+  rcu_node_t * node;
+  int32_t position = index;
+
+  if ((node = malloc(sizeof(*node))) == NULL)
+  {
+    return LL_ENUM_ALLOC_FAILURE;
+  }
+  node->data = data;
+
+  pthread_mutex_lock(&list->lock);
+
+  // Negative indices count back from the end, -1 appends
+  if (position < 0)
+  {
+    position += list->count + 1;
+  }
+
+  // Couldn't find index
+  if (position < 0 || position > list->count)
+  {
+    pthread_mutex_unlock(&list->lock);
+    free(node);
+    return LL_ENUM_INDEX_TOO_LARGE;
+  }
+
+  // Walk to the node before position
+  for (int32_t i = 0; i < position; i++)
+  {
+    prev = prev->next;
+  }
+
+  // Readers that load the new link see a complete node
+  node->next = prev->next;
+  STORE_RELEASE(prev->next, node);
+  STORE_RELAXED(list->count, list->count + 1);
+
+  pthread_mutex_unlock(&list->lock);
+  return LL_ENUM_NO_ERROR;
+} // ll_rcu_insert()
+
+ll_enum_t ll_rcu_remove(ll_rcu_t * list, void * data, COMPAREFUNC func)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(data);
+  LL_CHECK_NULL(func);
+
+  rcu_node_t * prev = &list->head;
+  rcu_node_t * node;
+
+  pthread_mutex_lock(&list->lock);
+
+  // Find the node before the first match
+  while (prev->next != NULL && !func(data, prev->next->data))
+  {
+    prev = prev->next;
+  }
+  if ((node = prev->next) == NULL)
+  {
+    pthread_mutex_unlock(&list->lock);
+    return LL_DATA_NOT_FOUND;
+  }
+
+  // Unlink it, readers already on the node keep walking through its next
+  STORE_RELEASE(prev->next, node->next);
+  STORE_RELAXED(list->count, list->count - 1);
+
+  // Retire it in this epoch and start the next one so readers starting
+  // from now on are known not to hold it
+  node->epoch = LOAD_RELAXED(list->epoch);
+  node->retired = list->retired;
+  list->retired = node;
+  __atomic_fetch_add(&list->epoch, 1, __ATOMIC_SEQ_CST);
+
+  // Free whatever no reader can see anymore without waiting
+  ll_rcu_reclaim(list);
+
+  pthread_mutex_unlock(&list->lock);
+  return LL_ENUM_NO_ERROR;
+} // ll_rcu_remove()
+
+ll_enum_t ll_rcu_synchronize(ll_rcu_t * list)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+
+  pthread_mutex_lock(&list->lock);
+
+  // Every retired node is from an earlier epoch, wait for the readers
+  // holding them to leave
+  ll_rcu_reclaim(list);
+  while (list->retired != NULL)
+  {
+    sched_yield();
+    ll_rcu_reclaim(list);
+  }
+
+  pthread_mutex_unlock(&list->lock);
+  return LL_ENUM_NO_ERROR;
+} // ll_rcu_synchronize()
+
+ll_enum_t ll_rcu_size(ll_rcu_t * list, int32_t * size)
+{
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(size);
+
+  *size = LOAD_RELAXED(list->count);
+  return LL_ENUM_NO_ERROR;
+} // ll_rcu_size()
@@ -0,0 +1,288 @@
+/** @file linkedlist_skip.c
+*
+* @brief Implementation of ordered skip list.  Level 0 links every node in
+*        order, each level above links about a quarter of the nodes below.
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "linkedlist_skip.h"
+#include "log.h"
+
+// Node with one forward link per level it is on
+typedef struct skip_node
+{
+  void * data;
+  struct skip_node * next[];
+} skip_node_t;
+
+// Skip list structure
+struct ll_skip
+{
+  skip_node_t * head;
+  COMPAREFUNC less;
+  uint32_t level;
+  uint32_t seed;
+  int32_t count;
+};
+
+/*
+ * \brief ll_skip_node_new: allocates a node with a number of levels
+ *
+ * \param level: number of forward links
+ * \return: the node or NULL if allocation failed
+ *
+ */
+static skip_node_t * ll_skip_node_new(uint32_t level)
+{
+  return calloc(1, sizeof(skip_node_t) + level * sizeof(skip_node_t *));
+} // ll_skip_node_new()
+
+/*
+ * \brief ll_skip_random_level: picks a level for a new node, each level
+ *                              above the first is kept with chance 1/4
+ *
+ * \param list: pointer to the list holding the generator state
+ * \return: level from 1 to LL_SKIP_MAX_LEVEL
+ *
+ */
+static uint32_t ll_skip_random_level(ll_skip_t * list)
+{
+  uint32_t bits;
+  uint32_t level = 1;
+
+  // xorshift32, cheap and good enough to shape the levels
+  list->seed ^= list->seed << 13;
+  list->seed ^= list->seed >> 17;
+  list->seed ^= list->seed << 5;
+  bits = list->seed;
+
+  // Two zero bits per extra level
+  while ((bits & 3) == 0 && level < LL_SKIP_MAX_LEVEL)
+  {
+    level++;
+    bits >>= 2;
+  }
+  return level;
+} // ll_skip_random_level()
+
+/*
+ * \brief ll_skip_find: walks down the levels to the last node before a key
+ *
+ * \param list: pointer to the list
+ * \param key: key passed to the compare function
+ * \param after_equal: 1 to stop after equal items, 0 to stop before them
+ * \param update: filled with the last node before the key on each level,
+ *                may be NULL
+ * \return: the last node before the key on level 0, the head if none
+ *
+ */
+static skip_node_t * ll_skip_find(ll_skip_t * list,
+                                  void * key,
+                                  uint8_t after_equal,
+                                  skip_node_t ** update)
+{
+  skip_node_t * current = list->head;
+  skip_node_t * next;
+
+  for (uint32_t i = list->level; i > 0; i--)
+  {
+    // Move along this level while the next node still sorts before the key
+    while ((next = current->next[i - 1]) != NULL &&
+           (after_equal ? !list->less(key, next->data) : list->less(next->data, key)))
+    {
+      current = next;
+    }
+    if (update != NULL)
+    {
+      update[i - 1] = current;
+    }
+  }
+  return current;
+} // ll_skip_find()
+
+ll_enum_t ll_skip_init(ll_skip_t ** list, COMPAREFUNC less)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(less);
+
+  // Alloc a new list and a head that is on every level
+  if ((*list = malloc(sizeof(**list))) == NULL)
+  {
+    return LL_ENUM_ALLOC_FAILURE;
+  }
+  if (((*list)->head = ll_skip_node_new(LL_SKIP_MAX_LEVEL)) == NULL)
+  {
+    free(*list);
+    *list = NULL;
+    return LL_ENUM_ALLOC_FAILURE;
+  }
+  (*list)->less = less;
+  (*list)->level = 1;
+  (*list)->seed = 2463534242u;
+  (*list)->count = 0;
+
+  return LL_ENUM_NO_ERROR;
+} // ll_skip_init()
+
+ll_enum_t ll_skip_destroy(ll_skip_t * list)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+
+  skip_node_t * current = list->head->next[0];
+  skip_node_t * next;
+
+  // Loop over level 0 freeing data and nodes
+  while (current != NULL)
+  {
+    next = current->next[0];
+    free(current->data);
+    free(current);
+    current = next;
+  }
+
+  free(list->head);
+  free(list);
+  return LL_ENUM_NO_ERROR;
+} // ll_skip_destroy()
+
+ll_enum_t ll_skip_insert(ll_skip_t * list, void * data)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(data);
+
+  skip_node_t * update[LL_SKIP_MAX_LEVEL];
+  skip_node_t * node;
+  uint32_t level = ll_skip_random_level(list);
+
+  if ((node = ll_skip_node_new(level)) == NULL)
+  {
+    return LL_ENUM_ALLOC_FAILURE;
+  }
+  node->data = data;
+
+  // Equal items keep their insertion order
+  ll_skip_find(list, data, 1, update);
+
+  // New levels start at the head
+  for (uint32_t i = list->level; i < level; i++)
+  {
+    update[i] = list->head;
+  }
+  if (level > list->level)
+  {
+    list->level = level;
+  }
+
+  // Link the node in on each of its levels
+  for (uint32_t i = 0; i < level; i++)
+  {
+    node->next[i] = update[i]->next[i];
+    update[i]->next[i] = node;
+  }
+  list->count++;
+
+  return LL_ENUM_NO_ERROR;
+} // ll_skip_insert()
+
+ll_enum_t ll_skip_remove(ll_skip_t * list, void * key, void ** data)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(key);
+  LL_CHECK_NULL(data);
+
+  skip_node_t * update[LL_SKIP_MAX_LEVEL];
+  skip_node_t * node = ll_skip_find(list, key, 0, update)->next[0];
+
+  // The first node not before the key has to be equal to it
+  if (node == NULL || list->less(key, node->data))
+  {
+    return LL_DATA_NOT_FOUND;
+  }
+
+  // Unlink the node from every level it is on
+  for (uint32_t i = 0; i < list->level && update[i]->next[i] == node; i++)
+  {
+    update[i]->next[i] = node->next[i];
+  }
+
+  // Drop levels that are now empty
+  while (list->level > 1 && list->head->next[list->level - 1] == NULL)
+  {
+    list->level--;
+  }
+
+  *data = node->data;
+  free(node);
+  list->count--;
+  return LL_ENUM_NO_ERROR;
+} // ll_skip_remove()
+
+ll_enum_t ll_skip_lookup(ll_skip_t * list, void * key, void ** data)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(key);
+  LL_CHECK_NULL(data);
+
+  skip_node_t * node = ll_skip_find(list, key, 0, NULL)->next[0];
+
+  if (node == NULL || list->less(key, node->data))
+  {
+    return LL_DATA_NOT_FOUND;
+  }
+  *data = node->data;
+  return LL_ENUM_NO_ERROR;
+} // ll_skip_lookup()
+
+ll_enum_t ll_skip_range(ll_skip_t * list, void * low, void * high, PRINTFUNC func)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(func);
+
+  skip_node_t * current;
+  uint32_t count = 0;
+
+  // Jump to the first item in the range then walk level 0
+  current = low == NULL ? list->head : ll_skip_find(list, low, 0, NULL);
+  current = current->next[0];
+  while (current != NULL && (high == NULL || list->less(current->data, high)))
+  {
+    func(current->data, count);
+    count++;
+    current = current->next[0];
+  }
+  return LL_ENUM_NO_ERROR;
+} // ll_skip_range()
+
+ll_enum_t ll_skip_dump(ll_skip_t * list, PRINTFUNC func)
+{
+  FUNC_ENTRY;
+
+  return ll_skip_range(list, NULL, NULL, func);
+} // ll_skip_dump()
+
+ll_enum_t ll_skip_size(ll_skip_t * list, int32_t * size)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(size);
+
+  *size = list->count;
+  return LL_ENUM_NO_ERROR;
+} // ll_skip_size()
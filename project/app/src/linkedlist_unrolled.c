@@ -0,0 +1,388 @@
+/** @file linkedlist_unrolled.c
+*
+* @brief Implementation of unrolled doubly linked list
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "linkedlist_unrolled.h"
+#include "log.h"
+
+// Node holding up to LL_UNROLLED_SLOTS items, items are kept packed at the
+// start of the array
+typedef struct block
+{
+  struct block * next;
+  struct block * prev;
+  uint32_t count;
+  void * data[LL_UNROLLED_SLOTS];
+} block_t;
+
+// Unrolled list structure
+struct ll_unrolled
+{
+  block_t * first;
+  block_t * last;
+  int32_t count;
+};
+
+/*
+ * \brief ll_unrolled_block_at: finds the node holding a position, walking
+ *                              from whichever end of the list is closer
+ *
+ * \param list: pointer to the list
+ * \param position: position of the item, 0 to count - 1
+ * \param offset: position of the item inside the node
+ * \return: the node
+ *
+ */
+static block_t * ll_unrolled_block_at(ll_unrolled_t * list,
+                                      int32_t position,
+                                      uint32_t * offset)
+{
+  block_t * current;
+  int32_t start;
+
+  // Walk forward counting items up to the position
+  if (position < list->count / 2)
+  {
+    current = list->first;
+    start = 0;
+    while (position >= start + (int32_t)current->count)
+    {
+      start += current->count;
+      current = current->next;
+    }
+  }
+  else
+  {
+    // Walk backward from the end
+    current = list->last;
+    start = list->count - current->count;
+    while (position < start)
+    {
+      current = current->prev;
+      start -= current->count;
+    }
+  }
+
+  *offset = position - start;
+  return current;
+} // ll_unrolled_block_at()
+
+/*
+ * \brief ll_unrolled_link: allocates an empty node and links it after prev,
+ *                          or first when prev is NULL
+ *
+ * \param list: pointer to the list
+ * \param prev: node the new node goes after
+ * \return: the node or NULL if allocation failed
+ *
+ */
+static block_t * ll_unrolled_link(ll_unrolled_t * list, block_t * prev)
+{
+  block_t * block;
+
+  if ((block = malloc(sizeof(*block))) == NULL)
+  {
+    return NULL;
+  }
+  block->count = 0;
+  block->prev = prev;
+  block->next = prev == NULL ? list->first : prev->next;
+  if (block->next != NULL)
+  {
+    block->next->prev = block;
+  }
+  else
+  {
+    list->last = block;
+  }
+  if (prev != NULL)
+  {
+    prev->next = block;
+  }
+  else
+  {
+    list->first = block;
+  }
+  return block;
+} // ll_unrolled_link()
+
+/*
+ * \brief ll_unrolled_unlink: unlinks and frees a node
+ *
+ * \param list: pointer to the list
+ * \param block: node to free
+ *
+ */
+static void ll_unrolled_unlink(ll_unrolled_t * list, block_t * block)
+{
+  if (block->prev != NULL)
+  {
+    block->prev->next = block->next;
+  }
+  else
+  {
+    list->first = block->next;
+  }
+  if (block->next != NULL)
+  {
+    block->next->prev = block->prev;
+  }
+  else
+  {
+    list->last = block->prev;
+  }
+  free(block);
+} // ll_unrolled_unlink()
+
+/*
+ * \brief ll_unrolled_merge: moves the items of the node after block into
+ *                           block and frees it
+ *
+ * \param list: pointer to the list
+ * \param block: node that takes the items, the next node must fit in it
+ *
+ */
+static void ll_unrolled_merge(ll_unrolled_t * list, block_t * block)
+{
+  block_t * next = block->next;
+
+  memcpy(&block->data[block->count], next->data, next->count * sizeof(void *));
+  block->count += next->count;
+  ll_unrolled_unlink(list, next);
+} // ll_unrolled_merge()
+
+ll_enum_t ll_unrolled_init(ll_unrolled_t ** list)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+
+  // Alloc a new list
+  if ((*list = malloc(sizeof(**list))) == NULL)
+  {
+    return LL_ENUM_ALLOC_FAILURE;
+  }
+
+  // Memset list
+  memset(*list, 0, sizeof(**list));
+
+  return LL_ENUM_NO_ERROR;
+} // ll_unrolled_init()
+
+ll_enum_t ll_unrolled_destroy(ll_unrolled_t * list)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+
+  block_t * current = list->first;
+  block_t * next;
+
+  // Loop over nodes freeing data and nodes
+  while (current != NULL)
+  {
+    next = current->next;
+    for (uint32_t i = 0; i < current->count; i++)
+    {
+      free(current->data[i]);
+    }
+    free(current);
+    current = next;
+  }
+
+  free(list);
+  return LL_ENUM_NO_ERROR;
+} // ll_unrolled_destroy()
+
+ll_enum_t ll_unrolled_insert(ll_unrolled_t * list, void * data, int32_t index)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(data);
+
+  block_t * block;
+  block_t * split;
+  uint32_t offset;
+  uint32_t half;
+  int32_t position = index;
+
+  // Negative indices count back from the end, -1 appends
+  if (position < 0)
+  {
+    position += list->count + 1;
+  }
+
+  // Couldn't find index
+  if (position < 0 || position > list->count)
+  {
+    return LL_ENUM_INDEX_TOO_LARGE;
+  }
+
+  // Appends go to the last node, the first insert needs a node
+  if (position == list->count)
+  {
+    if (list->last == NULL && ll_unrolled_link(list, NULL) == NULL)
+    {
+      return LL_ENUM_ALLOC_FAILURE;
+    }
+    block = list->last;
+    offset = block->count;
+  }
+  else
+  {
+    block = ll_unrolled_block_at(list, position, &offset);
+  }
+
+  // A full node is split, appends start a fresh node so a list built by
+  // appending stays packed
+  if (block->count == LL_UNROLLED_SLOTS)
+  {
+    if ((split = ll_unrolled_link(list, block)) == NULL)
+    {
+      return LL_ENUM_ALLOC_FAILURE;
+    }
+    half = offset == LL_UNROLLED_SLOTS ? LL_UNROLLED_SLOTS : LL_UNROLLED_SLOTS / 2;
+    split->count = LL_UNROLLED_SLOTS - half;
+    memcpy(split->data, &block->data[half], split->count * sizeof(void *));
+    block->count = half;
+    if (offset >= half)
+    {
+      block = split;
+      offset -= half;
+    }
+  }
+
+  // Open a slot and place the data
+  memmove(&block->data[offset + 1],
+          &block->data[offset],
+          (block->count - offset) * sizeof(void *));
+  block->data[offset] = data;
+  block->count++;
+  list->count++;
+
+  return LL_ENUM_NO_ERROR;
+} // ll_unrolled_insert()
+
+ll_enum_t ll_unrolled_remove(ll_unrolled_t * list, void ** data, int32_t index)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(data);
+
+  block_t * block;
+  uint32_t offset;
+  int32_t position = index;
+
+  // Negative indices count back from the end, -1 is the last item
+  if (position < 0)
+  {
+    position += list->count;
+  }
+
+  // Couldn't find index
+  if (position < 0 || position >= list->count)
+  {
+    return LL_ENUM_INDEX_TOO_LARGE;
+  }
+
+  // Close the slot
+  block = ll_unrolled_block_at(list, position, &offset);
+  *data = block->data[offset];
+  block->count--;
+  memmove(&block->data[offset],
+          &block->data[offset + 1],
+          (block->count - offset) * sizeof(void *));
+  list->count--;
+
+  // Free an empty node, merge a sparse one with a neighbour it fits into
+  if (block->count == 0)
+  {
+    ll_unrolled_unlink(list, block);
+  }
+  else if (block->count < LL_UNROLLED_SLOTS / 2)
+  {
+    if (block->next != NULL &&
+        block->count + block->next->count <= LL_UNROLLED_SLOTS)
+    {
+      ll_unrolled_merge(list, block);
+    }
+    else if (block->prev != NULL &&
+             block->count + block->prev->count <= LL_UNROLLED_SLOTS)
+    {
+      ll_unrolled_merge(list, block->prev);
+    }
+  }
+
+  return LL_ENUM_NO_ERROR;
+} // ll_unrolled_remove()
+
+ll_enum_t ll_unrolled_search(ll_unrolled_t * list,
+                             void * data,
+                             COMPAREFUNC func,
+                             int32_t * index)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(data);
+  LL_CHECK_NULL(func);
+  LL_CHECK_NULL(index);
+
+  int32_t count = 0;
+
+  // Look through every slot of every node using compare function
+  for (block_t * current = list->first; current != NULL; current = current->next)
+  {
+    for (uint32_t i = 0; i < current->count; i++)
+    {
+      if (func(data, current->data[i]))
+      {
+        *index = count + i;
+        return LL_ENUM_NO_ERROR;
+      }
+    }
+    count += current->count;
+  }
+  return LL_DATA_NOT_FOUND;
+} // ll_unrolled_search()
+
+ll_enum_t ll_unrolled_dump(ll_unrolled_t * list, PRINTFUNC func)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(func);
+
+  uint32_t count = 0;
+
+  // Loop over every slot calling the print function
+  for (block_t * current = list->first; current != NULL; current = current->next)
+  {
+    for (uint32_t i = 0; i < current->count; i++)
+    {
+      func(current->data[i], count);
+      count++;
+    }
+  }
+  return LL_ENUM_NO_ERROR;
+} // ll_unrolled_dump()
+
+ll_enum_t ll_unrolled_size(ll_unrolled_t * list, int32_t * size)
+{
+  FUNC_ENTRY;
+
+  LL_CHECK_NULL(list);
+  LL_CHECK_NULL(size);
+
+  *size = list->count;
+  return LL_ENUM_NO_ERROR;
+} // ll_unrolled_size()
@@ -0,0 +1,417 @@
+/** @file ringbuf.c
+*
+* @brief Implementation of byte ring buffer holding variable length records.
+*        Each record is a header holding its length followed by the data,
+*        padded so the next header stays aligned.  Records never straddle
+*        the end of the ring, when one does not fit a pad record fills the
+*        rest of the ring and the record starts over at the beginning.  A
+*        mirrored ring maps its pages twice so it never needs a pad record.
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "ringbuf.h"
+#include "log.h"
+
+// Load/store a position shared between producer and consumer
+#define LOAD_ACQUIRE(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(x, val) __atomic_store_n(&(x), val, __ATOMIC_RELEASE)
+
+// Alignment of every record header and record data
+#define RINGBUF_ALIGN (8)
+
+// Length stored in the header of a pad record
+#define RINGBUF_PAD_RECORD (0xFFFFFFFF)
+
+// Bytes used in the ring by a record of len bytes
+#define RINGBUF_FOOTPRINT(len) \
+  (((len) + sizeof(ringbuf_hdr_t) + RINGBUF_ALIGN - 1) & ~(RINGBUF_ALIGN - 1))
+
+// Record header, sized so the record data is aligned
+typedef struct ringbuf_hdr
+{
+  uint32_t length;
+  uint32_t unused;
+} ringbuf_hdr_t;
+
+// Ring buffer structure.  Head and tail are free running byte positions
+// masked into the ring, head is only written by the producer and tail is
+// only written by the consumer.
+struct ringbuf
+{
+  // Producer cache line
+  uint32_t head;
+  uint32_t tail_cache;
+  uint32_t reserved;
+  uint32_t reserve_skip;
+  uint32_t reserve_length;
+  uint8_t producer_pad[CB_CACHE_LINE_SIZE - 5 * sizeof(uint32_t)];
+
+  // Consumer cache line
+  uint32_t tail;
+  uint32_t head_cache;
+  uint32_t read_size;
+  uint8_t consumer_pad[CB_CACHE_LINE_SIZE - 3 * sizeof(uint32_t)];
+
+  // Read only after initialization
+  uint8_t * buffer;
+  uint32_t size;
+  uint32_t mask;
+  uint32_t max_length;
+  uint32_t mirrored;
+};
+
+/*
+ * \brief ringbuf_map_mirror: Maps size bytes of anonymous memory twice,
+ *                            back to back
+ *
+ * \param size: size of the ring, a multiple of the page size
+ * \return: pointer to the first mapping or NULL on failure
+ *
+ */
+static uint8_t * ringbuf_map_mirror(uint32_t size)
+{
+  uint8_t * base;
+  int fd;
+
+  // Create the memory both mappings share
+  fd = memfd_create("ringbuf", MFD_CLOEXEC);
+  if (fd < 0)
+  {
+    LOG_ERROR("memfd_create failed with error: %s", strerror(errno));
+    return NULL;
+  }
+  if (ftruncate(fd, size) != 0)
+  {
+    LOG_ERROR("ftruncate failed with error: %s", strerror(errno));
+    close(fd);
+    return NULL;
+  }
+
+  // Reserve room for both mappings so nothing else can land in between
+  base = mmap(NULL, 2 * (size_t)size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (base == MAP_FAILED)
+  {
+    LOG_ERROR("mmap failed with error: %s", strerror(errno));
+    close(fd);
+    return NULL;
+  }
+
+  // Map the memory over both halves of the reservation
+  if (mmap(base, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+      mmap(base + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+  {
+    LOG_ERROR("mmap failed with error: %s", strerror(errno));
+    munmap(base, 2 * (size_t)size);
+    close(fd);
+    return NULL;
+  }
+
+  // The mappings keep the memory alive
+  close(fd);
+  return base;
+} // ringbuf_map_mirror()
+
+/*
+ * \brief ringbuf_alloc: Allocates a zeroed ring buffer structure on a cache
+ *                       line boundary.  malloc only promises 16 bytes, which
+ *                       would let the padded producer and consumer lines
+ *                       straddle and share a line.
+ *
+ * \return: pointer to the structure or NULL on failure
+ *
+ */
+static ringbuf_t * ringbuf_alloc(void)
+{
+  void * ring;
+
+  if (posix_memalign(&ring, CB_CACHE_LINE_SIZE, sizeof(ringbuf_t)) != 0)
+  {
+    return NULL;
+  }
+  memset(ring, 0, sizeof(ringbuf_t));
+  return ring;
+} // ringbuf_alloc()
+
+cb_enum_t ringbuf_init(ringbuf_t ** ring, uint32_t size)
+{
+  FUNC_ENTRY;
+
+  uint32_t ring_size = 2 * RINGBUF_ALIGN;
+
+  // Check for null pointers
+  CB_CHECK_NULL(ring);
+
+  // Make sure size is valid
+  if (size == 0 || size > 0x80000000)
+  {
+    return CB_ENUM_NO_LENGTH;
+  }
+
+  // Round the size up to a power of two so positions can be masked
+  while (ring_size < size)
+  {
+    ring_size <<= 1;
+  }
+
+  // Allocate the new ring buffer
+  if ((*ring = ringbuf_alloc()) == NULL)
+  {
+    return CB_ENUM_ALLOC_FAILURE;
+  }
+
+  // Allocate the ring on a cache line boundary too so its lines are not
+  // shared with whatever malloc put next to it
+  if (posix_memalign((void **)&(*ring)->buffer, CB_CACHE_LINE_SIZE, ring_size) != 0)
+  {
+    free(*ring);
+    return CB_ENUM_ALLOC_FAILURE;
+  }
+
+  // A record can take at most half the ring, that way a record always fits
+  // either before or after the wrap once the ring drains
+  (*ring)->size = ring_size;
+  (*ring)->mask = ring_size - 1;
+  (*ring)->max_length = ring_size / 2 - sizeof(ringbuf_hdr_t);
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // ringbuf_init()
+
+cb_enum_t ringbuf_init_mirrored(ringbuf_t ** ring, uint32_t size)
+{
+  FUNC_ENTRY;
+
+  uint32_t ring_size = sysconf(_SC_PAGESIZE);
+
+  // Check for null pointers
+  CB_CHECK_NULL(ring);
+
+  // Make sure size is valid
+  if (size == 0 || size > 0x80000000)
+  {
+    return CB_ENUM_NO_LENGTH;
+  }
+
+  // Round the size up to a power of two which is also a page multiple
+  while (ring_size < size)
+  {
+    ring_size <<= 1;
+  }
+
+  // Allocate the new ring buffer
+  if ((*ring = ringbuf_alloc()) == NULL)
+  {
+    return CB_ENUM_ALLOC_FAILURE;
+  }
+
+  // Map the ring and its mirror
+  if (((*ring)->buffer = ringbuf_map_mirror(ring_size)) == NULL)
+  {
+    free(*ring);
+    return CB_ENUM_ALLOC_FAILURE;
+  }
+
+  // Records never wrap so one can take the whole ring
+  (*ring)->size = ring_size;
+  (*ring)->mask = ring_size - 1;
+  (*ring)->max_length = ring_size - sizeof(ringbuf_hdr_t);
+  (*ring)->mirrored = 1;
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // ringbuf_init_mirrored()
+
+cb_enum_t ringbuf_destroy(ringbuf_t * ring)
+{
+  FUNC_ENTRY;
+
+  // Check for null pointers
+  CB_CHECK_NULL(ring);
+  CB_CHECK_NULL(ring->buffer);
+
+  // Unmap or free the ring then free the structure
+  if (ring->mirrored)
+  {
+    munmap(ring->buffer, 2 * (size_t)ring->size);
+  }
+  else
+  {
+    free(ring->buffer);
+  }
+  free(ring);
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // ringbuf_destroy()
+
+cb_enum_t ringbuf_reserve(ringbuf_t * ring, uint32_t length, void ** record)
+{
+  ringbuf_hdr_t * hdr;
+  uint32_t need;
+  uint32_t pos;
+  uint32_t skip = 0;
+
+  // Check for null pointers
+  CB_CHECK_NULL(ring);
+  CB_CHECK_NULL(record);
+
+  // Only one record can be reserved at a time and it has to fit
+  if (ring->reserved || length > ring->max_length)
+  {
+    return CB_ENUM_FAILURE;
+  }
+
+  // Skip the rest of the ring if the record does not fit before the end,
+  // a mirrored ring just runs on into the mirror
+  need = RINGBUF_FOOTPRINT(length);
+  pos = ring->head & ring->mask;
+  if (!ring->mirrored && need > ring->size - pos)
+  {
+    skip = ring->size - pos;
+  }
+
+  // Only go to the consumer cache line when the cached tail says full
+  if (skip + need > ring->size - (ring->head - ring->tail_cache))
+  {
+    ring->tail_cache = LOAD_ACQUIRE(ring->tail);
+    if (skip + need > ring->size - (ring->head - ring->tail_cache))
+    {
+      return CB_ENUM_FULL;
+    }
+  }
+
+  // Mark the skipped bytes as a pad record and start over at the beginning
+  if (skip != 0)
+  {
+    hdr = (ringbuf_hdr_t *)(ring->buffer + pos);
+    hdr->length = RINGBUF_PAD_RECORD;
+    pos = 0;
+  }
+
+  // Remember the reservation for commit
+  ring->reserved = 1;
+  ring->reserve_skip = skip;
+  ring->reserve_length = length;
+  *record = ring->buffer + pos + sizeof(ringbuf_hdr_t);
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // ringbuf_reserve()
+
+cb_enum_t ringbuf_commit(ringbuf_t * ring, uint32_t length)
+{
+  ringbuf_hdr_t * hdr;
+  uint32_t head;
+
+  // Check for null pointer
+  CB_CHECK_NULL(ring);
+
+  // Make sure there is a reservation big enough for the record
+  if (!ring->reserved || length > ring->reserve_length)
+  {
+    return CB_ENUM_FAILURE;
+  }
+
+  // Fill out the header then publish the record to the consumer
+  head = ring->head + ring->reserve_skip;
+  hdr = (ringbuf_hdr_t *)(ring->buffer + (head & ring->mask));
+  hdr->length = length;
+  ring->reserved = 0;
+  STORE_RELEASE(ring->head, head + RINGBUF_FOOTPRINT(length));
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // ringbuf_commit()
+
+cb_enum_t ringbuf_read(ringbuf_t * ring, void ** record, uint32_t * length)
+{
+  ringbuf_hdr_t * hdr;
+  uint32_t pos;
+  uint32_t skip = 0;
+
+  // Check for null pointers
+  CB_CHECK_NULL(ring);
+  CB_CHECK_NULL(record);
+  CB_CHECK_NULL(length);
+
+  // Only go to the producer cache line when the cached head says empty
+  if (ring->tail == ring->head_cache)
+  {
+    ring->head_cache = LOAD_ACQUIRE(ring->head);
+    if (ring->tail == ring->head_cache)
+    {
+      return CB_ENUM_EMPTY;
+    }
+  }
+
+  // Step over a pad record, the real record is always committed with it
+  pos = ring->tail & ring->mask;
+  hdr = (ringbuf_hdr_t *)(ring->buffer + pos);
+  if (hdr->length == RINGBUF_PAD_RECORD)
+  {
+    skip = ring->size - pos;
+    hdr = (ringbuf_hdr_t *)ring->buffer;
+  }
+
+  // Hand out the record and remember how much to release
+  *record = hdr + 1;
+  *length = hdr->length;
+  ring->read_size = skip + RINGBUF_FOOTPRINT(hdr->length);
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // ringbuf_read()
+
+cb_enum_t ringbuf_release(ringbuf_t * ring)
+{
+  // Check for null pointer
+  CB_CHECK_NULL(ring);
+
+  // Make sure a record was read
+  if (ring->read_size == 0)
+  {
+    return CB_ENUM_FAILURE;
+  }
+
+  // Give the bytes back to the producer
+  STORE_RELEASE(ring->tail, ring->tail + ring->read_size);
+  ring->read_size = 0;
+
+  // Return success
+  return CB_ENUM_NO_ERROR;
+} // ringbuf_release()
+
+cb_enum_t ringbuf_size(ringbuf_t * ring, uint32_t * size)
+{
+  // Check null pointers
+  CB_CHECK_NULL(ring);
+  CB_CHECK_NULL(size);
+
+  *size = ring->size;
+
+  return CB_ENUM_NO_ERROR;
+} // ringbuf_size()
+
+cb_enum_t ringbuf_empty(ringbuf_t * ring)
+{
+  // Check null pointer
+  CB_CHECK_NULL(ring);
+
+  // Ring is empty when head and tail meet
+  if (LOAD_ACQUIRE(ring->head) == LOAD_ACQUIRE(ring->tail))
+  {
+    return CB_ENUM_EMPTY;
+  }
+
+  // Ring is not empty return failure
+  return CB_ENUM_FAILURE;
+} // ringbuf_empty()
@@ -11,6 +11,9 @@
 #include <setjmp.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
 #include <cmocka.h>
 #include "circbuf.h"
 #include "project_defs.h"
@@ -19,10 +22,33 @@
 
 #define BUF_SIZE (100)
 #define HALF_BUF_SIZE (BUF_SIZE / 2)
+#define GROW_START (4)
+#define GROW_MAX (1 << 17)
+#define GROW_QUIET (8)
 
 // Result used in most tests
 circbuf_t * buf = NULL;
 
+// Items passed to the drop function
+static uint32_t drop_count = 0;
+static void * drop_last = NULL;
+
+// Histogram buckets passed to the stats print function
+static uint64_t dumped[CB_STATS_BUCKETS];
+
+// Print function for stats tests, records each bucket
+static void bucket_func(void * data, uint32_t index)
+{
+  dumped[index] = *(uint64_t *)data;
+} // bucket_func()
+
+// Drop function for overwrite tests, records the dropped item
+static void drop_func(void * data)
+{
+  drop_count++;
+  drop_last = data;
+} // drop_func()
+
 void test_circbuf_init_destroy(void **state)
 {
   // Create circbuf and check there were no errors
@@ -47,6 +73,8 @@ void test_circbuf_ops_null_ptr(void **state)
   assert_int_equal(circbuf_peek((circbuf_t *)NULL, 1, (void **)&p_value), CB_ENUM_NULL_POINTER);
   assert_int_equal(circbuf_empty((circbuf_t *)NULL), CB_ENUM_NULL_POINTER);
   assert_int_equal(circbuf_full((circbuf_t *)NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_set_overwrite((circbuf_t *)NULL, 1, NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_dropped((circbuf_t *)NULL, NULL), CB_ENUM_NULL_POINTER);
 } // test_circbuf_init_null_ptr()
 
 void test_circbuf_null_buffer(void **state)
@@ -261,3 +289,414 @@ void test_circbuf_check_empty(void **state)
   // Destroy circbuf and check there were no errors
   assert_int_equal(circbuf_destroy(buf), CB_ENUM_NO_ERROR);
 } // test_circbuf_check_full()
+
+void test_circbuf_add_remove_items(void **state)
+{
+  uint8_t value[BUF_SIZE] = {0};
+  void * payloads[BUF_SIZE];
+  void * removed[BUF_SIZE];
+  uint8_t * p_value;
+  uint32_t count;
+
+  // Create circbuf and check there were no errors
+  assert_int_equal(circbuf_init(&buf, BUF_SIZE), CB_ENUM_NO_ERROR);
+  for (uint32_t i = 0; i < BUF_SIZE; i++)
+  {
+    value[i] = i;
+    payloads[i] = &value[i];
+  }
+
+  // Removing from an empty buffer removes nothing
+  assert_int_equal(circbuf_remove_items(buf, removed, BUF_SIZE, &count), CB_ENUM_EMPTY);
+  assert_int_equal(count, 0);
+
+  // Add a few single items then move tail to the middle with a batch remove
+  for (uint32_t i = 0; i < HALF_BUF_SIZE; i++)
+  {
+    assert_int_equal(circbuf_add_item(buf, payloads[i]), CB_ENUM_NO_ERROR);
+  }
+  assert_int_equal(circbuf_remove_items(buf, removed, HALF_BUF_SIZE, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(count, HALF_BUF_SIZE);
+  assert_memory_equal(removed, payloads, HALF_BUF_SIZE * sizeof(void *));
+
+  // Add a single item then a batch bigger than the room left, which wraps
+  // head and only adds what fits
+  assert_int_equal(circbuf_add_item(buf, payloads[0]), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_add_items(buf, payloads + 1, BUF_SIZE, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(count, BUF_SIZE - 1);
+  assert_int_equal(circbuf_full(buf), CB_ENUM_FULL);
+  assert_int_equal(circbuf_add_items(buf, payloads, 1, &count), CB_ENUM_FULL);
+  assert_int_equal(count, 0);
+
+  // Remove one single item then the rest in a batch which wraps tail
+  assert_int_equal(circbuf_remove_item(buf, (void **)&p_value), CB_ENUM_NO_ERROR);
+  assert_int_equal(*p_value, value[0]);
+  assert_int_equal(circbuf_remove_items(buf, removed, BUF_SIZE, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(count, BUF_SIZE - 1);
+  assert_memory_equal(removed, payloads + 1, (BUF_SIZE - 1) * sizeof(void *));
+  assert_int_equal(circbuf_empty(buf), CB_ENUM_EMPTY);
+
+  // Single operations still work after batch operations emptied the buffer
+  assert_int_equal(circbuf_add_item(buf, payloads[1]), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_remove_item(buf, (void **)&p_value), CB_ENUM_NO_ERROR);
+  assert_int_equal(*p_value, value[1]);
+
+  // Destroy circbuf and check there were no errors
+  assert_int_equal(circbuf_destroy(buf), CB_ENUM_NO_ERROR);
+} // test_circbuf_add_remove_items()
+
+void test_circbuf_peek_spans(void **state)
+{
+  uint8_t value[BUF_SIZE] = {0};
+  uint8_t * p_value;
+  cb_span_t first;
+  cb_span_t second;
+
+  // Create circbuf and check there were no errors
+  assert_int_equal(circbuf_init(&buf, BUF_SIZE), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_peek_spans(buf, &first, &second), CB_ENUM_EMPTY);
+  assert_int_equal(first.count + second.count, 0);
+
+  // Without a wrap everything is in the first span
+  for (uint32_t i = 0; i < HALF_BUF_SIZE; i++)
+  {
+    value[i] = i;
+    assert_int_equal(circbuf_add_item(buf, (void *)&value[i]), CB_ENUM_NO_ERROR);
+  }
+  assert_int_equal(circbuf_peek_spans(buf, &first, &second), CB_ENUM_NO_ERROR);
+  assert_int_equal(first.count, HALF_BUF_SIZE);
+  assert_int_equal(second.count, 0);
+  assert_ptr_equal(first.items[0], &value[0]);
+
+  // Move tail to the middle and fill the buffer so it wraps
+  for (uint32_t i = 0; i < HALF_BUF_SIZE; i++)
+  {
+    assert_int_equal(circbuf_remove_item(buf, (void **)&p_value), CB_ENUM_NO_ERROR);
+  }
+  for (uint32_t i = 0; i < BUF_SIZE; i++)
+  {
+    value[i] = i;
+    assert_int_equal(circbuf_add_item(buf, (void *)&value[i]), CB_ENUM_NO_ERROR);
+  }
+
+  // Spans must cover every item in order across the wrap
+  assert_int_equal(circbuf_peek_spans(buf, &first, &second), CB_ENUM_NO_ERROR);
+  assert_int_equal(first.count + second.count, BUF_SIZE);
+  assert_int_not_equal(second.count, 0);
+  for (uint32_t i = 0; i < BUF_SIZE; i++)
+  {
+    p_value = (i < first.count) ? first.items[i] : second.items[i - first.count];
+    assert_int_equal(*p_value, value[i]);
+  }
+
+  // Destroy circbuf and check there were no errors
+  assert_int_equal(circbuf_destroy(buf), CB_ENUM_NO_ERROR);
+} // test_circbuf_peek_spans()
+
+void test_circbuf_overwrite(void **state)
+{
+  uint32_t value[BUF_SIZE + HALF_BUF_SIZE];
+  uint32_t * p_value;
+  uint64_t dropped;
+
+  // Create circbuf in overwrite mode with a drop function
+  assert_int_equal(circbuf_init(&buf, BUF_SIZE), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_set_overwrite(buf, 1, drop_func), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_dropped(buf, NULL), CB_ENUM_NULL_POINTER);
+  drop_count = 0;
+
+  // Fill the buffer and keep adding, the adds never fail
+  for (uint32_t i = 0; i < BUF_SIZE + HALF_BUF_SIZE; i++)
+  {
+    value[i] = i;
+    assert_int_equal(circbuf_add_item(buf, (void *)&value[i]), CB_ENUM_NO_ERROR);
+  }
+  assert_int_equal(circbuf_full(buf), CB_ENUM_FULL);
+
+  // The oldest half buffer was dropped in order
+  assert_int_equal(circbuf_dropped(buf, &dropped), CB_ENUM_NO_ERROR);
+  assert_int_equal(dropped, HALF_BUF_SIZE);
+  assert_int_equal(drop_count, HALF_BUF_SIZE);
+  assert_ptr_equal(drop_last, &value[HALF_BUF_SIZE - 1]);
+
+  // Only the newest items remain
+  for (uint32_t i = HALF_BUF_SIZE; i < BUF_SIZE + HALF_BUF_SIZE; i++)
+  {
+    assert_int_equal(circbuf_remove_item(buf, (void **)&p_value), CB_ENUM_NO_ERROR);
+    assert_int_equal(*p_value, value[i]);
+  }
+  assert_int_equal(circbuf_empty(buf), CB_ENUM_EMPTY);
+
+  // Turning overwrite off restores the full error and keeps the count
+  assert_int_equal(circbuf_set_overwrite(buf, 0, NULL), CB_ENUM_NO_ERROR);
+  for (uint32_t i = 0; i < BUF_SIZE; i++)
+  {
+    assert_int_equal(circbuf_add_item(buf, (void *)&value[i]), CB_ENUM_NO_ERROR);
+  }
+  assert_int_equal(circbuf_add_item(buf, (void *)&value[0]), CB_ENUM_FULL);
+  assert_int_equal(circbuf_dropped(buf, &dropped), CB_ENUM_NO_ERROR);
+  assert_int_equal(dropped, HALF_BUF_SIZE);
+
+  // Destroy circbuf and check there were no errors
+  assert_int_equal(circbuf_destroy(buf), CB_ENUM_NO_ERROR);
+} // test_circbuf_overwrite()
+
+void test_circbuf_overwrite_items(void **state)
+{
+  uint32_t value[BUF_SIZE * 2];
+  void * payloads[BUF_SIZE * 2];
+  void * removed[BUF_SIZE];
+  uint32_t count;
+  uint64_t dropped;
+
+  for (uint32_t i = 0; i < BUF_SIZE * 2; i++)
+  {
+    value[i] = i;
+    payloads[i] = &value[i];
+  }
+
+  // Create circbuf in overwrite mode without a drop function
+  assert_int_equal(circbuf_init(&buf, BUF_SIZE), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_set_overwrite(buf, 1, NULL), CB_ENUM_NO_ERROR);
+
+  // Half fill then add a full buffer which wraps and drops the first half
+  assert_int_equal(circbuf_add_items(buf, payloads, HALF_BUF_SIZE, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_add_items(buf, payloads + HALF_BUF_SIZE, BUF_SIZE, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(count, BUF_SIZE);
+  assert_int_equal(circbuf_dropped(buf, &dropped), CB_ENUM_NO_ERROR);
+  assert_int_equal(dropped, HALF_BUF_SIZE);
+  assert_int_equal(circbuf_remove_items(buf, removed, BUF_SIZE, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(count, BUF_SIZE);
+  assert_memory_equal(removed, payloads + HALF_BUF_SIZE, BUF_SIZE * sizeof(void *));
+
+  // A batch larger than the buffer keeps only its newest items
+  assert_int_equal(circbuf_set_overwrite(buf, 1, drop_func), CB_ENUM_NO_ERROR);
+  drop_count = 0;
+  assert_int_equal(circbuf_add_item(buf, payloads[0]), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_add_items(buf, payloads, BUF_SIZE * 2, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(count, BUF_SIZE);
+  assert_int_equal(drop_count, BUF_SIZE + 1);
+  assert_int_equal(circbuf_dropped(buf, &dropped), CB_ENUM_NO_ERROR);
+  assert_int_equal(dropped, HALF_BUF_SIZE + BUF_SIZE + 1);
+  assert_int_equal(circbuf_remove_items(buf, removed, BUF_SIZE, &count), CB_ENUM_NO_ERROR);
+  assert_memory_equal(removed, payloads + BUF_SIZE, BUF_SIZE * sizeof(void *));
+
+  // Destroy circbuf and check there were no errors
+  assert_int_equal(circbuf_destroy(buf), CB_ENUM_NO_ERROR);
+} // test_circbuf_overwrite_items()
+
+void test_circbuf_notify(void **state)
+{
+  uint32_t value[BUF_SIZE];
+  void * payloads[BUF_SIZE];
+  uint8_t * p_value;
+  circbuf_t * other = NULL;
+  struct pollfd pfd;
+  uint64_t signals;
+  uint32_t count;
+  int fd;
+
+  for (uint32_t i = 0; i < BUF_SIZE; i++)
+  {
+    payloads[i] = &value[i];
+  }
+
+  // Attach one eventfd to two buffers
+  fd = eventfd(0, EFD_NONBLOCK);
+  assert_true(fd >= 0);
+  assert_int_equal(circbuf_set_notify(NULL, fd, CB_NOTIFY_NOT_EMPTY), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_init(&buf, BUF_SIZE), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_init(&other, BUF_SIZE), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_set_notify(buf, fd, CB_NOTIFY_NOT_EMPTY | CB_NOTIFY_NOT_FULL), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_set_notify(other, fd, CB_NOTIFY_NOT_EMPTY), CB_ENUM_NO_ERROR);
+  pfd.fd = fd;
+  pfd.events = POLLIN;
+
+  // Nothing is readable until an item is added
+  assert_int_equal(poll(&pfd, 1, 0), 0);
+
+  // A burst of adds to one buffer signals once
+  for (uint32_t i = 0; i < HALF_BUF_SIZE; i++)
+  {
+    assert_int_equal(circbuf_add_item(other, payloads[i]), CB_ENUM_NO_ERROR);
+  }
+  assert_int_equal(poll(&pfd, 1, 0), 1);
+  assert_int_equal(read(fd, &signals, sizeof(signals)), sizeof(signals));
+  assert_int_equal(signals, 1);
+  assert_int_equal(read(fd, &signals, sizeof(signals)), -1);
+
+  // Filling the other buffer in single and batch adds signals once
+  assert_int_equal(circbuf_add_item(buf, payloads[0]), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_add_items(buf, payloads + 1, BUF_SIZE - 1, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(read(fd, &signals, sizeof(signals)), sizeof(signals));
+  assert_int_equal(signals, 1);
+
+  // Removing from a full buffer signals once, further removes do not
+  assert_int_equal(circbuf_remove_item(buf, (void **)&p_value), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_remove_items(buf, payloads, HALF_BUF_SIZE, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(read(fd, &signals, sizeof(signals)), sizeof(signals));
+  assert_int_equal(signals, 1);
+
+  // Refill then batch remove from full signals once
+  assert_int_equal(circbuf_add_items(buf, payloads, BUF_SIZE, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_remove_items(buf, payloads, BUF_SIZE, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(read(fd, &signals, sizeof(signals)), sizeof(signals));
+  assert_int_equal(signals, 1);
+
+  // A detached buffer no longer signals
+  assert_int_equal(circbuf_set_notify(other, -1, CB_NOTIFY_NOT_EMPTY), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_remove_items(other, payloads, BUF_SIZE, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_add_item(other, payloads[0]), CB_ENUM_NO_ERROR);
+  assert_int_equal(poll(&pfd, 1, 0), 0);
+
+  // Empty batches neither fill nor free anything so they do not signal
+  assert_int_equal(circbuf_add_items(buf, payloads, 0, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(count, 0);
+  assert_int_equal(poll(&pfd, 1, 0), 0);
+  assert_int_equal(circbuf_add_items(buf, payloads, BUF_SIZE, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(read(fd, &signals, sizeof(signals)), sizeof(signals));
+  assert_int_equal(circbuf_remove_items(buf, payloads, 0, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(count, 0);
+  assert_int_equal(poll(&pfd, 1, 0), 0);
+
+  // A growable buffer below its max length was never full so removes
+  // from it do not signal
+  assert_int_equal(circbuf_destroy(other), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_init_growable(&other, HALF_BUF_SIZE, BUF_SIZE, 0), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_set_notify(other, fd, CB_NOTIFY_NOT_FULL), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_add_items(other, payloads, HALF_BUF_SIZE, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_remove_item(other, (void **)&p_value), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_add_item(other, p_value), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_remove_items(other, payloads, HALF_BUF_SIZE, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(poll(&pfd, 1, 0), 0);
+
+  // Destroy circbufs and check there were no errors
+  assert_int_equal(circbuf_destroy(buf), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_destroy(other), CB_ENUM_NO_ERROR);
+  close(fd);
+} // test_circbuf_notify()
+
+void test_circbuf_growable(void **state)
+{
+  void * payloads[BUF_SIZE];
+  void * payload;
+  uint32_t length;
+  uint32_t count;
+
+  // Sizes are checked
+  assert_int_equal(circbuf_init_growable(NULL, GROW_START, GROW_MAX, GROW_QUIET), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_init_growable(&buf, 0, GROW_MAX, GROW_QUIET), CB_ENUM_NO_LENGTH);
+  assert_int_equal(circbuf_init_growable(&buf, GROW_START, GROW_START - 1, GROW_QUIET), CB_ENUM_NO_LENGTH);
+  assert_int_equal(circbuf_length(NULL, &length), CB_ENUM_NULL_POINTER);
+
+  // Wrap the contents of a small buffer before it has to grow
+  assert_int_equal(circbuf_init_growable(&buf, GROW_START, GROW_MAX, GROW_QUIET), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_add_item(buf, (void *)0), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_add_item(buf, (void *)0), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_remove_item(buf, &payload), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_remove_item(buf, &payload), CB_ENUM_NO_ERROR);
+
+  // Adds never fail until the max length, items stay in order
+  for (uintptr_t i = 0; i < GROW_MAX; i++)
+  {
+    assert_int_equal(circbuf_add_item(buf, (void *)i), CB_ENUM_NO_ERROR);
+  }
+  assert_int_equal(circbuf_length(buf, &length), CB_ENUM_NO_ERROR);
+  assert_int_equal(length, GROW_MAX);
+  assert_int_equal(circbuf_full(buf), CB_ENUM_FULL);
+  assert_int_equal(circbuf_add_item(buf, (void *)0), CB_ENUM_FULL);
+  for (uintptr_t i = 0; i < GROW_MAX; i++)
+  {
+    assert_int_equal(circbuf_remove_item(buf, &payload), CB_ENUM_NO_ERROR);
+    assert_ptr_equal(payload, (void *)i);
+  }
+
+  // The buffer shrinks back to its starting length once it is quiet
+  for (uint32_t i = 0; i < GROW_QUIET * 32; i++)
+  {
+    assert_int_equal(circbuf_add_item(buf, (void *)0), CB_ENUM_NO_ERROR);
+    assert_int_equal(circbuf_remove_item(buf, &payload), CB_ENUM_NO_ERROR);
+  }
+  assert_int_equal(circbuf_length(buf, &length), CB_ENUM_NO_ERROR);
+  assert_int_equal(length, GROW_START);
+
+  // Batch adds grow to fit the whole batch
+  for (uintptr_t i = 0; i < BUF_SIZE; i++)
+  {
+    payloads[i] = (void *)i;
+  }
+  assert_int_equal(circbuf_add_items(buf, payloads, BUF_SIZE, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(count, BUF_SIZE);
+  for (uintptr_t i = 0; i < BUF_SIZE; i++)
+  {
+    assert_int_equal(circbuf_peek(buf, i, &payload), CB_ENUM_NO_ERROR);
+    assert_ptr_equal(payload, (void *)i);
+  }
+
+  // Destroy circbuf and check there were no errors
+  assert_int_equal(circbuf_destroy(buf), CB_ENUM_NO_ERROR);
+} // test_circbuf_growable()
+
+void test_circbuf_stats(void **state)
+{
+  void * payloads[BUF_SIZE] = {0};
+  void * payload;
+  cb_stats_t stats;
+  uint64_t samples = 0;
+  uint32_t count;
+
+  // Null pointers are rejected
+  assert_int_equal(circbuf_stats(NULL, &stats), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_stats_reset(NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_stats_dump(NULL, bucket_func), CB_ENUM_NULL_POINTER);
+
+  // A new buffer has no statistics
+  assert_int_equal(circbuf_init(&buf, BUF_SIZE), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_stats(buf, &stats), CB_ENUM_NO_ERROR);
+  assert_int_equal(stats.adds + stats.removes + stats.full + stats.empty, 0);
+  assert_int_equal(stats.high_water, 0);
+
+  // Fill in single adds and one batch, then get rejected once
+  for (uint32_t i = 0; i < HALF_BUF_SIZE; i++)
+  {
+    assert_int_equal(circbuf_add_item(buf, payloads[i]), CB_ENUM_NO_ERROR);
+  }
+  assert_int_equal(circbuf_add_items(buf, payloads, BUF_SIZE, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_add_item(buf, payloads[0]), CB_ENUM_FULL);
+
+  // Drain half in a batch and the rest one at a time, then get rejected
+  assert_int_equal(circbuf_remove_items(buf, payloads, HALF_BUF_SIZE, &count), CB_ENUM_NO_ERROR);
+  while (circbuf_remove_item(buf, &payload) == CB_ENUM_NO_ERROR);
+
+  // Counters match the calls made
+  assert_int_equal(circbuf_stats(buf, &stats), CB_ENUM_NO_ERROR);
+  assert_int_equal(stats.adds, BUF_SIZE);
+  assert_int_equal(stats.removes, BUF_SIZE);
+  assert_int_equal(stats.full, 1);
+  assert_int_equal(stats.empty, 1);
+  assert_int_equal(stats.high_water, BUF_SIZE);
+
+  // Every successful call is one histogram sample, the last remove left
+  // the buffer empty and the batch add left it full
+  for (uint32_t i = 0; i < CB_STATS_BUCKETS; i++)
+  {
+    samples += stats.histogram[i];
+  }
+  assert_int_equal(samples, HALF_BUF_SIZE + 1 + 1 + HALF_BUF_SIZE);
+  assert_true(stats.histogram[0] > 0);
+  assert_true(stats.histogram[CB_STATS_BUCKETS - 1] > 0);
+
+  // Dump passes each bucket to the print function
+  assert_int_equal(circbuf_stats_dump(buf, bucket_func), CB_ENUM_NO_ERROR);
+  assert_memory_equal(dumped, stats.histogram, sizeof(dumped));
+
+  // Reset clears everything, high water restarts at the current count
+  assert_int_equal(circbuf_add_item(buf, payloads[0]), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_stats_reset(buf), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_stats(buf, &stats), CB_ENUM_NO_ERROR);
+  assert_int_equal(stats.adds + stats.removes + stats.full + stats.empty, 0);
+  assert_int_equal(stats.high_water, 1);
+
+  // Destroy circbuf and check there were no errors
+  assert_int_equal(circbuf_destroy(buf), CB_ENUM_NO_ERROR);
+} // test_circbuf_stats()
@@ -0,0 +1,205 @@
+/** @file unit_circbuf_mpmc.c
+*
+* @brief Unit tests for circbuf mpmc
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <cmocka.h>
+#include "circbuf_mpmc.h"
+#include "project_defs.h"
+#include "unit_circbuf_mpmc.h"
+#include "log.h"
+
+#define BUF_SIZE (64)
+#define HALF_BUF_SIZE (BUF_SIZE / 2)
+#define THREADS (4)
+#define THREAD_ITEMS (50000)
+
+// Shared state for the threaded test
+static circbuf_mpmc_t * mpmc;
+static uint64_t consumed_sum;
+static uint32_t consumed_count;
+
+/*
+ * \brief mpmc_producer: Thread adding THREAD_ITEMS values
+ *
+ * \param param: not used
+ * \return: NULL
+ *
+ */
+static void * mpmc_producer(void * param)
+{
+  for (uintptr_t i = 1; i <= THREAD_ITEMS; i++)
+  {
+    while (circbuf_mpmc_add_item(mpmc, (void *)i) == CB_ENUM_FULL)
+    {
+      sched_yield();
+    }
+  }
+
+  return NULL;
+} // mpmc_producer()
+
+/*
+ * \brief mpmc_consumer: Thread removing items until all have been consumed
+ *
+ * \param param: not used
+ * \return: NULL
+ *
+ */
+static void * mpmc_consumer(void * param)
+{
+  void * payload;
+
+  while (__atomic_load_n(&consumed_count, __ATOMIC_RELAXED) < THREADS * THREAD_ITEMS)
+  {
+    if (circbuf_mpmc_remove_item(mpmc, &payload) == CB_ENUM_NO_ERROR)
+    {
+      __atomic_fetch_add(&consumed_sum, (uintptr_t)payload, __ATOMIC_RELAXED);
+      __atomic_fetch_add(&consumed_count, 1, __ATOMIC_RELAXED);
+    }
+    else
+    {
+      sched_yield();
+    }
+  }
+
+  return NULL;
+} // mpmc_consumer()
+
+void test_circbuf_mpmc_init_destroy(void **state)
+{
+  circbuf_mpmc_t * buf = NULL;
+
+  // Create circbuf and check there were no errors
+  assert_int_equal(circbuf_mpmc_init(&buf, BUF_SIZE), CB_ENUM_NO_ERROR);
+
+  // Zero length is not allowed
+  assert_int_equal(circbuf_mpmc_init(&buf, 0), CB_ENUM_NO_LENGTH);
+
+  // Destroy circbuf and check there were no errors
+  assert_int_equal(circbuf_mpmc_destroy(buf), CB_ENUM_NO_ERROR);
+} // test_circbuf_mpmc_init_destroy()
+
+void test_circbuf_mpmc_ops_null_ptr(void **state)
+{
+  uint8_t value = 0;
+  uint8_t * p_value = &value;
+  circbuf_mpmc_t * buf = NULL;
+
+  // Pass a null pointer into each function and make sure they return
+  // null pointer enum
+  assert_int_equal(circbuf_mpmc_init((circbuf_mpmc_t **)NULL, BUF_SIZE), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_mpmc_destroy((circbuf_mpmc_t *)NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_mpmc_add_item((circbuf_mpmc_t *)NULL, &value), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_mpmc_remove_item((circbuf_mpmc_t *)NULL, (void **)&p_value), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_mpmc_full((circbuf_mpmc_t *)NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_mpmc_empty((circbuf_mpmc_t *)NULL), CB_ENUM_NULL_POINTER);
+
+  // Payload pointer must be valid for remove
+  assert_int_equal(circbuf_mpmc_init(&buf, BUF_SIZE), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_mpmc_remove_item(buf, NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_mpmc_destroy(buf), CB_ENUM_NO_ERROR);
+} // test_circbuf_mpmc_ops_null_ptr()
+
+void test_circbuf_mpmc_add_remove_full(void **state)
+{
+  uint8_t value[BUF_SIZE] = {0};
+  uint8_t insert = 100;
+  uint8_t * p_value;
+  circbuf_mpmc_t * buf = NULL;
+
+  // Create a circbuf and check it starts empty
+  assert_int_equal(circbuf_mpmc_init(&buf, BUF_SIZE), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_mpmc_empty(buf), CB_ENUM_EMPTY);
+  assert_int_equal(circbuf_mpmc_remove_item(buf, (void **)&p_value), CB_ENUM_EMPTY);
+
+  // Move head and tail to the middle so the fill below wraps
+  for (uint32_t i = 0; i < HALF_BUF_SIZE; i++)
+  {
+    assert_int_equal(circbuf_mpmc_add_item(buf, (void *)&value[i]), CB_ENUM_NO_ERROR);
+    assert_int_equal(circbuf_mpmc_remove_item(buf, (void **)&p_value), CB_ENUM_NO_ERROR);
+  }
+
+  // Fill the buffer, one more item must be rejected
+  for (uint32_t i = 0; i < BUF_SIZE; i++)
+  {
+    value[i] = i;
+    assert_int_equal(circbuf_mpmc_add_item(buf, (void *)&value[i]), CB_ENUM_NO_ERROR);
+  }
+  assert_int_equal(circbuf_mpmc_full(buf), CB_ENUM_FULL);
+  assert_int_equal(circbuf_mpmc_add_item(buf, (void *)&insert), CB_ENUM_FULL);
+
+  // Drain in order
+  for (uint32_t i = 0; i < BUF_SIZE; i++)
+  {
+    assert_int_equal(circbuf_mpmc_remove_item(buf, (void **)&p_value), CB_ENUM_NO_ERROR);
+    assert_int_equal(*p_value, value[i]);
+  }
+  assert_int_equal(circbuf_mpmc_empty(buf), CB_ENUM_EMPTY);
+
+  // Destroy circbuf and check there were no errors
+  assert_int_equal(circbuf_mpmc_destroy(buf), CB_ENUM_NO_ERROR);
+} // test_circbuf_mpmc_add_remove_full()
+
+void test_circbuf_mpmc_length_one(void **state)
+{
+  uint8_t value[3] = {1, 2, 3};
+  uint8_t * p_value;
+  circbuf_mpmc_t * buf = NULL;
+
+  // A length of one still gets two slots, the third add is rejected
+  // instead of overwriting an item that was never removed
+  assert_int_equal(circbuf_mpmc_init(&buf, 1), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_mpmc_add_item(buf, (void *)&value[0]), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_mpmc_add_item(buf, (void *)&value[1]), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_mpmc_full(buf), CB_ENUM_FULL);
+  assert_int_equal(circbuf_mpmc_add_item(buf, (void *)&value[2]), CB_ENUM_FULL);
+
+  // Both items come back in order and the buffer then reports empty
+  assert_int_equal(circbuf_mpmc_remove_item(buf, (void **)&p_value), CB_ENUM_NO_ERROR);
+  assert_ptr_equal(p_value, &value[0]);
+  assert_int_equal(circbuf_mpmc_remove_item(buf, (void **)&p_value), CB_ENUM_NO_ERROR);
+  assert_ptr_equal(p_value, &value[1]);
+  assert_int_equal(circbuf_mpmc_remove_item(buf, (void **)&p_value), CB_ENUM_EMPTY);
+
+  assert_int_equal(circbuf_mpmc_destroy(buf), CB_ENUM_NO_ERROR);
+} // test_circbuf_mpmc_length_one()
+
+void test_circbuf_mpmc_threads(void **state)
+{
+  pthread_t producers[THREADS];
+  pthread_t consumers[THREADS];
+  uint64_t expected = (uint64_t)THREADS * THREAD_ITEMS * (THREAD_ITEMS + 1) / 2;
+
+  // Use a small buffer so both full and empty are hit often
+  consumed_sum = 0;
+  consumed_count = 0;
+  assert_int_equal(circbuf_mpmc_init(&mpmc, 16), CB_ENUM_NO_ERROR);
+
+  for (uint32_t i = 0; i < THREADS; i++)
+  {
+    assert_int_equal(pthread_create(&producers[i], NULL, mpmc_producer, NULL), 0);
+    assert_int_equal(pthread_create(&consumers[i], NULL, mpmc_consumer, NULL), 0);
+  }
+  for (uint32_t i = 0; i < THREADS; i++)
+  {
+    assert_int_equal(pthread_join(producers[i], NULL), 0);
+    assert_int_equal(pthread_join(consumers[i], NULL), 0);
+  }
+
+  // Every item must have been consumed exactly once
+  assert_int_equal(consumed_count, THREADS * THREAD_ITEMS);
+  assert_int_equal(consumed_sum, expected);
+  assert_int_equal(circbuf_mpmc_empty(mpmc), CB_ENUM_EMPTY);
+  assert_int_equal(circbuf_mpmc_destroy(mpmc), CB_ENUM_NO_ERROR);
+} // test_circbuf_mpmc_threads()
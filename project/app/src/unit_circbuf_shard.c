@@ -0,0 +1,314 @@
+/** @file unit_circbuf_shard.c
+*
+* @brief Unit tests for circbuf shard
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <cmocka.h>
+#include "circbuf_shard.h"
+#include "project_defs.h"
+#include "unit_circbuf_shard.h"
+#include "log.h"
+
+#define SHARDS (4)
+#define SHARD_SIZE (4)
+#define POOL_SIZE (SHARDS * SHARD_SIZE)
+#define BATCH_SHARDS (2)
+#define BATCH_SIZE (2 * CB_SHARD_STEAL_BATCH)
+#define THREADS (4)
+#define THREAD_ITEMS (20000)
+
+// Shared state for the thread test
+typedef struct shard_test
+{
+  circbuf_shard_t * pool;
+  uint32_t next;
+  uint32_t consumed;
+  uint8_t seen[THREADS * THREAD_ITEMS];
+} shard_test_t;
+
+/*
+ * \brief shard_producer: Thread adding THREAD_ITEMS unique values
+ *
+ * \param param: pointer to the shared test state
+ * \return: NULL
+ *
+ */
+static void * shard_producer(void * param)
+{
+  shard_test_t * test = (shard_test_t *)param;
+  uintptr_t value;
+
+  for (uint32_t i = 0; i < THREAD_ITEMS; i++)
+  {
+    value = __atomic_fetch_add(&test->next, 1, __ATOMIC_RELAXED) + 1;
+    while (circbuf_shard_add_item(test->pool, (void *)value) == CB_ENUM_FULL)
+    {
+      sched_yield();
+    }
+  }
+
+  return NULL;
+} // shard_producer()
+
+/*
+ * \brief shard_consumer: Thread removing values until every value has been
+ *                        removed by some consumer
+ *
+ * \param param: pointer to the shared test state
+ * \return: NULL
+ *
+ */
+static void * shard_consumer(void * param)
+{
+  shard_test_t * test = (shard_test_t *)param;
+  void * payload;
+
+  while (__atomic_load_n(&test->consumed, __ATOMIC_RELAXED) < THREADS * THREAD_ITEMS)
+  {
+    if (circbuf_shard_remove_item(test->pool, &payload) == CB_ENUM_NO_ERROR)
+    {
+      __atomic_fetch_add(&test->seen[(uintptr_t)payload - 1], 1, __ATOMIC_RELAXED);
+      __atomic_fetch_add(&test->consumed, 1, __ATOMIC_RELAXED);
+    }
+    else
+    {
+      sched_yield();
+    }
+  }
+
+  return NULL;
+} // shard_consumer()
+
+void test_circbuf_shard_init_destroy(void **state)
+{
+  circbuf_shard_t * pool = NULL;
+  uint32_t shards;
+
+  // Given shard count
+  assert_int_equal(circbuf_shard_init(&pool, SHARDS, SHARD_SIZE), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shard_count(pool, &shards), CB_ENUM_NO_ERROR);
+  assert_int_equal(shards, SHARDS);
+  assert_int_equal(circbuf_shard_empty(pool), CB_ENUM_EMPTY);
+  assert_int_equal(circbuf_shard_destroy(pool), CB_ENUM_NO_ERROR);
+
+  // Default is one shard per CPU
+  assert_int_equal(circbuf_shard_init(&pool, 0, SHARD_SIZE), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shard_count(pool, &shards), CB_ENUM_NO_ERROR);
+  assert_int_equal(shards, sysconf(_SC_NPROCESSORS_ONLN));
+  assert_int_equal(circbuf_shard_destroy(pool), CB_ENUM_NO_ERROR);
+
+  // Zero length is not allowed
+  assert_int_equal(circbuf_shard_init(&pool, SHARDS, 0), CB_ENUM_NO_LENGTH);
+} // test_circbuf_shard_init_destroy()
+
+void test_circbuf_shard_ops_null_ptr(void **state)
+{
+  cb_shard_stats_t stats;
+  void * payload;
+  uint32_t count;
+
+  // Pass a null pointer into each function and make sure they return
+  // null pointer enum
+  assert_int_equal(circbuf_shard_init((circbuf_shard_t **)NULL, SHARDS, SHARD_SIZE), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_shard_destroy((circbuf_shard_t *)NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_shard_add_item((circbuf_shard_t *)NULL, &payload), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_shard_remove_item((circbuf_shard_t *)NULL, &payload), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_shard_add_items((circbuf_shard_t *)NULL, &payload, 1, &count), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_shard_remove_items((circbuf_shard_t *)NULL, &payload, 1, &count), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_shard_empty((circbuf_shard_t *)NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_shard_count((circbuf_shard_t *)NULL, &count), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_shard_stats((circbuf_shard_t *)NULL, &stats), CB_ENUM_NULL_POINTER);
+} // test_circbuf_shard_ops_null_ptr()
+
+void test_circbuf_shard_spill_steal(void **state)
+{
+  circbuf_shard_t * pool = NULL;
+  void * payloads[POOL_SIZE + 1];
+  uint8_t seen[POOL_SIZE] = {0};
+  cb_shard_stats_t stats;
+  void * payload;
+  uint32_t count;
+
+  for (uintptr_t i = 0; i < POOL_SIZE + 1; i++)
+  {
+    payloads[i] = (void *)i;
+  }
+
+  // Adds spill over every shard until the whole pool is full
+  assert_int_equal(circbuf_shard_init(&pool, SHARDS, SHARD_SIZE), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shard_add_items(pool, payloads, POOL_SIZE + 1, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(count, POOL_SIZE);
+  assert_int_equal(circbuf_shard_add_item(pool, payloads[0]), CB_ENUM_FULL);
+
+  // One batch remove drains the local shard and steals the rest
+  assert_int_equal(circbuf_shard_remove_items(pool, payloads, POOL_SIZE, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(count, POOL_SIZE);
+  for (uint32_t i = 0; i < POOL_SIZE; i++)
+  {
+    seen[(uintptr_t)payloads[i]]++;
+  }
+  for (uint32_t i = 0; i < POOL_SIZE; i++)
+  {
+    assert_int_equal(seen[i], 1);
+  }
+  assert_int_equal(circbuf_shard_stats(pool, &stats), CB_ENUM_NO_ERROR);
+  assert_int_equal(stats.steals, SHARDS - 1);
+  assert_int_equal(stats.stolen, POOL_SIZE - SHARD_SIZE);
+  assert_int_equal(stats.failed_steals, 0);
+
+  // Removing from an empty pool is a failed steal
+  assert_int_equal(circbuf_shard_remove_item(pool, &payload), CB_ENUM_EMPTY);
+  assert_int_equal(circbuf_shard_stats(pool, &stats), CB_ENUM_NO_ERROR);
+  assert_int_equal(stats.failed_steals, 1);
+
+  assert_int_equal(circbuf_shard_destroy(pool), CB_ENUM_NO_ERROR);
+} // test_circbuf_shard_spill_steal()
+
+void test_circbuf_shard_batch_steal(void **state)
+{
+  circbuf_shard_t * pool = NULL;
+  void * payloads[BATCH_SHARDS * BATCH_SIZE];
+  uint8_t seen[BATCH_SHARDS * BATCH_SIZE] = {0};
+  cb_shard_stats_t stats;
+  uint32_t count;
+  uint32_t removed;
+
+  for (uintptr_t i = 0; i < BATCH_SHARDS * BATCH_SIZE; i++)
+  {
+    payloads[i] = (void *)i;
+  }
+
+  // Fill both shards then drain the local one without stealing
+  assert_int_equal(circbuf_shard_init(&pool, BATCH_SHARDS, BATCH_SIZE), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shard_add_items(pool, payloads, BATCH_SHARDS * BATCH_SIZE, &count),
+                   CB_ENUM_NO_ERROR);
+  assert_int_equal(count, BATCH_SHARDS * BATCH_SIZE);
+  assert_int_equal(circbuf_shard_remove_items(pool, payloads, BATCH_SIZE, &removed), CB_ENUM_NO_ERROR);
+  assert_int_equal(removed, BATCH_SIZE);
+  assert_int_equal(circbuf_shard_stats(pool, &stats), CB_ENUM_NO_ERROR);
+  assert_int_equal(stats.steals, 0);
+
+  // A single remove on the dry shard steals a whole batch
+  assert_int_equal(circbuf_shard_remove_item(pool, &payloads[removed++]), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shard_stats(pool, &stats), CB_ENUM_NO_ERROR);
+  assert_int_equal(stats.steals, 1);
+  assert_int_equal(stats.stolen, 1 + CB_SHARD_STEAL_BATCH);
+
+  // The next removes are served from the batch without stealing again
+  for (uint32_t i = 0; i < CB_SHARD_STEAL_BATCH; i++)
+  {
+    assert_int_equal(circbuf_shard_remove_item(pool, &payloads[removed++]), CB_ENUM_NO_ERROR);
+  }
+  assert_int_equal(circbuf_shard_stats(pool, &stats), CB_ENUM_NO_ERROR);
+  assert_int_equal(stats.steals, 1);
+
+  // The second steal takes what is left, the pool is not empty while the
+  // stolen items are still held for this CPU
+  assert_int_equal(circbuf_shard_remove_item(pool, &payloads[removed++]), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shard_stats(pool, &stats), CB_ENUM_NO_ERROR);
+  assert_int_equal(stats.steals, 2);
+  assert_int_equal(stats.stolen, BATCH_SIZE);
+  assert_int_equal(circbuf_shard_empty(pool), CB_ENUM_FAILURE);
+  while (removed < BATCH_SHARDS * BATCH_SIZE)
+  {
+    assert_int_equal(circbuf_shard_remove_item(pool, &payloads[removed++]), CB_ENUM_NO_ERROR);
+  }
+  assert_int_equal(circbuf_shard_empty(pool), CB_ENUM_EMPTY);
+  assert_int_equal(circbuf_shard_remove_item(pool, &payloads[0]), CB_ENUM_EMPTY);
+  assert_int_equal(circbuf_shard_stats(pool, &stats), CB_ENUM_NO_ERROR);
+  assert_int_equal(stats.steals, 2);
+  assert_int_equal(stats.failed_steals, 1);
+
+  // Every item came out exactly once
+  for (uint32_t i = 0; i < BATCH_SHARDS * BATCH_SIZE; i++)
+  {
+    seen[(uintptr_t)payloads[i]]++;
+  }
+  for (uint32_t i = 0; i < BATCH_SHARDS * BATCH_SIZE; i++)
+  {
+    assert_int_equal(seen[i], 1);
+  }
+
+  assert_int_equal(circbuf_shard_destroy(pool), CB_ENUM_NO_ERROR);
+} // test_circbuf_shard_batch_steal()
+
+void test_circbuf_shard_threads(void **state)
+{
+  pthread_t producers[THREADS];
+  pthread_t consumers[THREADS];
+  shard_test_t * test;
+
+  // Use small shards so adds spill and removes steal often
+  test = calloc(1, sizeof(shard_test_t));
+  assert_non_null(test);
+  assert_int_equal(circbuf_shard_init(&test->pool, SHARDS, SHARD_SIZE), CB_ENUM_NO_ERROR);
+  for (uint32_t i = 0; i < THREADS; i++)
+  {
+    assert_int_equal(pthread_create(&producers[i], NULL, shard_producer, test), 0);
+    assert_int_equal(pthread_create(&consumers[i], NULL, shard_consumer, test), 0);
+  }
+  for (uint32_t i = 0; i < THREADS; i++)
+  {
+    assert_int_equal(pthread_join(producers[i], NULL), 0);
+    assert_int_equal(pthread_join(consumers[i], NULL), 0);
+  }
+
+  // Every value was removed exactly once
+  for (uint32_t i = 0; i < THREADS * THREAD_ITEMS; i++)
+  {
+    assert_int_equal(test->seen[i], 1);
+  }
+  assert_int_equal(circbuf_shard_empty(test->pool), CB_ENUM_EMPTY);
+  assert_int_equal(circbuf_shard_destroy(test->pool), CB_ENUM_NO_ERROR);
+  free(test);
+} // test_circbuf_shard_threads()
+
+void test_circbuf_shard_steal_order(void **state)
+{
+  circbuf_shard_t * pool = NULL;
+  void * payloads[BATCH_SHARDS * BATCH_SIZE];
+  uint32_t count;
+
+  for (uintptr_t i = 0; i < BATCH_SHARDS * BATCH_SIZE; i++)
+  {
+    payloads[i] = (void *)i;
+  }
+
+  // Fill shard 0 with the first half and shard 1 with the second
+  assert_int_equal(circbuf_shard_init(&pool, BATCH_SHARDS, BATCH_SIZE), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shard_set_home(pool, 0), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shard_add_items(pool, payloads, BATCH_SIZE, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shard_set_home(pool, 1), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shard_add_items(pool, &payloads[BATCH_SIZE], BATCH_SIZE, &count),
+                   CB_ENUM_NO_ERROR);
+
+  // Drain shard 0 then steal the oldest of shard 1 into the spill of 0
+  assert_int_equal(circbuf_shard_set_home(pool, 0), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shard_remove_items(pool, payloads, BATCH_SIZE + 1, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(count, BATCH_SIZE + 1);
+  assert_ptr_equal(payloads[BATCH_SIZE], (void *)BATCH_SIZE);
+
+  // A consumer that moves to shard 1 still gets its items in order, the
+  // spilled ones before the rest of its ring
+  assert_int_equal(circbuf_shard_set_home(pool, 1), CB_ENUM_NO_ERROR);
+  for (uintptr_t i = BATCH_SIZE + 1; i < BATCH_SHARDS * BATCH_SIZE; i++)
+  {
+    assert_int_equal(circbuf_shard_remove_item(pool, &payloads[0]), CB_ENUM_NO_ERROR);
+    assert_ptr_equal(payloads[0], (void *)i);
+  }
+  assert_int_equal(circbuf_shard_empty(pool), CB_ENUM_EMPTY);
+
+  assert_int_equal(circbuf_shard_destroy(pool), CB_ENUM_NO_ERROR);
+} // test_circbuf_shard_steal_order()
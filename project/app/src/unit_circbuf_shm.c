@@ -0,0 +1,261 @@
+/** @file unit_circbuf_shm.c
+*
+* @brief Unit tests for circbuf shm
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cmocka.h>
+#include "circbuf_shm.h"
+#include "project_defs.h"
+#include "unit_circbuf_shm.h"
+#include "log.h"
+
+#define BUF_SIZE (16)
+#define FORK_ITEMS (100000)
+
+// Item copied through the buffer
+typedef struct shm_item
+{
+  uint32_t sequence;
+  uint32_t check;
+  uint64_t data;
+} shm_item_t;
+
+void test_circbuf_shm_init_destroy(void **state)
+{
+  circbuf_shm_t * creator = NULL;
+  circbuf_shm_t * opener = NULL;
+  shm_item_t item = {1, 2, 3};
+  shm_item_t removed;
+  char name[32];
+
+  // Create and destroy an anonymous buffer
+  assert_int_equal(circbuf_shm_init(&creator, NULL, BUF_SIZE, sizeof(shm_item_t)), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shm_destroy(creator), CB_ENUM_NO_ERROR);
+
+  // Zero sizes are not allowed
+  assert_int_equal(circbuf_shm_init(&creator, NULL, 0, sizeof(shm_item_t)), CB_ENUM_NO_LENGTH);
+  assert_int_equal(circbuf_shm_init(&creator, NULL, BUF_SIZE, 0), CB_ENUM_NO_LENGTH);
+
+  // Create a named buffer, a second create with the same name fails
+  snprintf(name, sizeof(name), "/unit_circbuf_shm_%d", (int)getpid());
+  assert_int_equal(circbuf_shm_init(&creator, name, BUF_SIZE, sizeof(shm_item_t)), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shm_init(&opener, name, BUF_SIZE, sizeof(shm_item_t)), CB_ENUM_FAILURE);
+
+  // Open it again and pass an item through the second mapping
+  assert_int_equal(circbuf_shm_open(&opener, name), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shm_add_item(creator, &item), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shm_remove_item(opener, &removed), CB_ENUM_NO_ERROR);
+  assert_int_equal(removed.sequence, item.sequence);
+  assert_int_equal(removed.data, item.data);
+  assert_int_equal(circbuf_shm_destroy(opener), CB_ENUM_NO_ERROR);
+
+  // Destroying the creator removes the name
+  assert_int_equal(circbuf_shm_destroy(creator), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shm_open(&opener, name), CB_ENUM_FAILURE);
+} // test_circbuf_shm_init_destroy()
+
+void test_circbuf_shm_ops_null_ptr(void **state)
+{
+  circbuf_shm_t * buf = NULL;
+  shm_item_t item;
+
+  // Pass a null pointer into each function and make sure they return
+  // null pointer enum
+  assert_int_equal(circbuf_shm_init((circbuf_shm_t **)NULL, NULL, BUF_SIZE, 1), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_shm_open((circbuf_shm_t **)NULL, "/name"), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_shm_open(&buf, NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_shm_destroy((circbuf_shm_t *)NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_shm_add_item((circbuf_shm_t *)NULL, &item), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_shm_remove_item((circbuf_shm_t *)NULL, &item), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_shm_add_item_wait((circbuf_shm_t *)NULL, &item), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_shm_remove_item_wait((circbuf_shm_t *)NULL, &item), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_shm_empty((circbuf_shm_t *)NULL), CB_ENUM_NULL_POINTER);
+
+  // Items must be valid
+  assert_int_equal(circbuf_shm_init(&buf, NULL, BUF_SIZE, sizeof(item)), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shm_add_item(buf, NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_shm_remove_item(buf, NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_shm_destroy(buf), CB_ENUM_NO_ERROR);
+} // test_circbuf_shm_ops_null_ptr()
+
+void test_circbuf_shm_add_remove_full(void **state)
+{
+  circbuf_shm_t * buf = NULL;
+  shm_item_t item;
+
+  // Create buffer and check it starts empty
+  assert_int_equal(circbuf_shm_init(&buf, NULL, BUF_SIZE, sizeof(item)), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shm_empty(buf), CB_ENUM_EMPTY);
+  assert_int_equal(circbuf_shm_remove_item(buf, &item), CB_ENUM_EMPTY);
+
+  // Go around the buffer twice filling it and draining it
+  for (uint32_t lap = 0; lap < 2; lap++)
+  {
+    for (uint32_t i = 0; i < BUF_SIZE; i++)
+    {
+      item.sequence = i;
+      item.check = ~i;
+      assert_int_equal(circbuf_shm_add_item(buf, &item), CB_ENUM_NO_ERROR);
+    }
+    assert_int_equal(circbuf_shm_add_item(buf, &item), CB_ENUM_FULL);
+
+    // Items are copies so changing the local item has no effect
+    item.sequence = BUF_SIZE;
+    for (uint32_t i = 0; i < BUF_SIZE; i++)
+    {
+      assert_int_equal(circbuf_shm_remove_item(buf, &item), CB_ENUM_NO_ERROR);
+      assert_int_equal(item.sequence, i);
+      assert_int_equal(item.check, ~i);
+    }
+    assert_int_equal(circbuf_shm_empty(buf), CB_ENUM_EMPTY);
+  }
+
+  // Destroy buffer and check there were no errors
+  assert_int_equal(circbuf_shm_destroy(buf), CB_ENUM_NO_ERROR);
+} // test_circbuf_shm_add_remove_full()
+
+void test_circbuf_shm_fork(void **state)
+{
+  circbuf_shm_t * buf = NULL;
+  shm_item_t item;
+  pid_t pid;
+  int status;
+
+  // Create an anonymous buffer the child inherits
+  assert_int_equal(circbuf_shm_init(&buf, NULL, BUF_SIZE, sizeof(item)), CB_ENUM_NO_ERROR);
+
+  // Child produces items blocking when the buffer is full
+  pid = fork();
+  assert_int_not_equal(pid, -1);
+  if (pid == 0)
+  {
+    for (uint32_t i = 0; i < FORK_ITEMS; i++)
+    {
+      item.sequence = i;
+      item.check = ~i;
+      item.data = (uint64_t)i * i;
+      if (circbuf_shm_add_item_wait(buf, &item) != CB_ENUM_NO_ERROR)
+      {
+        _exit(1);
+      }
+    }
+    _exit(0);
+  }
+
+  // Parent consumes items blocking when the buffer is empty
+  for (uint32_t i = 0; i < FORK_ITEMS; i++)
+  {
+    assert_int_equal(circbuf_shm_remove_item_wait(buf, &item), CB_ENUM_NO_ERROR);
+    assert_int_equal(item.sequence, i);
+    assert_int_equal(item.check, ~i);
+    assert_int_equal(item.data, (uint64_t)i * i);
+  }
+
+  // Child must have exited cleanly
+  assert_int_equal(waitpid(pid, &status, 0), pid);
+  assert_true(WIFEXITED(status));
+  assert_int_equal(WEXITSTATUS(status), 0);
+  assert_int_equal(circbuf_shm_destroy(buf), CB_ENUM_NO_ERROR);
+} // test_circbuf_shm_fork()
+
+void test_circbuf_shm_open_checks(void **state)
+{
+  circbuf_shm_t * creator = NULL;
+  circbuf_shm_t * opener = NULL;
+  char name[32];
+  pid_t pid;
+  int status;
+  int fd;
+
+  // A segment that was never set up as a buffer is refused
+  snprintf(name, sizeof(name), "/unit_circbuf_shm_chk_%d", (int)getpid());
+  fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+  assert_true(fd >= 0);
+  assert_int_equal(ftruncate(fd, 4096), 0);
+  assert_int_equal(circbuf_shm_open(&opener, name), CB_ENUM_FAILURE);
+  close(fd);
+  shm_unlink(name);
+
+  // A valid header on a segment cut short is refused
+  assert_int_equal(circbuf_shm_init(&creator, name, BUF_SIZE, sizeof(shm_item_t)), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shm_open(&opener, name), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shm_destroy(opener), CB_ENUM_NO_ERROR);
+  fd = shm_open(name, O_RDWR, 0);
+  assert_true(fd >= 0);
+  assert_int_equal(ftruncate(fd, 3 * CB_CACHE_LINE_SIZE + sizeof(shm_item_t)), 0);
+  close(fd);
+  assert_int_equal(circbuf_shm_open(&opener, name), CB_ENUM_FAILURE);
+  assert_int_equal(circbuf_shm_destroy(creator), CB_ENUM_NO_ERROR);
+
+  // A child destroying its inherited handle leaves the name in place
+  assert_int_equal(circbuf_shm_init(&creator, name, BUF_SIZE, sizeof(shm_item_t)), CB_ENUM_NO_ERROR);
+  pid = fork();
+  assert_int_not_equal(pid, -1);
+  if (pid == 0)
+  {
+    _exit(circbuf_shm_destroy(creator) != CB_ENUM_NO_ERROR);
+  }
+  assert_int_equal(waitpid(pid, &status, 0), pid);
+  assert_true(WIFEXITED(status));
+  assert_int_equal(WEXITSTATUS(status), 0);
+  assert_int_equal(circbuf_shm_open(&opener, name), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shm_destroy(opener), CB_ENUM_NO_ERROR);
+
+  // Only the creator removes it
+  assert_int_equal(circbuf_shm_destroy(creator), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shm_open(&opener, name), CB_ENUM_FAILURE);
+} // test_circbuf_shm_open_checks()
+
+void test_circbuf_shm_peer_header(void **state)
+{
+  circbuf_shm_t * creator = NULL;
+  circbuf_shm_t * opener = NULL;
+  shm_item_t item = {1, 2, 3};
+  shm_item_t removed;
+  uint32_t * words;
+  uint32_t info;
+  char name[32];
+  int fd;
+
+  // Map the header a second time to play a peer that rewrites it
+  snprintf(name, sizeof(name), "/unit_circbuf_shm_peer_%d", (int)getpid());
+  assert_int_equal(circbuf_shm_init(&creator, name, BUF_SIZE, sizeof(shm_item_t)), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shm_open(&opener, name), CB_ENUM_NO_ERROR);
+  fd = shm_open(name, O_RDWR, 0);
+  assert_true(fd >= 0);
+  words = mmap(NULL, 3 * CB_CACHE_LINE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  assert_true(words != MAP_FAILED);
+
+  // Huge sizes written after open do not change the copies
+  info = 2 * CB_CACHE_LINE_SIZE / sizeof(uint32_t);
+  words[info + 1] = UINT32_MAX;
+  words[info + 2] = UINT32_MAX;
+  assert_int_equal(circbuf_shm_add_item(creator, &item), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shm_remove_item(opener, &removed), CB_ENUM_NO_ERROR);
+  assert_memory_equal(&item, &removed, sizeof(shm_item_t));
+
+  // Out of range indices are refused instead of picking a slot
+  words[0] = UINT32_MAX;
+  assert_int_equal(circbuf_shm_add_item(creator, &item), CB_ENUM_FAILURE);
+  words[CB_CACHE_LINE_SIZE / sizeof(uint32_t)] = UINT32_MAX;
+  assert_int_equal(circbuf_shm_remove_item(opener, &removed), CB_ENUM_FAILURE);
+
+  munmap(words, 3 * CB_CACHE_LINE_SIZE);
+  assert_int_equal(circbuf_shm_destroy(opener), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_shm_destroy(creator), CB_ENUM_NO_ERROR);
+} // test_circbuf_shm_peer_header()
@@ -0,0 +1,275 @@
+/** @file unit_circbuf_spsc.c
+*
+* @brief Unit tests for circbuf spsc
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <time.h>
+#include <cmocka.h>
+#include "circbuf_spsc.h"
+#include "project_defs.h"
+#include "unit_circbuf_spsc.h"
+#include "log.h"
+
+#define BUF_SIZE (100)
+#define HALF_BUF_SIZE (BUF_SIZE / 2)
+#define THREAD_ITEMS (100000)
+
+/*
+ * \brief spsc_producer: Thread adding THREAD_ITEMS increasing values
+ *
+ * \param param: pointer to the spsc circular buffer
+ * \return: NULL
+ *
+ */
+static void * spsc_producer(void * param)
+{
+  circbuf_spsc_t * spsc = (circbuf_spsc_t *)param;
+
+  for (uintptr_t i = 1; i <= THREAD_ITEMS; i++)
+  {
+    while (circbuf_spsc_add_item(spsc, (void *)i) == CB_ENUM_FULL)
+    {
+      sched_yield();
+    }
+  }
+
+  return NULL;
+} // spsc_producer()
+
+void test_circbuf_spsc_init_destroy(void **state)
+{
+  circbuf_spsc_t * spsc = NULL;
+
+  // Create circbuf and check there were no errors
+  assert_int_equal(circbuf_spsc_init(&spsc, BUF_SIZE), CB_ENUM_NO_ERROR);
+
+  // Zero length is not allowed
+  assert_int_equal(circbuf_spsc_init(&spsc, 0), CB_ENUM_NO_LENGTH);
+
+  // Destroy circbuf and check there were no errors
+  assert_int_equal(circbuf_spsc_destroy(spsc), CB_ENUM_NO_ERROR);
+} // test_circbuf_spsc_init_destroy()
+
+void test_circbuf_spsc_ops_null_ptr(void **state)
+{
+  uint8_t value = 0;
+  uint8_t * p_value = &value;
+  circbuf_spsc_t * spsc = NULL;
+
+  // Pass a null pointer into each function and make sure they return
+  // null pointer enum
+  assert_int_equal(circbuf_spsc_init((circbuf_spsc_t **)NULL, BUF_SIZE), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_spsc_destroy((circbuf_spsc_t *)NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_spsc_add_item((circbuf_spsc_t *)NULL, &value), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_spsc_remove_item((circbuf_spsc_t *)NULL, (void **)&p_value), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_spsc_full((circbuf_spsc_t *)NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_spsc_empty((circbuf_spsc_t *)NULL), CB_ENUM_NULL_POINTER);
+
+  // Payload pointer must be valid for remove
+  assert_int_equal(circbuf_spsc_init(&spsc, BUF_SIZE), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_spsc_remove_item(spsc, NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_spsc_destroy(spsc), CB_ENUM_NO_ERROR);
+} // test_circbuf_spsc_ops_null_ptr()
+
+void test_circbuf_spsc_add_remove_full(void **state)
+{
+  uint8_t value[BUF_SIZE] = {0};
+  uint8_t insert = 100;
+  uint8_t * p_value;
+  circbuf_spsc_t * spsc = NULL;
+
+  // Create a circbuf and check it starts empty
+  assert_int_equal(circbuf_spsc_init(&spsc, BUF_SIZE), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_spsc_empty(spsc), CB_ENUM_EMPTY);
+  assert_int_equal(circbuf_spsc_remove_item(spsc, (void **)&p_value), CB_ENUM_EMPTY);
+
+  // Fill the buffer to the requested length
+  for (uint32_t i = 0; i < BUF_SIZE; i++)
+  {
+    value[i] = i;
+    assert_int_equal(circbuf_spsc_add_item(spsc, (void *)&value[i]), CB_ENUM_NO_ERROR);
+  }
+
+  // One more item must be rejected
+  assert_int_equal(circbuf_spsc_full(spsc), CB_ENUM_FULL);
+  assert_int_equal(circbuf_spsc_add_item(spsc, (void *)&insert), CB_ENUM_FULL);
+
+  // Drain in order
+  for (uint32_t i = 0; i < BUF_SIZE; i++)
+  {
+    assert_int_equal(circbuf_spsc_remove_item(spsc, (void **)&p_value), CB_ENUM_NO_ERROR);
+    assert_int_equal(*p_value, value[i]);
+  }
+  assert_int_equal(circbuf_spsc_empty(spsc), CB_ENUM_EMPTY);
+
+  // Destroy circbuf and check there were no errors
+  assert_int_equal(circbuf_spsc_destroy(spsc), CB_ENUM_NO_ERROR);
+} // test_circbuf_spsc_add_remove_full()
+
+void test_circbuf_spsc_wrap(void **state)
+{
+  uint8_t value[BUF_SIZE] = {0};
+  uint8_t * p_value;
+  circbuf_spsc_t * spsc = NULL;
+
+  // Create circbuf and check there were no errors
+  assert_int_equal(circbuf_spsc_init(&spsc, BUF_SIZE), CB_ENUM_NO_ERROR);
+
+  // Move head and tail to the middle of the buffer
+  for (uint32_t i = 0; i < HALF_BUF_SIZE; i++)
+  {
+    assert_int_equal(circbuf_spsc_add_item(spsc, (void *)&value[i]), CB_ENUM_NO_ERROR);
+  }
+  for (uint32_t i = 0; i < HALF_BUF_SIZE; i++)
+  {
+    assert_int_equal(circbuf_spsc_remove_item(spsc, (void **)&p_value), CB_ENUM_NO_ERROR);
+  }
+
+  // Fill the buffer which wraps head, then drain it which wraps tail
+  for (uint32_t i = 0; i < BUF_SIZE; i++)
+  {
+    value[i] = i;
+    assert_int_equal(circbuf_spsc_add_item(spsc, (void *)&value[i]), CB_ENUM_NO_ERROR);
+  }
+  assert_int_equal(circbuf_spsc_full(spsc), CB_ENUM_FULL);
+  for (uint32_t i = 0; i < BUF_SIZE; i++)
+  {
+    assert_int_equal(circbuf_spsc_remove_item(spsc, (void **)&p_value), CB_ENUM_NO_ERROR);
+    assert_int_equal(*p_value, value[i]);
+  }
+
+  // Destroy circbuf and check there were no errors
+  assert_int_equal(circbuf_spsc_destroy(spsc), CB_ENUM_NO_ERROR);
+} // test_circbuf_spsc_wrap()
+
+void test_circbuf_spsc_threads(void **state)
+{
+  pthread_t producer;
+  void * payload;
+  uintptr_t expected = 1;
+  circbuf_spsc_t * spsc = NULL;
+
+  // Use a small buffer so both full and empty are hit often
+  assert_int_equal(circbuf_spsc_init(&spsc, 16), CB_ENUM_NO_ERROR);
+  assert_int_equal(pthread_create(&producer, NULL, spsc_producer, spsc), 0);
+
+  // Consume every item checking nothing is lost or reordered
+  while (expected <= THREAD_ITEMS)
+  {
+    if (circbuf_spsc_remove_item(spsc, &payload) == CB_ENUM_NO_ERROR)
+    {
+      assert_int_equal((uintptr_t)payload, expected);
+      expected++;
+    }
+    else
+    {
+      sched_yield();
+    }
+  }
+
+  assert_int_equal(pthread_join(producer, NULL), 0);
+  assert_int_equal(circbuf_spsc_empty(spsc), CB_ENUM_EMPTY);
+  assert_int_equal(circbuf_spsc_destroy(spsc), CB_ENUM_NO_ERROR);
+} // test_circbuf_spsc_threads()
+
+/*
+ * \brief spsc_wait_producer: Thread adding THREAD_ITEMS increasing values,
+ *                           sleeping while the buffer is full
+ *
+ * \param param: pointer to the spsc circular buffer
+ * \return: NULL
+ *
+ */
+static void * spsc_wait_producer(void * param)
+{
+  circbuf_spsc_t * spsc = (circbuf_spsc_t *)param;
+
+  for (uintptr_t i = 1; i <= THREAD_ITEMS; i++)
+  {
+    circbuf_spsc_add_item_wait(spsc, (void *)i, NULL);
+  }
+
+  return NULL;
+} // spsc_wait_producer()
+
+void test_circbuf_spsc_wait_timeout(void **state)
+{
+  struct timespec timeout = {0, 10000000};
+  struct timespec start;
+  struct timespec end;
+  void * payload;
+  circbuf_spsc_t * spsc = NULL;
+  int64_t elapsed;
+
+  // Null buffers are rejected before waiting
+  assert_int_equal(circbuf_spsc_add_item_wait(NULL, NULL, &timeout), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_spsc_remove_item_wait(NULL, &payload, &timeout), CB_ENUM_NULL_POINTER);
+
+  // Removing from an empty buffer waits out the timeout
+  assert_int_equal(circbuf_spsc_init(&spsc, 1), CB_ENUM_NO_ERROR);
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  assert_int_equal(circbuf_spsc_remove_item_wait(spsc, &payload, &timeout), CB_ENUM_EMPTY);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  elapsed = (end.tv_sec - start.tv_sec) * 1000000000LL + end.tv_nsec - start.tv_nsec;
+  assert_true(elapsed >= timeout.tv_nsec);
+
+  // Adding to a full buffer waits out the timeout
+  assert_int_equal(circbuf_spsc_add_item_wait(spsc, (void *)1, &timeout), CB_ENUM_NO_ERROR);
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  assert_int_equal(circbuf_spsc_add_item_wait(spsc, (void *)2, &timeout), CB_ENUM_FULL);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  elapsed = (end.tv_sec - start.tv_sec) * 1000000000LL + end.tv_nsec - start.tv_nsec;
+  assert_true(elapsed >= timeout.tv_nsec);
+
+  // A zero timeout does not block and items are still there
+  timeout.tv_nsec = 0;
+  assert_int_equal(circbuf_spsc_add_item_wait(spsc, (void *)2, &timeout), CB_ENUM_FULL);
+  assert_int_equal(circbuf_spsc_remove_item_wait(spsc, &payload, &timeout), CB_ENUM_NO_ERROR);
+  assert_ptr_equal(payload, (void *)1);
+  assert_int_equal(circbuf_spsc_remove_item_wait(spsc, &payload, &timeout), CB_ENUM_EMPTY);
+
+  // Timeouts futex_wait would refuse are rejected instead of spinning
+  timeout.tv_nsec = 1000000000;
+  assert_int_equal(circbuf_spsc_remove_item_wait(spsc, &payload, &timeout), CB_ENUM_FAILURE);
+  assert_int_equal(circbuf_spsc_add_item_wait(spsc, (void *)1, &timeout), CB_ENUM_FAILURE);
+  timeout.tv_nsec = -1;
+  assert_int_equal(circbuf_spsc_remove_item_wait(spsc, &payload, &timeout), CB_ENUM_FAILURE);
+  timeout.tv_sec = -1;
+  timeout.tv_nsec = 0;
+  assert_int_equal(circbuf_spsc_add_item_wait(spsc, (void *)1, &timeout), CB_ENUM_FAILURE);
+  assert_int_equal(circbuf_spsc_empty(spsc), CB_ENUM_EMPTY);
+
+  assert_int_equal(circbuf_spsc_destroy(spsc), CB_ENUM_NO_ERROR);
+} // test_circbuf_spsc_wait_timeout()
+
+void test_circbuf_spsc_wait_threads(void **state)
+{
+  pthread_t producer;
+  void * payload;
+  circbuf_spsc_t * spsc = NULL;
+
+  // Use a small buffer so both sides sleep often
+  assert_int_equal(circbuf_spsc_init(&spsc, 16), CB_ENUM_NO_ERROR);
+  assert_int_equal(pthread_create(&producer, NULL, spsc_wait_producer, spsc), 0);
+
+  // Consume every item checking nothing is lost or reordered
+  for (uintptr_t expected = 1; expected <= THREAD_ITEMS; expected++)
+  {
+    assert_int_equal(circbuf_spsc_remove_item_wait(spsc, &payload, NULL), CB_ENUM_NO_ERROR);
+    assert_int_equal((uintptr_t)payload, expected);
+  }
+
+  assert_int_equal(pthread_join(producer, NULL), 0);
+  assert_int_equal(circbuf_spsc_empty(spsc), CB_ENUM_EMPTY);
+  assert_int_equal(circbuf_spsc_destroy(spsc), CB_ENUM_NO_ERROR);
+} // test_circbuf_spsc_wait_threads()
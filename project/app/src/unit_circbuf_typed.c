@@ -0,0 +1,110 @@
+/** @file unit_circbuf_typed.c
+*
+* @brief Unit tests for circbuf typed
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <cmocka.h>
+#include "circbuf_typed.h"
+#include "project_defs.h"
+#include "unit_circbuf_typed.h"
+#include "log.h"
+
+#define BUF_SIZE (16)
+
+// Item stored inline in the buffer
+typedef struct sample
+{
+  uint32_t id;
+  uint32_t check;
+  uint64_t value;
+} sample_t;
+
+CIRCBUF_DEFINE(sample_ring, sample_t, BUF_SIZE)
+
+// Statically allocated buffer used in the tests
+static sample_ring_t ring;
+
+void test_circbuf_typed_ops_null_ptr(void **state)
+{
+  sample_t sample;
+
+  // Pass a null pointer into each function and make sure they return
+  // null pointer enum
+  assert_int_equal(sample_ring_init(NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(sample_ring_add_item(NULL, &sample), CB_ENUM_NULL_POINTER);
+  assert_int_equal(sample_ring_add_item(&ring, NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(sample_ring_remove_item(NULL, &sample), CB_ENUM_NULL_POINTER);
+  assert_int_equal(sample_ring_remove_item(&ring, NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(sample_ring_full(NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(sample_ring_empty(NULL), CB_ENUM_NULL_POINTER);
+} // test_circbuf_typed_ops_null_ptr()
+
+void test_circbuf_typed_add_remove_full(void **state)
+{
+  sample_t sample;
+
+  // Initialize and check the buffer starts empty
+  assert_int_equal(sample_ring_init(&ring), CB_ENUM_NO_ERROR);
+  assert_int_equal(sample_ring_empty(&ring), CB_ENUM_EMPTY);
+  assert_int_equal(sample_ring_remove_item(&ring, &sample), CB_ENUM_EMPTY);
+
+  // Go around the buffer a few times filling and draining it
+  for (uint32_t lap = 0; lap < 3; lap++)
+  {
+    for (uint32_t i = 0; i < BUF_SIZE; i++)
+    {
+      sample.id = i;
+      sample.check = ~i;
+      sample.value = (uint64_t)lap << 32 | i;
+      assert_int_equal(sample_ring_add_item(&ring, &sample), CB_ENUM_NO_ERROR);
+      assert_int_equal(sample_ring_count(&ring), i + 1);
+    }
+    assert_int_equal(sample_ring_full(&ring), CB_ENUM_FULL);
+    assert_int_equal(sample_ring_add_item(&ring, &sample), CB_ENUM_FULL);
+
+    for (uint32_t i = 0; i < BUF_SIZE; i++)
+    {
+      assert_int_equal(sample_ring_remove_item(&ring, &sample), CB_ENUM_NO_ERROR);
+      assert_int_equal(sample.id, i);
+      assert_int_equal(sample.check, ~i);
+      assert_int_equal(sample.value, (uint64_t)lap << 32 | i);
+    }
+    assert_int_equal(sample_ring_empty(&ring), CB_ENUM_EMPTY);
+    assert_int_equal(sample_ring_full(&ring), CB_ENUM_FAILURE);
+  }
+} // test_circbuf_typed_add_remove_full()
+
+void test_circbuf_typed_counter_wrap(void **state)
+{
+  sample_t sample = {0};
+
+  // Start the counters just before they wrap
+  assert_int_equal(sample_ring_init(&ring), CB_ENUM_NO_ERROR);
+  ring.head = UINT32_MAX - BUF_SIZE / 2;
+  ring.tail = ring.head;
+
+  // Fill across the wrap, the count must still be right
+  for (uint32_t i = 0; i < BUF_SIZE; i++)
+  {
+    sample.id = i;
+    assert_int_equal(sample_ring_add_item(&ring, &sample), CB_ENUM_NO_ERROR);
+  }
+  assert_int_equal(sample_ring_count(&ring), BUF_SIZE);
+  assert_int_equal(sample_ring_full(&ring), CB_ENUM_FULL);
+
+  // Drain in order
+  for (uint32_t i = 0; i < BUF_SIZE; i++)
+  {
+    assert_int_equal(sample_ring_remove_item(&ring, &sample), CB_ENUM_NO_ERROR);
+    assert_int_equal(sample.id, i);
+  }
+  assert_int_equal(sample_ring_empty(&ring), CB_ENUM_EMPTY);
+} // test_circbuf_typed_counter_wrap()
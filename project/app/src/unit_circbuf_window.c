@@ -0,0 +1,218 @@
+/** @file unit_circbuf_window.c
+*
+* @brief Unit tests for circbuf window
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <math.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <cmocka.h>
+#include "circbuf_window.h"
+#include "project_defs.h"
+#include "unit_circbuf_window.h"
+#include "log.h"
+
+#define WINDOW_SIZE (64)
+#define SAMPLES (WINDOW_SIZE * 20)
+#define LOW (0.0)
+#define HIGH (1000.0)
+#define BUCKETS (100)
+
+/*
+ * \brief window_compare: orders samples for qsort
+ *
+ */
+static int window_compare(const void * a, const void * b)
+{
+  double x = *(const double *)a;
+  double y = *(const double *)b;
+
+  return (x > y) - (x < y);
+} // window_compare()
+
+void test_circbuf_window_ops_null_ptr(void **state)
+{
+  circbuf_window_t * win = NULL;
+  uint32_t count;
+  double value;
+
+  // Pass a null pointer into each function and make sure they return
+  // null pointer enum
+  assert_int_equal(circbuf_window_init(NULL, WINDOW_SIZE, LOW, HIGH, BUCKETS), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_window_destroy(NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_window_add(NULL, 1), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_window_count(NULL, &count), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_window_min(NULL, &value), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_window_max(NULL, &value), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_window_sum(NULL, &value), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_window_mean(NULL, &value), CB_ENUM_NULL_POINTER);
+  assert_int_equal(circbuf_window_percentile(NULL, 50, &value), CB_ENUM_NULL_POINTER);
+
+  // Sizes are checked
+  assert_int_equal(circbuf_window_init(&win, 0, LOW, HIGH, BUCKETS), CB_ENUM_NO_LENGTH);
+  assert_int_equal(circbuf_window_init(&win, WINDOW_SIZE, HIGH, LOW, BUCKETS), CB_ENUM_NO_LENGTH);
+} // test_circbuf_window_ops_null_ptr()
+
+void test_circbuf_window_empty(void **state)
+{
+  circbuf_window_t * win = NULL;
+  uint32_t count;
+  double value;
+
+  // Every query on an empty window returns empty
+  assert_int_equal(circbuf_window_init(&win, WINDOW_SIZE, LOW, HIGH, BUCKETS), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_window_count(win, &count), CB_ENUM_NO_ERROR);
+  assert_int_equal(count, 0);
+  assert_int_equal(circbuf_window_min(win, &value), CB_ENUM_EMPTY);
+  assert_int_equal(circbuf_window_max(win, &value), CB_ENUM_EMPTY);
+  assert_int_equal(circbuf_window_sum(win, &value), CB_ENUM_EMPTY);
+  assert_int_equal(circbuf_window_mean(win, &value), CB_ENUM_EMPTY);
+  assert_int_equal(circbuf_window_percentile(win, 50, &value), CB_ENUM_EMPTY);
+  assert_int_equal(circbuf_window_percentile(win, 101, &value), CB_ENUM_BAD_INDEX);
+  assert_int_equal(circbuf_window_destroy(win), CB_ENUM_NO_ERROR);
+
+  // Without buckets there are no percentiles
+  assert_int_equal(circbuf_window_init(&win, WINDOW_SIZE, LOW, HIGH, 0), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_window_add(win, 1), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_window_percentile(win, 50, &value), CB_ENUM_FAILURE);
+  assert_int_equal(circbuf_window_destroy(win), CB_ENUM_NO_ERROR);
+} // test_circbuf_window_empty()
+
+void test_circbuf_window_aggregates(void **state)
+{
+  circbuf_window_t * win = NULL;
+  double samples[SAMPLES];
+  double min;
+  double max;
+  double sum;
+  double value;
+  uint32_t first;
+  uint32_t count;
+
+  srand(1);
+  for (uint32_t i = 0; i < SAMPLES; i++)
+  {
+    samples[i] = (double)(rand() % 2000) - 500;
+  }
+
+  // After every add the aggregates match a scan of the last samples
+  assert_int_equal(circbuf_window_init(&win, WINDOW_SIZE, LOW, HIGH, BUCKETS), CB_ENUM_NO_ERROR);
+  for (uint32_t i = 0; i < SAMPLES; i++)
+  {
+    assert_int_equal(circbuf_window_add(win, samples[i]), CB_ENUM_NO_ERROR);
+
+    first = (i + 1 > WINDOW_SIZE) ? i + 1 - WINDOW_SIZE : 0;
+    min = samples[first];
+    max = samples[first];
+    sum = 0;
+    for (uint32_t j = first; j <= i; j++)
+    {
+      min = (samples[j] < min) ? samples[j] : min;
+      max = (samples[j] > max) ? samples[j] : max;
+      sum += samples[j];
+    }
+
+    assert_int_equal(circbuf_window_count(win, &count), CB_ENUM_NO_ERROR);
+    assert_int_equal(count, i + 1 - first);
+    assert_int_equal(circbuf_window_min(win, &value), CB_ENUM_NO_ERROR);
+    assert_true(value == min);
+    assert_int_equal(circbuf_window_max(win, &value), CB_ENUM_NO_ERROR);
+    assert_true(value == max);
+    assert_int_equal(circbuf_window_sum(win, &value), CB_ENUM_NO_ERROR);
+    assert_true(value == sum);
+    assert_int_equal(circbuf_window_mean(win, &value), CB_ENUM_NO_ERROR);
+    assert_true(value == sum / count);
+  }
+
+  assert_int_equal(circbuf_window_destroy(win), CB_ENUM_NO_ERROR);
+} // test_circbuf_window_aggregates()
+
+void test_circbuf_window_percentile(void **state)
+{
+  circbuf_window_t * win = NULL;
+  double sorted[WINDOW_SIZE];
+  double samples[SAMPLES];
+  double percents[] = {0, 10, 50, 90, 99, 100};
+  double width = (HIGH - LOW) / BUCKETS;
+  double exact;
+  double value;
+
+  srand(2);
+  for (uint32_t i = 0; i < SAMPLES; i++)
+  {
+    samples[i] = LOW + (HIGH - LOW) * rand() / RAND_MAX;
+  }
+
+  // Fill the window well past its length then compare to a sort of the
+  // last samples
+  assert_int_equal(circbuf_window_init(&win, WINDOW_SIZE, LOW, HIGH, BUCKETS), CB_ENUM_NO_ERROR);
+  for (uint32_t i = 0; i < SAMPLES; i++)
+  {
+    assert_int_equal(circbuf_window_add(win, samples[i]), CB_ENUM_NO_ERROR);
+  }
+  for (uint32_t i = 0; i < WINDOW_SIZE; i++)
+  {
+    sorted[i] = samples[SAMPLES - WINDOW_SIZE + i];
+  }
+  qsort(sorted, WINDOW_SIZE, sizeof(double), window_compare);
+
+  for (uint32_t i = 0; i < sizeof(percents) / sizeof(percents[0]); i++)
+  {
+    exact = sorted[(uint32_t)(percents[i] / 100 * (WINDOW_SIZE - 1))];
+    assert_int_equal(circbuf_window_percentile(win, percents[i], &value), CB_ENUM_NO_ERROR);
+    assert_true(value >= exact - width && value <= exact + width);
+  }
+
+  // Samples out of range are clamped to the window min and max
+  assert_int_equal(circbuf_window_add(win, HIGH * 10), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_window_percentile(win, 100, &value), CB_ENUM_NO_ERROR);
+  assert_true(value == HIGH * 10);
+
+  assert_int_equal(circbuf_window_destroy(win), CB_ENUM_NO_ERROR);
+} // test_circbuf_window_percentile()
+
+void test_circbuf_window_non_finite(void **state)
+{
+  circbuf_window_t * win = NULL;
+  double rejects[] = {NAN, INFINITY, -INFINITY};
+  double value;
+  uint32_t count;
+
+  // Fill the window so a bad sample would also evict one
+  assert_int_equal(circbuf_window_init(&win, WINDOW_SIZE, LOW, HIGH, BUCKETS), CB_ENUM_NO_ERROR);
+  for (uint32_t i = 0; i < WINDOW_SIZE; i++)
+  {
+    assert_int_equal(circbuf_window_add(win, (double)i), CB_ENUM_NO_ERROR);
+  }
+
+  // NaN and both infinities are refused and leave every aggregate alone
+  for (uint32_t i = 0; i < sizeof(rejects) / sizeof(rejects[0]); i++)
+  {
+    assert_int_equal(circbuf_window_add(win, rejects[i]), CB_ENUM_FAILURE);
+    assert_int_equal(circbuf_window_count(win, &count), CB_ENUM_NO_ERROR);
+    assert_int_equal(count, WINDOW_SIZE);
+    assert_int_equal(circbuf_window_min(win, &value), CB_ENUM_NO_ERROR);
+    assert_true(value == 0);
+    assert_int_equal(circbuf_window_max(win, &value), CB_ENUM_NO_ERROR);
+    assert_true(value == WINDOW_SIZE - 1);
+    assert_int_equal(circbuf_window_sum(win, &value), CB_ENUM_NO_ERROR);
+    assert_true(value == WINDOW_SIZE * (WINDOW_SIZE - 1) / 2);
+    assert_int_equal(circbuf_window_percentile(win, 100, &value), CB_ENUM_NO_ERROR);
+    assert_true(value == WINDOW_SIZE - 1);
+  }
+
+  // The window keeps working after a refused sample
+  assert_int_equal(circbuf_window_add(win, WINDOW_SIZE), CB_ENUM_NO_ERROR);
+  assert_int_equal(circbuf_window_min(win, &value), CB_ENUM_NO_ERROR);
+  assert_true(value == 1);
+  assert_int_equal(circbuf_window_max(win, &value), CB_ENUM_NO_ERROR);
+  assert_true(value == WINDOW_SIZE);
+
+  assert_int_equal(circbuf_window_destroy(win), CB_ENUM_NO_ERROR);
+} // test_circbuf_window_non_finite()
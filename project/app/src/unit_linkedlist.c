@@ -11,6 +11,7 @@
 #include <setjmp.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include "cmocka.h"
 #include "linkedlist.h"
@@ -20,6 +21,7 @@
 
 #define LIST_SIZE (100)
 #define HALF_LIST_SIZE (LIST_SIZE / 2)
+#define SORT_SIZE (1001)
 
 // Test structure for inserting and removing
 typedef struct test_data {
@@ -67,6 +69,155 @@ uint8_t compare(void * data1, void * data2)
   }
 }
 
+// Data seen by the print function in order
+static test_data_t * dumped[SORT_SIZE * 2];
+
+/*
+ * \brief less_data1: Orders data structures by data1 only
+ *
+ * \param data1: pointer to the first data structure
+ * \param data2: pointer to the second data structure
+ * \return: 1 if the first sorts before the second
+ *
+ */
+static uint8_t less_data1(void * data1, void * data2)
+{
+  return ((test_data_t *)data1)->data1 < ((test_data_t *)data2)->data1;
+} // less_data1()
+
+/*
+ * \brief dump_data: Records each data structure dumped
+ *
+ * \param data: pointer to the data structure
+ * \param index: index of the data
+ *
+ */
+static void dump_data(void * data, uint32_t index)
+{
+  dumped[index] = data;
+} // dump_data()
+
+/*
+ * \brief check_sorted: Checks a list is ordered by data1 with ties in data3
+ *                      order and that its prev links and tail agree
+ *
+ * \param p_head: pointer to head
+ * \param size: expected size
+ *
+ */
+static void check_sorted(node_t * p_head, int32_t size)
+{
+  ll_cursor_t cursor;
+  test_data_t * p_data;
+  int32_t count;
+
+  assert_int_equal(ll_size(p_head, &count), LL_ENUM_NO_ERROR);
+  assert_int_equal(count, size);
+  assert_int_equal(ll_dump(p_head, dump_data), LL_ENUM_NO_ERROR);
+  for (int32_t i = 1; i < size; i++)
+  {
+    assert_true(dumped[i - 1]->data1 <= dumped[i]->data1);
+    if (dumped[i - 1]->data1 == dumped[i]->data1)
+    {
+      assert_true(dumped[i - 1]->data3 < dumped[i]->data3);
+    }
+  }
+
+  // Walking back from the tail gives the same order
+  assert_int_equal(ll_cursor_last(p_head, &cursor), LL_ENUM_NO_ERROR);
+  for (int32_t i = size - 1; i >= 0; i--)
+  {
+    assert_int_equal(ll_cursor_get(&cursor, (void **)&p_data), LL_ENUM_NO_ERROR);
+    assert_ptr_equal(p_data, dumped[i]);
+    assert_int_equal(ll_cursor_prev(&cursor), LL_ENUM_NO_ERROR);
+  }
+  assert_int_equal(ll_cursor_get(&cursor, (void **)&p_data), LL_ENUM_INDEX_NON_EXISTENT);
+} // check_sorted()
+
+/*
+ * \brief fill_sort_data: Appends SORT_SIZE data structures with random data1
+ *                        and data3 counting up from first
+ *
+ * \param p_head: pointer to head
+ * \param first: data3 of the first structure
+ *
+ */
+static void fill_sort_data(node_t * p_head, uint32_t first)
+{
+  test_data_t * p_data;
+
+  for (uint32_t i = 0; i < SORT_SIZE; i++)
+  {
+    p_data = malloc(sizeof(*p_data));
+    insert_data(p_data);
+    p_data->data1 %= 64;
+    p_data->data3 = first + i;
+    assert_int_equal(ll_insert(p_head, p_data, INSERT_AT_END), LL_ENUM_NO_ERROR);
+  }
+} // fill_sort_data()
+
+/*
+ * \brief check_order: Checks a list holds exactly the expected data in
+ *                     order and that its prev links and tail agree
+ *
+ * \param p_head: pointer to head
+ * \param expected: data in the order it should be on the list
+ * \param size: expected size
+ *
+ */
+static void check_order(node_t * p_head, void ** expected, int32_t size)
+{
+  ll_cursor_t cursor;
+  test_data_t * p_data;
+  int32_t count;
+
+  assert_int_equal(ll_size(p_head, &count), LL_ENUM_NO_ERROR);
+  assert_int_equal(count, size);
+  assert_int_equal(ll_dump(p_head, dump_data), LL_ENUM_NO_ERROR);
+  for (int32_t i = 0; i < size; i++)
+  {
+    assert_ptr_equal(dumped[i], expected[i]);
+  }
+
+  // Walking back from the tail gives the same order
+  assert_int_equal(ll_cursor_last(p_head, &cursor), LL_ENUM_NO_ERROR);
+  for (int32_t i = size - 1; i >= 0; i--)
+  {
+    assert_int_equal(ll_cursor_get(&cursor, (void **)&p_data), LL_ENUM_NO_ERROR);
+    assert_ptr_equal(p_data, expected[i]);
+    assert_int_equal(ll_cursor_prev(&cursor), LL_ENUM_NO_ERROR);
+  }
+  assert_int_equal(ll_cursor_get(&cursor, (void **)&p_data), LL_ENUM_INDEX_NON_EXISTENT);
+} // check_order()
+
+/*
+ * \brief model_splice: Moves a run of entries between two arrays the way
+ *                      ll_splice moves items between lists
+ *
+ * \param to: array moved into
+ * \param to_size: number of entries in to
+ * \param index: index the first moved entry will have
+ * \param from: array moved from
+ * \param from_size: number of entries in from
+ * \param first: index of the first entry to move
+ * \param count: number of entries to move
+ *
+ */
+static void model_splice(void ** to,
+                         int32_t * to_size,
+                         int32_t index,
+                         void ** from,
+                         int32_t * from_size,
+                         int32_t first,
+                         int32_t count)
+{
+  memmove(&to[index + count], &to[index], (*to_size - index) * sizeof(*to));
+  memcpy(&to[index], &from[first], count * sizeof(*to));
+  memmove(&from[first], &from[first + count], (*from_size - first - count) * sizeof(*from));
+  *to_size += count;
+  *from_size -= count;
+} // model_splice()
+
 void test_ll_init_destroy(void **state)
 {
   node_t * p_head = NULL;
@@ -85,6 +236,7 @@ void test_ll_ops_null_ptr(void **state)
   int32_t size = 0;
   int32_t * p_data = &data;
   node_t * p_head = NULL;
+  ll_cursor_t cursor;
 
   // Initialize a good head to test other parameters having NULL pointers
   assert_int_equal(ll_init(&p_head), LL_ENUM_NO_ERROR);
@@ -92,6 +244,7 @@ void test_ll_ops_null_ptr(void **state)
   // Test init/destroy
   assert_int_equal(ll_init((node_t **)NULL), LL_ENUM_NULL_POINTER);
   assert_int_equal(ll_destroy((node_t *)NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_init_pool((node_t **)NULL, 1), LL_ENUM_NULL_POINTER);
 
   // Test insert with null pointers
   assert_int_equal(ll_insert((node_t *)NULL, &data, index), LL_ENUM_NULL_POINTER);
@@ -111,6 +264,38 @@ void test_ll_ops_null_ptr(void **state)
   assert_int_equal(ll_size((node_t *)NULL, &size), LL_ENUM_NULL_POINTER);
   assert_int_equal(ll_size(p_head, NULL), LL_ENUM_NULL_POINTER);
 
+  // Test sort and merge with null pointers
+  assert_int_equal(ll_sort((node_t *)NULL, compare), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_sort(p_head, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_merge((node_t *)NULL, p_head, compare), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_merge(p_head, (node_t *)NULL, compare), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_merge(p_head, p_head, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_merge(p_head, p_head, compare), LL_ENUM_FAILURE);
+
+  // Test bulk operations with null pointers
+  assert_int_equal(ll_from_array((node_t *)NULL, (void **)&p_data, 1, index), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_from_array(p_head, NULL, 1, index), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_to_array((node_t *)NULL, (void **)&p_data, 1, &size), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_to_array(p_head, NULL, 1, &size), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_to_array(p_head, (void **)&p_data, 1, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_splice((node_t *)NULL, 0, p_head, 0, 0), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_splice(p_head, 0, (node_t *)NULL, 0, 0), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_splice(p_head, 0, p_head, 0, 0), LL_ENUM_FAILURE);
+
+  // Test cursor with null pointers
+  assert_int_equal(ll_cursor_first((node_t *)NULL, &cursor), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_cursor_first(p_head, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_cursor_last((node_t *)NULL, &cursor), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_cursor_next(NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_cursor_prev(NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_cursor_first(p_head, &cursor), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_cursor_get(&cursor, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_cursor_index(&cursor, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_cursor_insert_before(&cursor, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_cursor_insert_after(&cursor, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_cursor_remove(&cursor, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_search_cursor(p_head, (void *)&data, compare, NULL), LL_ENUM_NULL_POINTER);
+
   // Destroy the good head
   assert_int_equal(ll_destroy(p_head), LL_ENUM_NO_ERROR);
 } // test_ll_ops_null_ptr()
@@ -269,7 +454,7 @@ void test_ll_size(void **state)
 {
   node_t * p_head = NULL;
   uint32_t num_inserts = random() % HALF_LIST_SIZE;
-  uint32_t num_removes = random() % num_inserts;
+  uint32_t num_removes = 0;
   int32_t size = 0;
   test_data_t * p_data = NULL;
 
@@ -278,6 +463,7 @@ void test_ll_size(void **state)
   {
     num_inserts = random() % HALF_LIST_SIZE;
   }
+  num_removes = random() % num_inserts;
 
   // Create a ll and check there were no errors
   assert_int_equal(ll_init(&p_head), LL_ENUM_NO_ERROR);
@@ -312,3 +498,468 @@ void test_ll_size(void **state)
   // Destroy ll and check there were no errors
   assert_int_equal(ll_destroy(p_head), LL_ENUM_NO_ERROR);
 } // test_ll_size()
+
+void test_ll_pool(void **state)
+{
+  node_t * p_head = NULL;
+  int32_t index = 0;
+  int32_t size = 0;
+  test_data_t * p_data[LIST_SIZE];
+  test_data_t * p_removed_data = NULL;
+
+  // A pool needs at least one node per slab
+  assert_int_equal(ll_init_pool(&p_head, 0), LL_ENUM_FAILURE);
+
+  // Create a pooled ll with small slabs so several are needed
+  assert_int_equal(ll_init_pool(&p_head, 7), LL_ENUM_NO_ERROR);
+  for (uint32_t i = 0; i < LIST_SIZE; i++)
+  {
+    p_data[i] = malloc(sizeof(*p_data[i]));
+    insert_data(p_data[i]);
+    assert_int_equal(ll_insert(p_head, p_data[i], INSERT_AT_END), LL_ENUM_NO_ERROR);
+  }
+  assert_int_equal(ll_size(p_head, &size), LL_ENUM_NO_ERROR);
+  assert_int_equal(size, LIST_SIZE);
+
+  // Remove the front half, the nodes go back to the pool
+  for (uint32_t i = 0; i < HALF_LIST_SIZE; i++)
+  {
+    assert_int_equal(ll_remove(p_head, (void **)&p_removed_data, 0), LL_ENUM_NO_ERROR);
+    assert_ptr_equal(p_removed_data, p_data[i]);
+  }
+
+  // Insert them again at the end reusing the free nodes
+  for (uint32_t i = 0; i < HALF_LIST_SIZE; i++)
+  {
+    assert_int_equal(ll_insert(p_head, p_data[i], INSERT_AT_END), LL_ENUM_NO_ERROR);
+  }
+
+  // Order and size survive node reuse
+  assert_int_equal(ll_size(p_head, &size), LL_ENUM_NO_ERROR);
+  assert_int_equal(size, LIST_SIZE);
+  for (uint32_t i = 0; i < LIST_SIZE; i += 9)
+  {
+    assert_int_equal(ll_search(p_head, p_data[i], compare, &index), LL_ENUM_NO_ERROR);
+    assert_int_equal(index, (i + HALF_LIST_SIZE) % LIST_SIZE);
+  }
+
+  // Destroy frees data and releases the slabs
+  assert_int_equal(ll_destroy(p_head), LL_ENUM_NO_ERROR);
+} // test_ll_pool()
+
+void test_ll_ends(void **state)
+{
+  node_t * p_head = NULL;
+  int32_t size = 0;
+  test_data_t * p_data[LIST_SIZE];
+  test_data_t * p_removed_data = NULL;
+
+  // Create a ll and check removing from an empty list fails
+  assert_int_equal(ll_init(&p_head), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_remove(p_head, (void **)&p_removed_data, REMOVE_AT_END), LL_ENUM_INDEX_TOO_LARGE);
+  for (uint32_t i = 0; i < LIST_SIZE; i++)
+  {
+    p_data[i] = malloc(sizeof(*p_data[i]));
+    insert_data(p_data[i]);
+  }
+
+  // Append the middle of the array then add the ends
+  for (uint32_t i = 1; i < LIST_SIZE - 2; i++)
+  {
+    assert_int_equal(ll_insert(p_head, p_data[i], INSERT_AT_END), LL_ENUM_NO_ERROR);
+  }
+  assert_int_equal(ll_insert(p_head, p_data[LIST_SIZE - 1], INSERT_AT_END), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_insert(p_head, p_data[0], 0), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_insert(p_head, p_data[LIST_SIZE - 2], -2), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_size(p_head, &size), LL_ENUM_NO_ERROR);
+  assert_int_equal(size, LIST_SIZE);
+
+  // Indices out of range in either direction
+  assert_int_equal(ll_insert(p_head, p_data[0], LIST_SIZE + 1), LL_ENUM_INDEX_TOO_LARGE);
+  assert_int_equal(ll_insert(p_head, p_data[0], -LIST_SIZE - 2), LL_ENUM_INDEX_TOO_LARGE);
+  assert_int_equal(ll_remove(p_head, (void **)&p_removed_data, LIST_SIZE), LL_ENUM_INDEX_TOO_LARGE);
+  assert_int_equal(ll_remove(p_head, (void **)&p_removed_data, -LIST_SIZE - 1), LL_ENUM_INDEX_TOO_LARGE);
+
+  // Negative and positive indices name the same nodes
+  assert_int_equal(ll_remove(p_head, (void **)&p_removed_data, -LIST_SIZE), LL_ENUM_NO_ERROR);
+  assert_ptr_equal(p_removed_data, p_data[0]);
+  assert_int_equal(ll_remove(p_head, (void **)&p_removed_data, -3), LL_ENUM_NO_ERROR);
+  assert_ptr_equal(p_removed_data, p_data[LIST_SIZE - 3]);
+  assert_int_equal(ll_remove(p_head, (void **)&p_removed_data, LIST_SIZE - 4), LL_ENUM_NO_ERROR);
+  assert_ptr_equal(p_removed_data, p_data[LIST_SIZE - 2]);
+  free(p_data[0]);
+  free(p_data[LIST_SIZE - 3]);
+  free(p_data[LIST_SIZE - 2]);
+
+  // Pop everything from the end in reverse order
+  for (uint32_t i = LIST_SIZE - 1; i > 0; i--)
+  {
+    if (i == LIST_SIZE - 2 || i == LIST_SIZE - 3)
+    {
+      continue;
+    }
+    assert_int_equal(ll_remove(p_head, (void **)&p_removed_data, REMOVE_AT_END), LL_ENUM_NO_ERROR);
+    assert_ptr_equal(p_removed_data, p_data[i]);
+    free(p_removed_data);
+  }
+  assert_int_equal(ll_size(p_head, &size), LL_ENUM_NO_ERROR);
+  assert_int_equal(size, 0);
+
+  // The tail is back at the head so appends still work
+  p_data[0] = malloc(sizeof(*p_data[0]));
+  assert_int_equal(ll_insert(p_head, p_data[0], INSERT_AT_END), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_remove(p_head, (void **)&p_removed_data, 0), LL_ENUM_NO_ERROR);
+  assert_ptr_equal(p_removed_data, p_data[0]);
+  free(p_removed_data);
+
+  // Destroy ll and check there were no errors
+  assert_int_equal(ll_destroy(p_head), LL_ENUM_NO_ERROR);
+} // test_ll_ends()
+
+void test_ll_cursor(void **state)
+{
+  node_t * p_head = NULL;
+  ll_cursor_t cursor;
+  int32_t index = 0;
+  int32_t size = 0;
+  test_data_t * p_data[LIST_SIZE];
+  test_data_t * p_removed_data = NULL;
+  test_data_t * p_extra = NULL;
+  test_data_t missing;
+
+  // A cursor on an empty list sits at the end
+  assert_int_equal(ll_init(&p_head), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_cursor_first(p_head, &cursor), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_cursor_get(&cursor, (void **)&p_removed_data), LL_ENUM_INDEX_NON_EXISTENT);
+  assert_int_equal(ll_cursor_remove(&cursor, (void **)&p_removed_data), LL_ENUM_INDEX_NON_EXISTENT);
+  assert_int_equal(ll_cursor_last(p_head, &cursor), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_cursor_get(&cursor, (void **)&p_removed_data), LL_ENUM_INDEX_NON_EXISTENT);
+
+  // Build the list through the cursor, inserting before the end appends
+  for (uint32_t i = 0; i < LIST_SIZE; i++)
+  {
+    p_data[i] = malloc(sizeof(*p_data[i]));
+    insert_data(p_data[i]);
+    assert_int_equal(ll_cursor_insert_before(&cursor, p_data[i]), LL_ENUM_NO_ERROR);
+  }
+  assert_int_equal(ll_cursor_index(&cursor, &index), LL_ENUM_NO_ERROR);
+  assert_int_equal(index, LIST_SIZE);
+
+  // Filter out the odd indices in one pass
+  assert_int_equal(ll_cursor_first(p_head, &cursor), LL_ENUM_NO_ERROR);
+  for (uint32_t i = 0; i < LIST_SIZE; i++)
+  {
+    assert_int_equal(ll_cursor_get(&cursor, (void **)&p_removed_data), LL_ENUM_NO_ERROR);
+    assert_ptr_equal(p_removed_data, p_data[i]);
+    if (i % 2)
+    {
+      assert_int_equal(ll_cursor_remove(&cursor, (void **)&p_removed_data), LL_ENUM_NO_ERROR);
+      free(p_removed_data);
+    }
+    else
+    {
+      assert_int_equal(ll_cursor_next(&cursor), LL_ENUM_NO_ERROR);
+    }
+  }
+  assert_int_equal(ll_cursor_get(&cursor, (void **)&p_removed_data), LL_ENUM_INDEX_NON_EXISTENT);
+  assert_int_equal(ll_size(p_head, &size), LL_ENUM_NO_ERROR);
+  assert_int_equal(size, HALF_LIST_SIZE);
+
+  // Walk backward, the index follows the even entries that are left
+  assert_int_equal(ll_cursor_last(p_head, &cursor), LL_ENUM_NO_ERROR);
+  for (int32_t i = HALF_LIST_SIZE - 1; i >= 0; i--)
+  {
+    assert_int_equal(ll_cursor_index(&cursor, &index), LL_ENUM_NO_ERROR);
+    assert_int_equal(index, i);
+    assert_int_equal(ll_cursor_get(&cursor, (void **)&p_removed_data), LL_ENUM_NO_ERROR);
+    assert_ptr_equal(p_removed_data, p_data[i * 2]);
+    assert_int_equal(ll_cursor_prev(&cursor), LL_ENUM_NO_ERROR);
+  }
+
+  // Stepping back off the front lands at the end, then wraps to the front
+  assert_int_equal(ll_cursor_index(&cursor, &index), LL_ENUM_NO_ERROR);
+  assert_int_equal(index, HALF_LIST_SIZE);
+  assert_int_equal(ll_cursor_next(&cursor), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_cursor_get(&cursor, (void **)&p_removed_data), LL_ENUM_NO_ERROR);
+  assert_ptr_equal(p_removed_data, p_data[0]);
+
+  // Search then edit around the match without another walk
+  assert_int_equal(ll_search_cursor(p_head, p_data[10], compare, &cursor), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_cursor_index(&cursor, &index), LL_ENUM_NO_ERROR);
+  assert_int_equal(index, 5);
+  p_extra = malloc(sizeof(*p_extra));
+  insert_data(p_extra);
+  assert_int_equal(ll_cursor_insert_after(&cursor, p_extra), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_search(p_head, p_extra, compare, &index), LL_ENUM_NO_ERROR);
+  assert_int_equal(index, 6);
+  assert_int_equal(ll_cursor_remove(&cursor, (void **)&p_removed_data), LL_ENUM_NO_ERROR);
+  assert_ptr_equal(p_removed_data, p_data[10]);
+  free(p_removed_data);
+  assert_int_equal(ll_cursor_get(&cursor, (void **)&p_removed_data), LL_ENUM_NO_ERROR);
+  assert_ptr_equal(p_removed_data, p_extra);
+
+  // A search that misses leaves an error
+  insert_data(&missing);
+  missing.data3 = p_extra->data3 + 1;
+  assert_int_equal(ll_search_cursor(p_head, &missing, compare, &cursor), LL_DATA_NOT_FOUND);
+
+  // Destroy ll and check there were no errors
+  assert_int_equal(ll_destroy(p_head), LL_ENUM_NO_ERROR);
+} // test_ll_cursor()
+
+void test_ll_sort(void **state)
+{
+  node_t * p_head = NULL;
+  test_data_t * p_data = NULL;
+
+  // Empty and single node lists are already sorted
+  assert_int_equal(ll_init(&p_head), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_sort(p_head, less_data1), LL_ENUM_NO_ERROR);
+  check_sorted(p_head, 0);
+  p_data = malloc(sizeof(*p_data));
+  insert_data(p_data);
+  assert_int_equal(ll_insert(p_head, p_data, INSERT_AT_END), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_sort(p_head, less_data1), LL_ENUM_NO_ERROR);
+  check_sorted(p_head, 1);
+  assert_int_equal(ll_destroy(p_head), LL_ENUM_NO_ERROR);
+
+  // Few distinct keys so equal keys have to keep their order, on a heap
+  // list and a pooled one
+  for (uint32_t pool = 0; pool < 2; pool++)
+  {
+    if (pool)
+    {
+      assert_int_equal(ll_init_pool(&p_head, 16), LL_ENUM_NO_ERROR);
+    }
+    else
+    {
+      assert_int_equal(ll_init(&p_head), LL_ENUM_NO_ERROR);
+    }
+    fill_sort_data(p_head, 0);
+    assert_int_equal(ll_sort(p_head, less_data1), LL_ENUM_NO_ERROR);
+    check_sorted(p_head, SORT_SIZE);
+
+    // Sorting a sorted list changes nothing and the list still works
+    assert_int_equal(ll_sort(p_head, less_data1), LL_ENUM_NO_ERROR);
+    check_sorted(p_head, SORT_SIZE);
+    assert_int_equal(ll_remove(p_head, (void **)&p_data, REMOVE_AT_END), LL_ENUM_NO_ERROR);
+    assert_ptr_equal(p_data, dumped[SORT_SIZE - 1]);
+    free(p_data);
+    assert_int_equal(ll_destroy(p_head), LL_ENUM_NO_ERROR);
+  }
+} // test_ll_sort()
+
+void test_ll_merge(void **state)
+{
+  node_t * p_head = NULL;
+  node_t * p_other = NULL;
+  test_data_t * p_data = NULL;
+  int32_t size = 0;
+
+  // Every mix of heap and pooled lists
+  for (uint32_t pools = 0; pools < 4; pools++)
+  {
+    if (pools & 1)
+    {
+      assert_int_equal(ll_init_pool(&p_head, 16), LL_ENUM_NO_ERROR);
+    }
+    else
+    {
+      assert_int_equal(ll_init(&p_head), LL_ENUM_NO_ERROR);
+    }
+    if (pools & 2)
+    {
+      assert_int_equal(ll_init_pool(&p_other, 16), LL_ENUM_NO_ERROR);
+    }
+    else
+    {
+      assert_int_equal(ll_init(&p_other), LL_ENUM_NO_ERROR);
+    }
+
+    // Merging an empty list changes nothing
+    fill_sort_data(p_head, 0);
+    assert_int_equal(ll_sort(p_head, less_data1), LL_ENUM_NO_ERROR);
+    assert_int_equal(ll_merge(p_head, p_other, less_data1), LL_ENUM_NO_ERROR);
+    check_sorted(p_head, SORT_SIZE);
+
+    // Equal keys from head come first, their data3 is lower
+    fill_sort_data(p_other, SORT_SIZE);
+    assert_int_equal(ll_sort(p_other, less_data1), LL_ENUM_NO_ERROR);
+    assert_int_equal(ll_merge(p_head, p_other, less_data1), LL_ENUM_NO_ERROR);
+    check_sorted(p_head, SORT_SIZE * 2);
+
+    // Other is empty and still usable
+    assert_int_equal(ll_size(p_other, &size), LL_ENUM_NO_ERROR);
+    assert_int_equal(size, 0);
+    p_data = malloc(sizeof(*p_data));
+    insert_data(p_data);
+    assert_int_equal(ll_insert(p_other, p_data, INSERT_AT_END), LL_ENUM_NO_ERROR);
+    assert_int_equal(ll_remove(p_other, (void **)&p_data, REMOVE_AT_END), LL_ENUM_NO_ERROR);
+    free(p_data);
+
+    // Merging into an empty list takes everything
+    assert_int_equal(ll_merge(p_other, p_head, less_data1), LL_ENUM_NO_ERROR);
+    check_sorted(p_other, SORT_SIZE * 2);
+    assert_int_equal(ll_size(p_head, &size), LL_ENUM_NO_ERROR);
+    assert_int_equal(size, 0);
+
+    assert_int_equal(ll_destroy(p_head), LL_ENUM_NO_ERROR);
+    assert_int_equal(ll_destroy(p_other), LL_ENUM_NO_ERROR);
+  }
+} // test_ll_merge()
+
+void test_ll_bulk(void **state)
+{
+  node_t * p_head = NULL;
+  test_data_t * p_data[LIST_SIZE];
+  void * p_batch[LIST_SIZE];
+  void * p_bad[2];
+  int32_t size = 0;
+  int32_t moved = 0;
+
+  for (uint32_t i = 0; i < LIST_SIZE; i++)
+  {
+    p_data[i] = malloc(sizeof(*p_data[i]));
+    insert_data(p_data[i]);
+  }
+
+  // On a heap list and a pooled one
+  for (uint32_t pool = 0; pool < 2; pool++)
+  {
+    if (pool)
+    {
+      assert_int_equal(ll_init_pool(&p_head, 16), LL_ENUM_NO_ERROR);
+    }
+    else
+    {
+      assert_int_equal(ll_init(&p_head), LL_ENUM_NO_ERROR);
+    }
+
+    // Build the list out of order in three arrays: the back, the front then
+    // the middle
+    assert_int_equal(ll_from_array(p_head, (void **)&p_data[40], 60, INSERT_AT_END), LL_ENUM_NO_ERROR);
+    assert_int_equal(ll_from_array(p_head, (void **)&p_data[0], 10, 0), LL_ENUM_NO_ERROR);
+    assert_int_equal(ll_from_array(p_head, (void **)&p_data[10], 30, 10), LL_ENUM_NO_ERROR);
+    check_order(p_head, (void **)p_data, LIST_SIZE);
+
+    // Bad indices, empty arrays and NULL entries leave the list alone
+    assert_int_equal(ll_from_array(p_head, (void **)p_data, 1, LIST_SIZE + 1), LL_ENUM_INDEX_TOO_LARGE);
+    assert_int_equal(ll_from_array(p_head, (void **)p_data, -1, 0), LL_ENUM_INDEX_TOO_LARGE);
+    assert_int_equal(ll_from_array(p_head, (void **)p_data, 0, 0), LL_ENUM_NO_ERROR);
+    p_bad[0] = p_data[0];
+    p_bad[1] = NULL;
+    assert_int_equal(ll_from_array(p_head, p_bad, 2, 0), LL_ENUM_NULL_POINTER);
+    check_order(p_head, (void **)p_data, LIST_SIZE);
+
+    // Drain the list in batches
+    for (uint32_t i = 0; i < LIST_SIZE; i += moved)
+    {
+      assert_int_equal(ll_to_array(p_head, p_batch, 30, &moved), LL_ENUM_NO_ERROR);
+      assert_int_equal(moved, LIST_SIZE - i < 30 ? LIST_SIZE - i : 30);
+      for (int32_t j = 0; j < moved; j++)
+      {
+        assert_ptr_equal(p_batch[j], p_data[i + j]);
+      }
+      check_order(p_head, (void **)&p_data[i + moved], LIST_SIZE - i - moved);
+    }
+    assert_int_equal(ll_to_array(p_head, p_batch, 30, &moved), LL_ENUM_NO_ERROR);
+    assert_int_equal(moved, 0);
+
+    // The emptied list still works
+    assert_int_equal(ll_insert(p_head, p_data[0], INSERT_AT_END), LL_ENUM_NO_ERROR);
+    assert_int_equal(ll_size(p_head, &size), LL_ENUM_NO_ERROR);
+    assert_int_equal(size, 1);
+    assert_int_equal(ll_remove(p_head, p_batch, REMOVE_AT_END), LL_ENUM_NO_ERROR);
+    assert_ptr_equal(p_batch[0], p_data[0]);
+    assert_int_equal(ll_destroy(p_head), LL_ENUM_NO_ERROR);
+  }
+
+  for (uint32_t i = 0; i < LIST_SIZE; i++)
+  {
+    free(p_data[i]);
+  }
+} // test_ll_bulk()
+
+void test_ll_splice(void **state)
+{
+  node_t * p_head = NULL;
+  node_t * p_other = NULL;
+  test_data_t * p_data[LIST_SIZE];
+  void * p_head_model[LIST_SIZE];
+  void * p_other_model[LIST_SIZE];
+  int32_t head_size;
+  int32_t other_size;
+
+  // Every mix of heap and pooled lists
+  for (uint32_t pools = 0; pools < 4; pools++)
+  {
+    if (pools & 1)
+    {
+      assert_int_equal(ll_init_pool(&p_head, 16), LL_ENUM_NO_ERROR);
+    }
+    else
+    {
+      assert_int_equal(ll_init(&p_head), LL_ENUM_NO_ERROR);
+    }
+    if (pools & 2)
+    {
+      assert_int_equal(ll_init_pool(&p_other, 16), LL_ENUM_NO_ERROR);
+    }
+    else
+    {
+      assert_int_equal(ll_init(&p_other), LL_ENUM_NO_ERROR);
+    }
+
+    // Half the data on each list
+    for (uint32_t i = 0; i < LIST_SIZE; i++)
+    {
+      p_data[i] = malloc(sizeof(*p_data[i]));
+      insert_data(p_data[i]);
+    }
+    assert_int_equal(ll_from_array(p_head, (void **)p_data, HALF_LIST_SIZE, 0), LL_ENUM_NO_ERROR);
+    assert_int_equal(ll_from_array(p_other, (void **)&p_data[HALF_LIST_SIZE], HALF_LIST_SIZE, 0), LL_ENUM_NO_ERROR);
+    memcpy(p_head_model, p_data, HALF_LIST_SIZE * sizeof(void *));
+    memcpy(p_other_model, &p_data[HALF_LIST_SIZE], HALF_LIST_SIZE * sizeof(void *));
+    head_size = HALF_LIST_SIZE;
+    other_size = HALF_LIST_SIZE;
+
+    // A run from the middle into the middle
+    assert_int_equal(ll_splice(p_head, 5, p_other, 10, 10), LL_ENUM_NO_ERROR);
+    model_splice(p_head_model, &head_size, 5, p_other_model, &other_size, 10, 10);
+    check_order(p_head, p_head_model, head_size);
+    check_order(p_other, p_other_model, other_size);
+
+    // The last items of other onto the end, by negative indices
+    assert_int_equal(ll_splice(p_head, INSERT_AT_END, p_other, -5, 5), LL_ENUM_NO_ERROR);
+    model_splice(p_head_model, &head_size, head_size, p_other_model, &other_size, other_size - 5, 5);
+    check_order(p_head, p_head_model, head_size);
+    check_order(p_other, p_other_model, other_size);
+
+    // Ranges off either end and empty moves change nothing
+    assert_int_equal(ll_splice(p_head, 0, p_other, 0, other_size + 1), LL_ENUM_INDEX_TOO_LARGE);
+    assert_int_equal(ll_splice(p_head, 0, p_other, -1, 2), LL_ENUM_INDEX_TOO_LARGE);
+    assert_int_equal(ll_splice(p_head, 0, p_other, -other_size - 1, 1), LL_ENUM_INDEX_TOO_LARGE);
+    assert_int_equal(ll_splice(p_head, head_size + 1, p_other, 0, 1), LL_ENUM_INDEX_TOO_LARGE);
+    assert_int_equal(ll_splice(p_head, 0, p_other, 0, -1), LL_ENUM_INDEX_TOO_LARGE);
+    assert_int_equal(ll_splice(p_head, 0, p_other, 1, INT32_MAX), LL_ENUM_INDEX_TOO_LARGE);
+    assert_int_equal(ll_splice(p_head, 0, p_other, 0, 0), LL_ENUM_NO_ERROR);
+    check_order(p_head, p_head_model, head_size);
+    check_order(p_other, p_other_model, other_size);
+
+    // All of other onto the front
+    assert_int_equal(ll_splice(p_head, 0, p_other, 0, other_size), LL_ENUM_NO_ERROR);
+    model_splice(p_head_model, &head_size, 0, p_other_model, &other_size, 0, other_size);
+    check_order(p_head, p_head_model, head_size);
+    check_order(p_other, p_other_model, 0);
+
+    // And all of it back onto the emptied list
+    assert_int_equal(ll_splice(p_other, INSERT_AT_END, p_head, 0, head_size), LL_ENUM_NO_ERROR);
+    model_splice(p_other_model, &other_size, 0, p_head_model, &head_size, 0, head_size);
+    check_order(p_other, p_other_model, LIST_SIZE);
+    check_order(p_head, p_head_model, 0);
+
+    // Destroy frees the data wherever it ended up
+    assert_int_equal(ll_destroy(p_head), LL_ENUM_NO_ERROR);
+    assert_int_equal(ll_destroy(p_other), LL_ENUM_NO_ERROR);
+  }
+} // test_ll_splice()
@@ -0,0 +1,237 @@
+/** @file unit_linkedlist_hash.c
+*
+* @brief Unit tests for hash indexed linked list
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include "cmocka.h"
+#include "linkedlist_hash.h"
+#include "log.h"
+#include "project_defs.h"
+#include "unit_linkedlist_hash.h"
+
+#define LIST_SIZE (1000)
+
+// Keyed test record
+typedef struct record {
+  uint32_t key;
+  uint32_t value;
+} record_t;
+
+// Keys seen by the print function in order
+static uint32_t printed[LIST_SIZE];
+
+/*
+ * \brief record_hash: hashes a record by key, deliberately weak so chains
+ *                     form
+ *
+ * \param data: pointer to the record or key record
+ * \return: hash of the key
+ *
+ */
+static uint32_t record_hash(void * data)
+{
+  return ((record_t *)data)->key % 61;
+} // record_hash()
+
+/*
+ * \brief record_equal: matches records with the same key
+ *
+ * \param data1: pointer to the key record
+ * \param data2: pointer to the record on the list
+ * \return: 1 is a match 0 is not a match
+ *
+ */
+static uint8_t record_equal(void * data1, void * data2)
+{
+  return ((record_t *)data1)->key == ((record_t *)data2)->key;
+} // record_equal()
+
+/*
+ * \brief record_value: matches records with the same value
+ *
+ * \param data1: pointer to the record searched for
+ * \param data2: pointer to the record on the list
+ * \return: 1 is a match 0 is not a match
+ *
+ */
+static uint8_t record_value(void * data1, void * data2)
+{
+  return ((record_t *)data1)->value == ((record_t *)data2)->value;
+} // record_value()
+
+/*
+ * \brief record_print: records the key of each record dumped
+ *
+ * \param data: pointer to the record
+ * \param index: index of the record
+ *
+ */
+static void record_print(void * data, uint32_t index)
+{
+  printed[index] = ((record_t *)data)->key;
+} // record_print()
+
+/*
+ * \brief record_new: allocates a record
+ *
+ * \param key: key of the record
+ * \return: the record
+ *
+ */
+static record_t * record_new(uint32_t key)
+{
+  record_t * record = malloc(sizeof(*record));
+
+  record->key = key;
+  record->value = key * 3;
+  return record;
+} // record_new()
+
+void test_ll_hash_ops_null_ptr(void **state)
+{
+  ll_hash_t * list = NULL;
+  record_t key = {0, 0};
+  void * data;
+  int32_t index;
+
+  assert_int_equal(ll_hash_init(NULL, record_hash, record_equal), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_init(&list, NULL, record_equal), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_init(&list, record_hash, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_destroy(NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_init(&list, record_hash, record_equal), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_hash_insert(NULL, &key, 0), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_insert(list, NULL, 0), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_remove(NULL, &data, 0), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_remove(list, NULL, 0), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_lookup(NULL, &key, &data), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_lookup(list, NULL, &data), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_lookup(list, &key, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_remove_key(NULL, &key, &data), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_remove_key(list, NULL, &data), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_remove_key(list, &key, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_search(NULL, &key, record_value, &index), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_search(list, &key, NULL, &index), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_search(list, &key, record_value, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_dump(NULL, record_print), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_dump(list, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_size(NULL, &index), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_size(list, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_hash_destroy(list), LL_ENUM_NO_ERROR);
+} // test_ll_hash_ops_null_ptr()
+
+void test_ll_hash_lookup(void **state)
+{
+  ll_hash_t * list = NULL;
+  record_t key = {0, 0};
+  record_t * record;
+  void * data;
+  int32_t size;
+
+  // Fill well past the starting buckets so the index grows
+  assert_int_equal(ll_hash_init(&list, record_hash, record_equal), LL_ENUM_NO_ERROR);
+  for (uint32_t i = 0; i < LIST_SIZE; i++)
+  {
+    assert_int_equal(ll_hash_insert(list, record_new(i * 7), INSERT_AT_END), LL_ENUM_NO_ERROR);
+  }
+  assert_int_equal(ll_hash_size(list, &size), LL_ENUM_NO_ERROR);
+  assert_int_equal(size, LIST_SIZE);
+
+  // Every key is found, others are not
+  for (uint32_t i = 0; i < LIST_SIZE * 7; i++)
+  {
+    key.key = i;
+    if (i % 7 == 0)
+    {
+      assert_int_equal(ll_hash_lookup(list, &key, &data), LL_ENUM_NO_ERROR);
+      assert_int_equal(((record_t *)data)->key, i);
+    }
+    else
+    {
+      assert_int_equal(ll_hash_lookup(list, &key, &data), LL_DATA_NOT_FOUND);
+    }
+  }
+
+  // A second record with a used key is refused
+  record = record_new(14);
+  assert_int_equal(ll_hash_insert(list, record, 0), LL_ENUM_FAILURE);
+  assert_int_equal(ll_hash_insert(list, record, LIST_SIZE + 2), LL_ENUM_FAILURE);
+
+  // A bad index leaves nothing behind in the index
+  record->key = 15;
+  assert_int_equal(ll_hash_insert(list, record, LIST_SIZE + 2), LL_ENUM_INDEX_TOO_LARGE);
+  key.key = 15;
+  assert_int_equal(ll_hash_lookup(list, &key, &data), LL_DATA_NOT_FOUND);
+  free(record);
+
+  // Destroy frees the records
+  assert_int_equal(ll_hash_destroy(list), LL_ENUM_NO_ERROR);
+} // test_ll_hash_lookup()
+
+void test_ll_hash_order(void **state)
+{
+  ll_hash_t * list = NULL;
+  record_t key = {0, 0};
+  void * data;
+  int32_t index;
+  int32_t size;
+
+  // Build 0 to LIST_SIZE - 1 with appends then prepends
+  assert_int_equal(ll_hash_init(&list, record_hash, record_equal), LL_ENUM_NO_ERROR);
+  for (uint32_t i = LIST_SIZE / 2; i < LIST_SIZE; i++)
+  {
+    assert_int_equal(ll_hash_insert(list, record_new(i), INSERT_AT_END), LL_ENUM_NO_ERROR);
+  }
+  for (uint32_t i = LIST_SIZE / 2; i > 0; i--)
+  {
+    assert_int_equal(ll_hash_insert(list, record_new(i - 1), 0), LL_ENUM_NO_ERROR);
+  }
+
+  // Remove every third record by key
+  for (uint32_t i = 0; i < LIST_SIZE; i += 3)
+  {
+    key.key = i;
+    assert_int_equal(ll_hash_remove_key(list, &key, &data), LL_ENUM_NO_ERROR);
+    assert_int_equal(((record_t *)data)->key, i);
+    free(data);
+    assert_int_equal(ll_hash_remove_key(list, &key, &data), LL_DATA_NOT_FOUND);
+  }
+
+  // Remove the first and last by index, they leave the index too
+  assert_int_equal(ll_hash_remove(list, &data, 0), LL_ENUM_NO_ERROR);
+  assert_int_equal(((record_t *)data)->key, 1);
+  free(data);
+  assert_int_equal(ll_hash_remove(list, &data, REMOVE_AT_END), LL_ENUM_NO_ERROR);
+  assert_int_equal(((record_t *)data)->key, LIST_SIZE - 2);
+  free(data);
+  key.key = 1;
+  assert_int_equal(ll_hash_lookup(list, &key, &data), LL_DATA_NOT_FOUND);
+
+  // The rest are still in order
+  assert_int_equal(ll_hash_size(list, &size), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_hash_dump(list, record_print), LL_ENUM_NO_ERROR);
+  index = 0;
+  for (uint32_t i = 2; i < LIST_SIZE - 2; i++)
+  {
+    if (i % 3 != 0)
+    {
+      assert_int_equal(printed[index], i);
+      index++;
+    }
+  }
+  assert_int_equal(index, size);
+
+  // Search by something other than the key goes in list order
+  key.value = 5 * 3;
+  assert_int_equal(ll_hash_search(list, &key, record_value, &index), LL_ENUM_NO_ERROR);
+  assert_int_equal(index, 2);
+
+  assert_int_equal(ll_hash_destroy(list), LL_ENUM_NO_ERROR);
+} // test_ll_hash_order()
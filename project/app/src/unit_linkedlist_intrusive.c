@@ -0,0 +1,192 @@
+/** @file unit_linkedlist_intrusive.c
+*
+* @brief Unit tests for intrusive linked list
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include "cmocka.h"
+#include "linkedlist_intrusive.h"
+#include "log.h"
+#include "project_defs.h"
+#include "unit_linkedlist_intrusive.h"
+
+#define LIST_SIZE (100)
+
+// Test object that can sit on two lists, the links are not first so the
+// offset is exercised
+typedef struct item {
+  uint32_t id;
+  ll_link_t all;
+  uint32_t value;
+  ll_link_t odd;
+} item_t;
+
+// Ids seen by the print function in order
+static uint32_t printed[LIST_SIZE];
+
+/*
+ * \brief item_compare: matches an item by id
+ *
+ * \param data1: pointer to the id searched for
+ * \param data2: pointer to the item
+ * \return: 1 is a match 0 is not a match
+ *
+ */
+static uint8_t item_compare(void * data1, void * data2)
+{
+  return *(uint32_t *)data1 == ((item_t *)data2)->id;
+} // item_compare()
+
+/*
+ * \brief item_print: records the id of each item dumped
+ *
+ * \param data: pointer to the item
+ * \param index: index of the item
+ *
+ */
+static void item_print(void * data, uint32_t index)
+{
+  printed[index] = ((item_t *)data)->id;
+} // item_print()
+
+void test_ll_intrusive_ops_null_ptr(void **state)
+{
+  ll_intrusive_t list;
+  item_t item;
+  void * object;
+  int32_t size;
+  uint32_t id = 0;
+
+  assert_int_equal(ll_intrusive_init(NULL, offsetof(item_t, all)), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_intrusive_init(&list, offsetof(item_t, all)), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_intrusive_insert(NULL, &item, 0), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_intrusive_insert(&list, NULL, 0), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_intrusive_remove(NULL, &object, 0), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_intrusive_remove(&list, NULL, 0), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_intrusive_unlink(NULL, &item), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_intrusive_unlink(&list, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_intrusive_search(NULL, &id, item_compare, &object), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_intrusive_search(&list, NULL, item_compare, &object), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_intrusive_search(&list, &id, NULL, &object), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_intrusive_search(&list, &id, item_compare, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_intrusive_dump(NULL, item_print), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_intrusive_dump(&list, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_intrusive_size(NULL, &size), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_intrusive_size(&list, NULL), LL_ENUM_NULL_POINTER);
+} // test_ll_intrusive_ops_null_ptr()
+
+void test_ll_intrusive_insert_remove(void **state)
+{
+  ll_intrusive_t list;
+  item_t items[LIST_SIZE];
+  void * object;
+  int32_t size;
+
+  // Removing from an empty list fails
+  assert_int_equal(ll_intrusive_init(&list, offsetof(item_t, all)), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_intrusive_remove(&list, &object, REMOVE_AT_END), LL_ENUM_INDEX_TOO_LARGE);
+
+  // Append all but the first and last then add those at the ends
+  for (uint32_t i = 0; i < LIST_SIZE; i++)
+  {
+    items[i].id = i;
+  }
+  for (uint32_t i = 1; i < LIST_SIZE - 1; i++)
+  {
+    assert_int_equal(ll_intrusive_insert(&list, &items[i], INSERT_AT_END), LL_ENUM_NO_ERROR);
+  }
+  assert_int_equal(ll_intrusive_insert(&list, &items[0], 0), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_intrusive_insert(&list, &items[LIST_SIZE - 1], LIST_SIZE - 1), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_intrusive_insert(&list, &items[0], LIST_SIZE + 1), LL_ENUM_INDEX_TOO_LARGE);
+  assert_int_equal(ll_intrusive_size(&list, &size), LL_ENUM_NO_ERROR);
+  assert_int_equal(size, LIST_SIZE);
+
+  // Remove by index from the front, back and middle
+  assert_int_equal(ll_intrusive_remove(&list, &object, 0), LL_ENUM_NO_ERROR);
+  assert_ptr_equal(object, &items[0]);
+  assert_int_equal(ll_intrusive_remove(&list, &object, REMOVE_AT_END), LL_ENUM_NO_ERROR);
+  assert_ptr_equal(object, &items[LIST_SIZE - 1]);
+  assert_int_equal(ll_intrusive_remove(&list, &object, 10), LL_ENUM_NO_ERROR);
+  assert_ptr_equal(object, &items[11]);
+  assert_int_equal(ll_intrusive_remove(&list, &object, -10), LL_ENUM_NO_ERROR);
+  assert_ptr_equal(object, &items[LIST_SIZE - 11]);
+  assert_int_equal(ll_intrusive_remove(&list, &object, LIST_SIZE - 4), LL_ENUM_INDEX_TOO_LARGE);
+
+  // Unlink a known object without walking
+  assert_int_equal(ll_intrusive_unlink(&list, &items[50]), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_intrusive_size(&list, &size), LL_ENUM_NO_ERROR);
+  assert_int_equal(size, LIST_SIZE - 5);
+  assert_int_equal(ll_intrusive_remove(&list, &object, 48), LL_ENUM_NO_ERROR);
+  assert_ptr_equal(object, &items[51]);
+} // test_ll_intrusive_insert_remove()
+
+void test_ll_intrusive_search_dump(void **state)
+{
+  ll_intrusive_t list;
+  item_t items[LIST_SIZE];
+  void * object;
+  uint32_t id;
+
+  // Fill in reverse so the dump order is visible
+  assert_int_equal(ll_intrusive_init(&list, offsetof(item_t, all)), LL_ENUM_NO_ERROR);
+  for (uint32_t i = 0; i < LIST_SIZE; i++)
+  {
+    items[i].id = i;
+    assert_int_equal(ll_intrusive_insert(&list, &items[i], 0), LL_ENUM_NO_ERROR);
+  }
+
+  // Callbacks get the objects, not the links
+  assert_int_equal(ll_intrusive_dump(&list, item_print), LL_ENUM_NO_ERROR);
+  for (uint32_t i = 0; i < LIST_SIZE; i++)
+  {
+    assert_int_equal(printed[i], LIST_SIZE - 1 - i);
+  }
+  id = 42;
+  assert_int_equal(ll_intrusive_search(&list, &id, item_compare, &object), LL_ENUM_NO_ERROR);
+  assert_ptr_equal(object, &items[42]);
+
+  // Search then unlink the match
+  assert_int_equal(ll_intrusive_unlink(&list, object), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_intrusive_search(&list, &id, item_compare, &object), LL_DATA_NOT_FOUND);
+} // test_ll_intrusive_search_dump()
+
+void test_ll_intrusive_two_lists(void **state)
+{
+  ll_intrusive_t all;
+  ll_intrusive_t odd;
+  item_t items[LIST_SIZE];
+  void * object;
+  int32_t size;
+
+  // Every item goes on all, odd ids also go on odd
+  assert_int_equal(ll_intrusive_init(&all, offsetof(item_t, all)), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_intrusive_init(&odd, offsetof(item_t, odd)), LL_ENUM_NO_ERROR);
+  for (uint32_t i = 0; i < LIST_SIZE; i++)
+  {
+    items[i].id = i;
+    items[i].value = i * 2;
+    assert_int_equal(ll_intrusive_insert(&all, &items[i], INSERT_AT_END), LL_ENUM_NO_ERROR);
+    if (i % 2)
+    {
+      assert_int_equal(ll_intrusive_insert(&odd, &items[i], INSERT_AT_END), LL_ENUM_NO_ERROR);
+    }
+  }
+
+  // Taking an item off one list leaves it on the other
+  assert_int_equal(ll_intrusive_remove(&odd, &object, 0), LL_ENUM_NO_ERROR);
+  assert_ptr_equal(object, &items[1]);
+  assert_int_equal(LL_CONTAINER_OF(&items[1].odd, item_t, odd)->value, 2);
+  assert_int_equal(ll_intrusive_size(&odd, &size), LL_ENUM_NO_ERROR);
+  assert_int_equal(size, LIST_SIZE / 2 - 1);
+  assert_int_equal(ll_intrusive_size(&all, &size), LL_ENUM_NO_ERROR);
+  assert_int_equal(size, LIST_SIZE);
+  assert_int_equal(ll_intrusive_remove(&all, &object, 1), LL_ENUM_NO_ERROR);
+  assert_ptr_equal(object, &items[1]);
+} // test_ll_intrusive_two_lists()
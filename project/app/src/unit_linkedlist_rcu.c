@@ -0,0 +1,289 @@
+/** @file unit_linkedlist_rcu.c
+*
+* @brief Unit tests for concurrent linked list
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include "cmocka.h"
+#include "linkedlist_rcu.h"
+#include "log.h"
+#include "project_defs.h"
+#include "unit_linkedlist_rcu.h"
+
+#define LIST_SIZE (100)
+#define READERS (4)
+#define WRITER_OPS (20000)
+
+// Marks a live record, free overwrites the start of a block so a reader
+// that gets to a freed record sees the mark change
+#define LIVE_MARK (0x4C4956454D41524BULL)
+
+// Test record, the mark has to stay first
+typedef struct record {
+  uint64_t mark;
+  uint32_t key;
+} record_t;
+
+// Shared state for the threaded test
+static ll_rcu_t * shared;
+static uint32_t writer_done;
+static uint32_t bad_reads;
+
+// Keys seen by the print function in order
+static uint32_t printed[LIST_SIZE];
+
+/*
+ * \brief record_match: matches records with the same key
+ *
+ * \param data1: pointer to the key record
+ * \param data2: pointer to the record on the list
+ * \return: 1 is a match 0 is not a match
+ *
+ */
+static uint8_t record_match(void * data1, void * data2)
+{
+  return ((record_t *)data1)->key == ((record_t *)data2)->key;
+} // record_match()
+
+/*
+ * \brief record_print: records the key of each record dumped
+ *
+ * \param data: pointer to the record
+ * \param index: index of the record
+ *
+ */
+static void record_print(void * data, uint32_t index)
+{
+  printed[index] = ((record_t *)data)->key;
+} // record_print()
+
+/*
+ * \brief record_check: counts records that are no longer live
+ *
+ * \param data: pointer to the record
+ * \param index: not used
+ *
+ */
+static void record_check(void * data, uint32_t index)
+{
+  if (((volatile record_t *)data)->mark != LIVE_MARK)
+  {
+    __atomic_fetch_add(&bad_reads, 1, __ATOMIC_RELAXED);
+  }
+} // record_check()
+
+/*
+ * \brief record_new: allocates a live record
+ *
+ * \param key: key of the record
+ * \return: the record
+ *
+ */
+static record_t * record_new(uint32_t key)
+{
+  record_t * record = malloc(sizeof(*record));
+
+  record->mark = LIVE_MARK;
+  record->key = key;
+  return record;
+} // record_new()
+
+/*
+ * \brief rcu_reader: Thread walking the list in read sections until the
+ *                    writer is done
+ *
+ * \param param: not used
+ * \return: NULL
+ *
+ */
+static void * rcu_reader(void * param)
+{
+  record_t key = {0, 0};
+  uint32_t reader;
+  void * found;
+
+  if (ll_rcu_register(shared, &reader) != LL_ENUM_NO_ERROR)
+  {
+    __atomic_fetch_add(&bad_reads, 1, __ATOMIC_RELAXED);
+    return NULL;
+  }
+
+  while (!__atomic_load_n(&writer_done, __ATOMIC_RELAXED))
+  {
+    ll_rcu_read_lock(shared, reader);
+    ll_rcu_dump(shared, record_check);
+    key.key = random() % LIST_SIZE;
+    if (ll_rcu_search(shared, &key, record_match, &found) == LL_ENUM_NO_ERROR)
+    {
+      // Hold on to the record for a while, the writer may remove it
+      sched_yield();
+      record_check(found, 0);
+    }
+    ll_rcu_read_unlock(shared, reader);
+  }
+
+  ll_rcu_unregister(shared, reader);
+  return NULL;
+} // rcu_reader()
+
+void test_ll_rcu_ops_null_ptr(void **state)
+{
+  ll_rcu_t * list = NULL;
+  record_t key = {0, 0};
+  uint32_t readers[LL_RCU_MAX_READERS];
+  uint32_t reader;
+  void * data;
+  int32_t size;
+
+  assert_int_equal(ll_rcu_init(NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_destroy(NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_init(&list), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_rcu_register(NULL, &reader), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_register(list, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_unregister(NULL, 0), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_read_lock(NULL, 0), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_read_unlock(NULL, 0), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_search(NULL, &key, record_match, &data), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_search(list, NULL, record_match, &data), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_search(list, &key, NULL, &data), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_search(list, &key, record_match, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_dump(NULL, record_print), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_dump(list, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_insert(NULL, &key, 0), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_insert(list, NULL, 0), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_remove(NULL, &key, record_match), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_remove(list, NULL, record_match), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_remove(list, &key, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_synchronize(NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_size(NULL, &size), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_rcu_size(list, NULL), LL_ENUM_NULL_POINTER);
+
+  // Reader slots run out and can be given back
+  assert_int_equal(ll_rcu_read_lock(list, LL_RCU_MAX_READERS), LL_ENUM_INDEX_TOO_LARGE);
+  assert_int_equal(ll_rcu_read_unlock(list, LL_RCU_MAX_READERS), LL_ENUM_INDEX_TOO_LARGE);
+  assert_int_equal(ll_rcu_unregister(list, LL_RCU_MAX_READERS), LL_ENUM_INDEX_TOO_LARGE);
+  for (uint32_t i = 0; i < LL_RCU_MAX_READERS; i++)
+  {
+    assert_int_equal(ll_rcu_register(list, &readers[i]), LL_ENUM_NO_ERROR);
+  }
+  assert_int_equal(ll_rcu_register(list, &reader), LL_ENUM_FAILURE);
+  assert_int_equal(ll_rcu_unregister(list, readers[7]), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_rcu_register(list, &reader), LL_ENUM_NO_ERROR);
+  assert_int_equal(reader, readers[7]);
+
+  assert_int_equal(ll_rcu_destroy(list), LL_ENUM_NO_ERROR);
+} // test_ll_rcu_ops_null_ptr()
+
+void test_ll_rcu_insert_remove(void **state)
+{
+  ll_rcu_t * list = NULL;
+  record_t key = {0, 0};
+  uint32_t reader;
+  void * data;
+  int32_t size;
+
+  // Build 0 to LIST_SIZE - 1 with appends and prepends
+  assert_int_equal(ll_rcu_init(&list), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_rcu_register(list, &reader), LL_ENUM_NO_ERROR);
+  for (uint32_t i = LIST_SIZE / 2; i < LIST_SIZE; i++)
+  {
+    assert_int_equal(ll_rcu_insert(list, record_new(i), INSERT_AT_END), LL_ENUM_NO_ERROR);
+  }
+  for (uint32_t i = LIST_SIZE / 2; i > 0; i--)
+  {
+    assert_int_equal(ll_rcu_insert(list, record_new(i - 1), 0), LL_ENUM_NO_ERROR);
+  }
+  data = record_new(LIST_SIZE);
+  assert_int_equal(ll_rcu_insert(list, data, LIST_SIZE + 1), LL_ENUM_INDEX_TOO_LARGE);
+  free(data);
+  assert_int_equal(ll_rcu_size(list, &size), LL_ENUM_NO_ERROR);
+  assert_int_equal(size, LIST_SIZE);
+
+  // Read everything back in a read section
+  assert_int_equal(ll_rcu_read_lock(list, reader), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_rcu_dump(list, record_print), LL_ENUM_NO_ERROR);
+  for (uint32_t i = 0; i < LIST_SIZE; i++)
+  {
+    assert_int_equal(printed[i], i);
+  }
+  key.key = LIST_SIZE / 3;
+  assert_int_equal(ll_rcu_search(list, &key, record_match, &data), LL_ENUM_NO_ERROR);
+  assert_int_equal(((record_t *)data)->key, LIST_SIZE / 3);
+
+  // A removed record stays readable until the section ends
+  assert_int_equal(ll_rcu_remove(list, &key, record_match), LL_ENUM_NO_ERROR);
+  assert_int_equal(((record_t *)data)->mark, LIVE_MARK);
+  assert_int_equal(ll_rcu_search(list, &key, record_match, &data), LL_DATA_NOT_FOUND);
+  assert_int_equal(ll_rcu_remove(list, &key, record_match), LL_DATA_NOT_FOUND);
+  assert_int_equal(ll_rcu_read_unlock(list, reader), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_rcu_synchronize(list), LL_ENUM_NO_ERROR);
+
+  // Remove the ends
+  key.key = 0;
+  assert_int_equal(ll_rcu_remove(list, &key, record_match), LL_ENUM_NO_ERROR);
+  key.key = LIST_SIZE - 1;
+  assert_int_equal(ll_rcu_remove(list, &key, record_match), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_rcu_size(list, &size), LL_ENUM_NO_ERROR);
+  assert_int_equal(size, LIST_SIZE - 3);
+  assert_int_equal(ll_rcu_read_lock(list, reader), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_rcu_dump(list, record_print), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_rcu_read_unlock(list, reader), LL_ENUM_NO_ERROR);
+  assert_int_equal(printed[0], 1);
+  assert_int_equal(printed[LIST_SIZE / 3 - 1], LIST_SIZE / 3 + 1);
+  assert_int_equal(printed[LIST_SIZE - 4], LIST_SIZE - 2);
+
+  // Destroy frees the records left and any still waiting
+  assert_int_equal(ll_rcu_destroy(list), LL_ENUM_NO_ERROR);
+} // test_ll_rcu_insert_remove()
+
+void test_ll_rcu_threads(void **state)
+{
+  pthread_t readers[READERS];
+  record_t key = {0, 0};
+  int32_t size;
+
+  writer_done = 0;
+  bad_reads = 0;
+  assert_int_equal(ll_rcu_init(&shared), LL_ENUM_NO_ERROR);
+  for (uint32_t i = 0; i < LIST_SIZE; i += 2)
+  {
+    assert_int_equal(ll_rcu_insert(shared, record_new(i), INSERT_AT_END), LL_ENUM_NO_ERROR);
+  }
+  for (uint32_t i = 0; i < READERS; i++)
+  {
+    assert_int_equal(pthread_create(&readers[i], NULL, rcu_reader, NULL), 0);
+  }
+
+  // Toggle random keys in and out under the readers
+  for (uint32_t op = 0; op < WRITER_OPS; op++)
+  {
+    key.key = random() % LIST_SIZE;
+    if (ll_rcu_remove(shared, &key, record_match) == LL_DATA_NOT_FOUND)
+    {
+      assert_int_equal(ll_rcu_insert(shared, record_new(key.key), random() % 2 ? 0 : INSERT_AT_END), LL_ENUM_NO_ERROR);
+    }
+    if (op % 1000 == 0)
+    {
+      assert_int_equal(ll_rcu_synchronize(shared), LL_ENUM_NO_ERROR);
+    }
+  }
+
+  __atomic_store_n(&writer_done, 1, __ATOMIC_RELAXED);
+  for (uint32_t i = 0; i < READERS; i++)
+  {
+    assert_int_equal(pthread_join(readers[i], NULL), 0);
+  }
+  assert_int_equal(bad_reads, 0);
+  assert_int_equal(ll_rcu_size(shared, &size), LL_ENUM_NO_ERROR);
+  assert_in_range(size, 0, LIST_SIZE);
+  assert_int_equal(ll_rcu_destroy(shared), LL_ENUM_NO_ERROR);
+} // test_ll_rcu_threads()
@@ -0,0 +1,216 @@
+/** @file unit_linkedlist_skip.c
+*
+* @brief Unit tests for skip list
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cmocka.h"
+#include "linkedlist_skip.h"
+#include "log.h"
+#include "project_defs.h"
+#include "unit_linkedlist_skip.h"
+
+#define MODEL_SIZE (500)
+#define MODEL_OPS (5000)
+#define MODEL_KEYS (50)
+
+// Timestamped test event, seq tells equal timestamps apart
+typedef struct event {
+  uint32_t stamp;
+  uint32_t seq;
+} event_t;
+
+// Events seen by the print function in order
+static event_t dumped[MODEL_SIZE];
+
+/*
+ * \brief event_less: orders events by timestamp only
+ *
+ * \param data1: pointer to the first event
+ * \param data2: pointer to the second event
+ * \return: 1 if the first event is earlier
+ *
+ */
+static uint8_t event_less(void * data1, void * data2)
+{
+  return ((event_t *)data1)->stamp < ((event_t *)data2)->stamp;
+} // event_less()
+
+/*
+ * \brief event_print: records each event dumped
+ *
+ * \param data: pointer to the event
+ * \param index: index of the event
+ *
+ */
+static void event_print(void * data, uint32_t index)
+{
+  dumped[index] = *(event_t *)data;
+} // event_print()
+
+/*
+ * \brief event_new: allocates an event
+ *
+ * \param stamp: timestamp of the event
+ * \param seq: sequence number of the event
+ * \return: the event
+ *
+ */
+static event_t * event_new(uint32_t stamp, uint32_t seq)
+{
+  event_t * event = malloc(sizeof(*event));
+
+  event->stamp = stamp;
+  event->seq = seq;
+  return event;
+} // event_new()
+
+void test_ll_skip_ops_null_ptr(void **state)
+{
+  ll_skip_t * list = NULL;
+  event_t key = {0, 0};
+  void * data;
+  int32_t size;
+
+  assert_int_equal(ll_skip_init(NULL, event_less), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_skip_init(&list, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_skip_destroy(NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_skip_init(&list, event_less), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_skip_insert(NULL, &key), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_skip_insert(list, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_skip_remove(NULL, &key, &data), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_skip_remove(list, NULL, &data), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_skip_remove(list, &key, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_skip_lookup(NULL, &key, &data), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_skip_lookup(list, NULL, &data), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_skip_lookup(list, &key, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_skip_range(NULL, NULL, NULL, event_print), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_skip_range(list, NULL, NULL, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_skip_dump(NULL, event_print), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_skip_dump(list, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_skip_size(NULL, &size), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_skip_size(list, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_skip_destroy(list), LL_ENUM_NO_ERROR);
+} // test_ll_skip_ops_null_ptr()
+
+void test_ll_skip_insert_remove(void **state)
+{
+  ll_skip_t * list = NULL;
+  event_t model[MODEL_SIZE];
+  event_t key = {0, 0};
+  int32_t count = 0;
+  int32_t index;
+  int32_t size;
+  void * data;
+
+  // Nothing to find on an empty list
+  assert_int_equal(ll_skip_init(&list, event_less), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_skip_remove(list, &key, &data), LL_DATA_NOT_FOUND);
+  assert_int_equal(ll_skip_lookup(list, &key, &data), LL_DATA_NOT_FOUND);
+
+  // Random inserts and removes mirrored in a sorted array, few distinct
+  // timestamps so most inserts land among equal ones
+  for (uint32_t op = 1; op <= MODEL_OPS; op++)
+  {
+    key.stamp = random() % MODEL_KEYS;
+    if (count < MODEL_SIZE && (count == 0 || random() % 100 < (op < MODEL_OPS / 2 ? 70 : 30)))
+    {
+      assert_int_equal(ll_skip_insert(list, event_new(key.stamp, op)), LL_ENUM_NO_ERROR);
+
+      // Equal timestamps stay in insertion order
+      index = 0;
+      while (index < count && model[index].stamp <= key.stamp)
+      {
+        index++;
+      }
+      memmove(&model[index + 1], &model[index], (count - index) * sizeof(model[0]));
+      model[index].stamp = key.stamp;
+      model[index].seq = op;
+      count++;
+    }
+    else
+    {
+      // The earliest event with the timestamp is removed
+      index = 0;
+      while (index < count && model[index].stamp < key.stamp)
+      {
+        index++;
+      }
+      if (index == count || model[index].stamp != key.stamp)
+      {
+        assert_int_equal(ll_skip_lookup(list, &key, &data), LL_DATA_NOT_FOUND);
+        assert_int_equal(ll_skip_remove(list, &key, &data), LL_DATA_NOT_FOUND);
+        continue;
+      }
+      assert_int_equal(ll_skip_lookup(list, &key, &data), LL_ENUM_NO_ERROR);
+      assert_int_equal(((event_t *)data)->seq, model[index].seq);
+      assert_int_equal(ll_skip_remove(list, &key, &data), LL_ENUM_NO_ERROR);
+      assert_int_equal(((event_t *)data)->seq, model[index].seq);
+      free(data);
+      count--;
+      memmove(&model[index], &model[index + 1], (count - index) * sizeof(model[0]));
+    }
+
+    // Compare the whole list now and then
+    if (op % 100 == 0)
+    {
+      assert_int_equal(ll_skip_size(list, &size), LL_ENUM_NO_ERROR);
+      assert_int_equal(size, count);
+      assert_int_equal(ll_skip_dump(list, event_print), LL_ENUM_NO_ERROR);
+      assert_memory_equal(dumped, model, count * sizeof(model[0]));
+    }
+  }
+
+  // Destroy frees what is left
+  assert_int_equal(ll_skip_destroy(list), LL_ENUM_NO_ERROR);
+} // test_ll_skip_insert_remove()
+
+void test_ll_skip_range(void **state)
+{
+  ll_skip_t * list = NULL;
+  event_t low = {10, 0};
+  event_t high = {20, 0};
+
+  // Two events per timestamp, inserted newest timestamp first
+  assert_int_equal(ll_skip_init(&list, event_less), LL_ENUM_NO_ERROR);
+  for (uint32_t i = MODEL_SIZE / 2; i > 0; i--)
+  {
+    assert_int_equal(ll_skip_insert(list, event_new((i - 1) / 2, i)), LL_ENUM_NO_ERROR);
+  }
+
+  // From low up to but not including high
+  memset(dumped, 0, sizeof(dumped));
+  assert_int_equal(ll_skip_range(list, &low, &high, event_print), LL_ENUM_NO_ERROR);
+  for (uint32_t i = 0; i < 20; i++)
+  {
+    assert_int_equal(dumped[i].stamp, 10 + i / 2);
+  }
+  assert_int_equal(dumped[20].seq, 0);
+
+  // Open ends run to the first and last items
+  memset(dumped, 0, sizeof(dumped));
+  assert_int_equal(ll_skip_range(list, NULL, &high, event_print), LL_ENUM_NO_ERROR);
+  assert_int_equal(dumped[0].stamp, 0);
+  assert_int_equal(dumped[39].stamp, 19);
+  assert_int_equal(dumped[40].seq, 0);
+  memset(dumped, 0, sizeof(dumped));
+  assert_int_equal(ll_skip_range(list, &low, NULL, event_print), LL_ENUM_NO_ERROR);
+  assert_int_equal(dumped[0].stamp, 10);
+  assert_int_equal(dumped[MODEL_SIZE / 2 - 21].stamp, MODEL_SIZE / 4 - 1);
+  assert_int_equal(dumped[MODEL_SIZE / 2 - 20].seq, 0);
+
+  // An empty range calls nothing
+  memset(dumped, 0, sizeof(dumped));
+  assert_int_equal(ll_skip_range(list, &high, &low, event_print), LL_ENUM_NO_ERROR);
+  assert_int_equal(dumped[0].seq, 0);
+
+  assert_int_equal(ll_skip_destroy(list), LL_ENUM_NO_ERROR);
+} // test_ll_skip_range()
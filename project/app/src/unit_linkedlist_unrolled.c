@@ -0,0 +1,168 @@
+/** @file unit_linkedlist_unrolled.c
+*
+* @brief Unit tests for unrolled linked list
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cmocka.h"
+#include "linkedlist_unrolled.h"
+#include "log.h"
+#include "project_defs.h"
+#include "unit_linkedlist_unrolled.h"
+
+#define MODEL_SIZE (500)
+#define MODEL_OPS (5000)
+
+// Values seen by the print function in order
+static uintptr_t dumped[MODEL_SIZE];
+
+/*
+ * \brief value_compare: matches data holding the same value
+ *
+ * \param data1: pointer to the value searched for
+ * \param data2: pointer to the data in the list
+ * \return: 1 is a match 0 is not a match
+ *
+ */
+static uint8_t value_compare(void * data1, void * data2)
+{
+  return *(uint32_t *)data1 == *(uint32_t *)data2;
+} // value_compare()
+
+/*
+ * \brief value_print: records each value dumped
+ *
+ * \param data: value stored in the data pointer
+ * \param index: index of the data
+ *
+ */
+static void value_print(void * data, uint32_t index)
+{
+  dumped[index] = (uintptr_t)data;
+} // value_print()
+
+void test_ll_unrolled_ops_null_ptr(void **state)
+{
+  ll_unrolled_t * list = NULL;
+  uint32_t value = 0;
+  void * data;
+  int32_t index;
+
+  assert_int_equal(ll_unrolled_init(NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_unrolled_destroy(NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_unrolled_init(&list), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_unrolled_insert(NULL, &value, 0), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_unrolled_insert(list, NULL, 0), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_unrolled_remove(NULL, &data, 0), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_unrolled_remove(list, NULL, 0), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_unrolled_search(NULL, &value, value_compare, &index), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_unrolled_search(list, NULL, value_compare, &index), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_unrolled_search(list, &value, NULL, &index), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_unrolled_search(list, &value, value_compare, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_unrolled_dump(NULL, value_print), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_unrolled_dump(list, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_unrolled_size(NULL, &index), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_unrolled_size(list, NULL), LL_ENUM_NULL_POINTER);
+  assert_int_equal(ll_unrolled_destroy(list), LL_ENUM_NO_ERROR);
+} // test_ll_unrolled_ops_null_ptr()
+
+void test_ll_unrolled_insert_remove(void **state)
+{
+  ll_unrolled_t * list = NULL;
+  uintptr_t model[MODEL_SIZE];
+  int32_t count = 0;
+  int32_t size;
+  int32_t index;
+  void * data;
+
+  // Out of range on an empty list
+  assert_int_equal(ll_unrolled_init(&list), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_unrolled_remove(list, &data, REMOVE_AT_END), LL_ENUM_INDEX_TOO_LARGE);
+  assert_int_equal(ll_unrolled_insert(list, (void *)1, 1), LL_ENUM_INDEX_TOO_LARGE);
+
+  // Random inserts and removes mirrored in an array, biased to grow first
+  for (uintptr_t op = 1; op <= MODEL_OPS; op++)
+  {
+    if (count < MODEL_SIZE && (count == 0 || random() % 100 < (op < MODEL_OPS / 2 ? 70 : 30)))
+    {
+      index = random() % (count + 1);
+      if (random() % 2)
+      {
+        assert_int_equal(ll_unrolled_insert(list, (void *)op, index), LL_ENUM_NO_ERROR);
+      }
+      else
+      {
+        assert_int_equal(ll_unrolled_insert(list, (void *)op, index - count - 1), LL_ENUM_NO_ERROR);
+      }
+      memmove(&model[index + 1], &model[index], (count - index) * sizeof(model[0]));
+      model[index] = op;
+      count++;
+    }
+    else
+    {
+      index = random() % count;
+      assert_int_equal(ll_unrolled_remove(list, &data, random() % 2 ? index : index - count), LL_ENUM_NO_ERROR);
+      assert_int_equal((uintptr_t)data, model[index]);
+      count--;
+      memmove(&model[index], &model[index + 1], (count - index) * sizeof(model[0]));
+    }
+
+    // Compare the whole list now and then
+    if (op % 100 == 0)
+    {
+      assert_int_equal(ll_unrolled_size(list, &size), LL_ENUM_NO_ERROR);
+      assert_int_equal(size, count);
+      assert_int_equal(ll_unrolled_dump(list, value_print), LL_ENUM_NO_ERROR);
+      assert_memory_equal(dumped, model, count * sizeof(model[0]));
+    }
+  }
+
+  // Drain from the end, the values are not heap pointers
+  while (count > 0)
+  {
+    count--;
+    assert_int_equal(ll_unrolled_remove(list, &data, REMOVE_AT_END), LL_ENUM_NO_ERROR);
+    assert_int_equal((uintptr_t)data, model[count]);
+  }
+  assert_int_equal(ll_unrolled_size(list, &size), LL_ENUM_NO_ERROR);
+  assert_int_equal(size, 0);
+  assert_int_equal(ll_unrolled_insert(list, (void *)1, INSERT_AT_END), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_unrolled_remove(list, &data, 0), LL_ENUM_NO_ERROR);
+  assert_int_equal(ll_unrolled_destroy(list), LL_ENUM_NO_ERROR);
+} // test_ll_unrolled_insert_remove()
+
+void test_ll_unrolled_search_destroy(void **state)
+{
+  ll_unrolled_t * list = NULL;
+  uint32_t * value;
+  uint32_t key;
+  int32_t index;
+
+  // Each value is its own allocation freed by destroy
+  assert_int_equal(ll_unrolled_init(&list), LL_ENUM_NO_ERROR);
+  for (uint32_t i = 0; i < MODEL_SIZE; i++)
+  {
+    value = malloc(sizeof(*value));
+    *value = i;
+    assert_int_equal(ll_unrolled_insert(list, value, INSERT_AT_END), LL_ENUM_NO_ERROR);
+  }
+
+  // Search hits in several nodes and misses
+  for (key = 0; key < MODEL_SIZE; key += 37)
+  {
+    assert_int_equal(ll_unrolled_search(list, &key, value_compare, &index), LL_ENUM_NO_ERROR);
+    assert_int_equal(index, key);
+  }
+  key = MODEL_SIZE;
+  assert_int_equal(ll_unrolled_search(list, &key, value_compare, &index), LL_DATA_NOT_FOUND);
+
+  assert_int_equal(ll_unrolled_destroy(list), LL_ENUM_NO_ERROR);
+} // test_ll_unrolled_search_destroy()
@@ -0,0 +1,262 @@
+/** @file unit_ringbuf.c
+*
+* @brief Unit tests for ring buffer
+* @author Ryan Mortenson
+* @tools GCC 5.4.0, vim 7.4, make 4.1, Ubuntu 16.04
+*
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cmocka.h>
+#include "ringbuf.h"
+#include "project_defs.h"
+#include "unit_ringbuf.h"
+#include "log.h"
+
+#define RING_SIZE (1024)
+#define THREAD_RECORDS (100000)
+
+/*
+ * \brief ring_producer: Thread committing THREAD_RECORDS records whose
+ *                       length and contents depend on their number
+ *
+ * \param param: pointer to the ring buffer
+ * \return: NULL
+ *
+ */
+static void * ring_producer(void * param)
+{
+  ringbuf_t * ring = (ringbuf_t *)param;
+  uint32_t * record;
+  uint32_t words;
+
+  for (uint32_t i = 0; i < THREAD_RECORDS; i++)
+  {
+    words = 1 + i % 13;
+    while (ringbuf_reserve(ring, words * sizeof(uint32_t), (void **)&record) == CB_ENUM_FULL)
+    {
+      sched_yield();
+    }
+    for (uint32_t j = 0; j < words; j++)
+    {
+      record[j] = i + j;
+    }
+    ringbuf_commit(ring, words * sizeof(uint32_t));
+  }
+
+  return NULL;
+} // ring_producer()
+
+void test_ringbuf_init_destroy(void **state)
+{
+  ringbuf_t * ring = NULL;
+
+  // Create ring and check there were no errors
+  assert_int_equal(ringbuf_init(&ring, RING_SIZE), CB_ENUM_NO_ERROR);
+
+  // Zero size is not allowed
+  assert_int_equal(ringbuf_init(&ring, 0), CB_ENUM_NO_LENGTH);
+
+  // Destroy ring and check there were no errors
+  assert_int_equal(ringbuf_destroy(ring), CB_ENUM_NO_ERROR);
+} // test_ringbuf_init_destroy()
+
+void test_ringbuf_ops_null_ptr(void **state)
+{
+  void * record;
+  uint32_t length;
+
+  // Pass a null pointer into each function and make sure they return
+  // null pointer enum
+  assert_int_equal(ringbuf_init((ringbuf_t **)NULL, RING_SIZE), CB_ENUM_NULL_POINTER);
+  assert_int_equal(ringbuf_destroy((ringbuf_t *)NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(ringbuf_reserve((ringbuf_t *)NULL, 1, &record), CB_ENUM_NULL_POINTER);
+  assert_int_equal(ringbuf_commit((ringbuf_t *)NULL, 1), CB_ENUM_NULL_POINTER);
+  assert_int_equal(ringbuf_read((ringbuf_t *)NULL, &record, &length), CB_ENUM_NULL_POINTER);
+  assert_int_equal(ringbuf_release((ringbuf_t *)NULL), CB_ENUM_NULL_POINTER);
+  assert_int_equal(ringbuf_empty((ringbuf_t *)NULL), CB_ENUM_NULL_POINTER);
+} // test_ringbuf_ops_null_ptr()
+
+void test_ringbuf_reserve_commit(void **state)
+{
+  ringbuf_t * ring = NULL;
+  uint8_t * record;
+  uint32_t length;
+
+  // Create ring and check it starts empty
+  assert_int_equal(ringbuf_init(&ring, RING_SIZE), CB_ENUM_NO_ERROR);
+  assert_int_equal(ringbuf_empty(ring), CB_ENUM_EMPTY);
+  assert_int_equal(ringbuf_read(ring, (void **)&record, &length), CB_ENUM_EMPTY);
+
+  // Commit and release without a reservation or read must fail
+  assert_int_equal(ringbuf_commit(ring, 1), CB_ENUM_FAILURE);
+  assert_int_equal(ringbuf_release(ring), CB_ENUM_FAILURE);
+
+  // Commit records of increasing length, the last one shorter than reserved
+  for (uint32_t i = 0; i < 10; i++)
+  {
+    assert_int_equal(ringbuf_reserve(ring, i + 1, (void **)&record), CB_ENUM_NO_ERROR);
+    memset(record, i, i + 1);
+    assert_int_equal(ringbuf_commit(ring, i + 1), CB_ENUM_NO_ERROR);
+  }
+  assert_int_equal(ringbuf_reserve(ring, 100, (void **)&record), CB_ENUM_NO_ERROR);
+  assert_int_equal(ringbuf_reserve(ring, 100, (void **)&record), CB_ENUM_FAILURE);
+  assert_int_equal(ringbuf_commit(ring, 101), CB_ENUM_FAILURE);
+  memset(record, 0xAA, 50);
+  assert_int_equal(ringbuf_commit(ring, 50), CB_ENUM_NO_ERROR);
+  assert_int_equal(ringbuf_empty(ring), CB_ENUM_FAILURE);
+
+  // Read every record back in order
+  for (uint32_t i = 0; i < 10; i++)
+  {
+    assert_int_equal(ringbuf_read(ring, (void **)&record, &length), CB_ENUM_NO_ERROR);
+    assert_int_equal(length, i + 1);
+    for (uint32_t j = 0; j < length; j++)
+    {
+      assert_int_equal(record[j], i);
+    }
+    assert_int_equal(ringbuf_release(ring), CB_ENUM_NO_ERROR);
+  }
+  assert_int_equal(ringbuf_read(ring, (void **)&record, &length), CB_ENUM_NO_ERROR);
+  assert_int_equal(length, 50);
+  assert_int_equal(record[49], 0xAA);
+  assert_int_equal(ringbuf_release(ring), CB_ENUM_NO_ERROR);
+  assert_int_equal(ringbuf_empty(ring), CB_ENUM_EMPTY);
+
+  // Destroy ring and check there were no errors
+  assert_int_equal(ringbuf_destroy(ring), CB_ENUM_NO_ERROR);
+} // test_ringbuf_reserve_commit()
+
+void test_ringbuf_full_wrap(void **state)
+{
+  ringbuf_t * ring = NULL;
+  uint8_t * record;
+  uint32_t length;
+  uint32_t count = 0;
+
+  // Create ring and check there were no errors
+  assert_int_equal(ringbuf_init(&ring, RING_SIZE), CB_ENUM_NO_ERROR);
+
+  // A record bigger than half the ring can never fit
+  assert_int_equal(ringbuf_reserve(ring, RING_SIZE, (void **)&record), CB_ENUM_FAILURE);
+
+  // Fill the ring with 100 byte records until it is full
+  while (ringbuf_reserve(ring, 100, (void **)&record) == CB_ENUM_NO_ERROR)
+  {
+    memset(record, count, 100);
+    assert_int_equal(ringbuf_commit(ring, 100), CB_ENUM_NO_ERROR);
+    count++;
+  }
+  assert_true(count > 1);
+
+  // Free the first record, the next one only fits after a wrap
+  assert_int_equal(ringbuf_read(ring, (void **)&record, &length), CB_ENUM_NO_ERROR);
+  assert_int_equal(ringbuf_release(ring), CB_ENUM_NO_ERROR);
+  assert_int_equal(ringbuf_reserve(ring, 100, (void **)&record), CB_ENUM_NO_ERROR);
+  memset(record, count, 100);
+  assert_int_equal(ringbuf_commit(ring, 100), CB_ENUM_NO_ERROR);
+
+  // Every remaining record is read back in order across the wrap
+  for (uint32_t i = 1; i <= count; i++)
+  {
+    assert_int_equal(ringbuf_read(ring, (void **)&record, &length), CB_ENUM_NO_ERROR);
+    assert_int_equal(length, 100);
+    assert_int_equal(record[0], (uint8_t)i);
+    assert_int_equal(record[99], (uint8_t)i);
+    assert_int_equal(ringbuf_release(ring), CB_ENUM_NO_ERROR);
+  }
+  assert_int_equal(ringbuf_empty(ring), CB_ENUM_EMPTY);
+
+  // Destroy ring and check there were no errors
+  assert_int_equal(ringbuf_destroy(ring), CB_ENUM_NO_ERROR);
+} // test_ringbuf_full_wrap()
+
+void test_ringbuf_mirrored(void **state)
+{
+  ringbuf_t * ring = NULL;
+  uint8_t * base;
+  uint8_t * record;
+  uint32_t length;
+  uint32_t size;
+
+  // Create a mirrored ring, the size is rounded up to at least a page
+  assert_int_equal(ringbuf_init_mirrored((ringbuf_t **)NULL, RING_SIZE), CB_ENUM_NULL_POINTER);
+  assert_int_equal(ringbuf_init_mirrored(&ring, 0), CB_ENUM_NO_LENGTH);
+  assert_int_equal(ringbuf_init_mirrored(&ring, RING_SIZE), CB_ENUM_NO_ERROR);
+  assert_int_equal(ringbuf_size(ring, &size), CB_ENUM_NO_ERROR);
+  assert_true(size >= RING_SIZE);
+
+  // Move head three quarters of the way through the ring, the first record
+  // header sits at the start of the ring
+  assert_int_equal(ringbuf_reserve(ring, 3 * size / 4 - 8, (void **)&record), CB_ENUM_NO_ERROR);
+  base = record - 8;
+  assert_int_equal(ringbuf_commit(ring, 3 * size / 4 - 8), CB_ENUM_NO_ERROR);
+  assert_int_equal(ringbuf_read(ring, (void **)&record, &length), CB_ENUM_NO_ERROR);
+  assert_int_equal(ringbuf_release(ring), CB_ENUM_NO_ERROR);
+
+  // A record running past the end is contiguous and continues in the mirror
+  // of the start of the ring
+  assert_int_equal(ringbuf_reserve(ring, size / 2, (void **)&record), CB_ENUM_NO_ERROR);
+  assert_ptr_equal(record, base + 3 * size / 4 + 8);
+  for (uint32_t i = 0; i < size / 2; i++)
+  {
+    record[i] = i;
+  }
+  assert_int_equal(ringbuf_commit(ring, size / 2), CB_ENUM_NO_ERROR);
+  assert_int_equal(base[0], (uint8_t)(size / 4 - 8));
+  assert_int_equal(ringbuf_read(ring, (void **)&record, &length), CB_ENUM_NO_ERROR);
+  assert_int_equal(length, size / 2);
+  for (uint32_t i = 0; i < size / 2; i++)
+  {
+    assert_int_equal(record[i], (uint8_t)i);
+  }
+  assert_int_equal(ringbuf_release(ring), CB_ENUM_NO_ERROR);
+
+  // Without pad records one record can take the whole ring
+  assert_int_equal(ringbuf_reserve(ring, size - 8, (void **)&record), CB_ENUM_NO_ERROR);
+  assert_int_equal(ringbuf_commit(ring, size - 8), CB_ENUM_NO_ERROR);
+  assert_int_equal(ringbuf_reserve(ring, 1, (void **)&record), CB_ENUM_FULL);
+
+  // Destroy ring and check there were no errors
+  assert_int_equal(ringbuf_destroy(ring), CB_ENUM_NO_ERROR);
+} // test_ringbuf_mirrored()
+
+void test_ringbuf_threads(void **state)
+{
+  pthread_t producer;
+  ringbuf_t * ring = NULL;
+  uint32_t * record;
+  uint32_t length;
+  uint32_t i = 0;
+
+  // Use a small ring so both full and wrap are hit often
+  assert_int_equal(ringbuf_init(&ring, 256), CB_ENUM_NO_ERROR);
+  assert_int_equal(pthread_create(&producer, NULL, ring_producer, ring), 0);
+
+  // Check every record is intact and in order
+  while (i < THREAD_RECORDS)
+  {
+    if (ringbuf_read(ring, (void **)&record, &length) != CB_ENUM_NO_ERROR)
+    {
+      sched_yield();
+      continue;
+    }
+    assert_int_equal(length, (1 + i % 13) * sizeof(uint32_t));
+    for (uint32_t j = 0; j < length / sizeof(uint32_t); j++)
+    {
+      assert_int_equal(record[j], i + j);
+    }
+    assert_int_equal(ringbuf_release(ring), CB_ENUM_NO_ERROR);
+    i++;
+  }
+
+  assert_int_equal(pthread_join(producer, NULL), 0);
+  assert_int_equal(ringbuf_destroy(ring), CB_ENUM_NO_ERROR);
+} // test_ringbuf_threads()
@@ -12,7 +12,20 @@
 #include <setjmp.h>
 #include <cmocka.h>
 #include "unit_circbuf.h"
+#include "unit_circbuf_spsc.h"
+#include "unit_circbuf_mpmc.h"
+#include "unit_circbuf_shard.h"
+#include "unit_circbuf_shm.h"
+#include "unit_circbuf_typed.h"
+#include "unit_circbuf_window.h"
 #include "unit_linkedlist.h"
+#include "unit_linkedlist_intrusive.h"
+#include "unit_linkedlist_unrolled.h"
+#include "unit_linkedlist_hash.h"
+#include "unit_linkedlist_skip.h"
+#include "unit_linkedlist_rcu.h"
+#include "unit_linkedlist_indexed.h"
+#include "unit_ringbuf.h"
 
 // Execute unit tests for linkedlist.c
 uint32_t unit_test_linkedlist()
@@ -23,7 +36,87 @@ uint32_t unit_test_linkedlist()
     cmocka_unit_test(test_ll_insert),
     cmocka_unit_test(test_ll_remove),
     cmocka_unit_test(test_ll_search),
-    cmocka_unit_test(test_ll_size)
+    cmocka_unit_test(test_ll_size),
+    cmocka_unit_test(test_ll_pool),
+    cmocka_unit_test(test_ll_ends),
+    cmocka_unit_test(test_ll_cursor),
+    cmocka_unit_test(test_ll_sort),
+    cmocka_unit_test(test_ll_merge),
+    cmocka_unit_test(test_ll_bulk),
+    cmocka_unit_test(test_ll_splice)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
+
+// Execute unit tests for linkedlist_intrusive.c
+uint32_t unit_test_linkedlist_intrusive()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_ll_intrusive_ops_null_ptr),
+    cmocka_unit_test(test_ll_intrusive_insert_remove),
+    cmocka_unit_test(test_ll_intrusive_search_dump),
+    cmocka_unit_test(test_ll_intrusive_two_lists)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
+
+// Execute unit tests for linkedlist_unrolled.c
+uint32_t unit_test_linkedlist_unrolled()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_ll_unrolled_ops_null_ptr),
+    cmocka_unit_test(test_ll_unrolled_insert_remove),
+    cmocka_unit_test(test_ll_unrolled_search_destroy)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
+
+// Execute unit tests for linkedlist_hash.c
+uint32_t unit_test_linkedlist_hash()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_ll_hash_ops_null_ptr),
+    cmocka_unit_test(test_ll_hash_lookup),
+    cmocka_unit_test(test_ll_hash_order)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
+
+// Execute unit tests for linkedlist_skip.c
+uint32_t unit_test_linkedlist_skip()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_ll_skip_ops_null_ptr),
+    cmocka_unit_test(test_ll_skip_insert_remove),
+    cmocka_unit_test(test_ll_skip_range)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
+
+// Execute unit tests for linkedlist_rcu.c
+uint32_t unit_test_linkedlist_rcu()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_ll_rcu_ops_null_ptr),
+    cmocka_unit_test(test_ll_rcu_insert_remove),
+    cmocka_unit_test(test_ll_rcu_threads)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
+
+// Execute unit tests for linkedlist_indexed.c
+uint32_t unit_test_linkedlist_indexed()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_ll_indexed_ops_null_ptr),
+    cmocka_unit_test(test_ll_indexed_insert_remove),
+    cmocka_unit_test(test_ll_indexed_search_destroy)
   };
 
   return cmocka_run_group_tests(tests, NULL, NULL);
@@ -42,7 +135,115 @@ uint32_t unit_test_circbuf()
     cmocka_unit_test(test_circbuf_wrap_add),
     cmocka_unit_test(test_circbuf_wrap_remove),
     cmocka_unit_test(test_circbuf_check_full),
-    cmocka_unit_test(test_circbuf_check_empty)
+    cmocka_unit_test(test_circbuf_check_empty),
+    cmocka_unit_test(test_circbuf_add_remove_items),
+    cmocka_unit_test(test_circbuf_peek_spans),
+    cmocka_unit_test(test_circbuf_overwrite),
+    cmocka_unit_test(test_circbuf_overwrite_items),
+    cmocka_unit_test(test_circbuf_notify),
+    cmocka_unit_test(test_circbuf_growable),
+    cmocka_unit_test(test_circbuf_stats)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
+
+// Execute unit tests for circbuf_spsc.c
+uint32_t unit_test_circbuf_spsc()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_circbuf_spsc_init_destroy),
+    cmocka_unit_test(test_circbuf_spsc_ops_null_ptr),
+    cmocka_unit_test(test_circbuf_spsc_add_remove_full),
+    cmocka_unit_test(test_circbuf_spsc_wrap),
+    cmocka_unit_test(test_circbuf_spsc_threads),
+    cmocka_unit_test(test_circbuf_spsc_wait_timeout),
+    cmocka_unit_test(test_circbuf_spsc_wait_threads)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
+
+// Execute unit tests for circbuf_mpmc.c
+uint32_t unit_test_circbuf_mpmc()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_circbuf_mpmc_init_destroy),
+    cmocka_unit_test(test_circbuf_mpmc_ops_null_ptr),
+    cmocka_unit_test(test_circbuf_mpmc_add_remove_full),
+    cmocka_unit_test(test_circbuf_mpmc_length_one),
+    cmocka_unit_test(test_circbuf_mpmc_threads)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
+
+// Execute unit tests for circbuf_shard.c
+uint32_t unit_test_circbuf_shard()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_circbuf_shard_init_destroy),
+    cmocka_unit_test(test_circbuf_shard_ops_null_ptr),
+    cmocka_unit_test(test_circbuf_shard_spill_steal),
+    cmocka_unit_test(test_circbuf_shard_batch_steal),
+    cmocka_unit_test(test_circbuf_shard_steal_order),
+    cmocka_unit_test(test_circbuf_shard_threads)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
+
+// Execute unit tests for circbuf_shm.c
+uint32_t unit_test_circbuf_shm()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_circbuf_shm_init_destroy),
+    cmocka_unit_test(test_circbuf_shm_ops_null_ptr),
+    cmocka_unit_test(test_circbuf_shm_add_remove_full),
+    cmocka_unit_test(test_circbuf_shm_fork),
+    cmocka_unit_test(test_circbuf_shm_open_checks),
+    cmocka_unit_test(test_circbuf_shm_peer_header)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
+
+// Execute unit tests for circbuf_typed.h
+uint32_t unit_test_circbuf_typed()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_circbuf_typed_ops_null_ptr),
+    cmocka_unit_test(test_circbuf_typed_add_remove_full),
+    cmocka_unit_test(test_circbuf_typed_counter_wrap)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
+
+// Execute unit tests for circbuf_window.c
+uint32_t unit_test_circbuf_window()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_circbuf_window_ops_null_ptr),
+    cmocka_unit_test(test_circbuf_window_empty),
+    cmocka_unit_test(test_circbuf_window_aggregates),
+    cmocka_unit_test(test_circbuf_window_percentile),
+    cmocka_unit_test(test_circbuf_window_non_finite)
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
+
+// Execute unit tests for ringbuf.c
+uint32_t unit_test_ringbuf()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_ringbuf_init_destroy),
+    cmocka_unit_test(test_ringbuf_ops_null_ptr),
+    cmocka_unit_test(test_ringbuf_reserve_commit),
+    cmocka_unit_test(test_ringbuf_full_wrap),
+    cmocka_unit_test(test_ringbuf_mirrored),
+    cmocka_unit_test(test_ringbuf_threads)
   };
 
   return cmocka_run_group_tests(tests, NULL, NULL);
@@ -52,7 +253,20 @@ uint32_t unit_test_circbuf()
 int main()
 {
   unit_test_circbuf();
+  unit_test_circbuf_spsc();
+  unit_test_circbuf_mpmc();
+  unit_test_circbuf_shard();
+  unit_test_circbuf_shm();
+  unit_test_circbuf_typed();
+  unit_test_circbuf_window();
+  unit_test_ringbuf();
   unit_test_linkedlist();
+  unit_test_linkedlist_intrusive();
+  unit_test_linkedlist_unrolled();
+  unit_test_linkedlist_hash();
+  unit_test_linkedlist_skip();
+  unit_test_linkedlist_rcu();
+  unit_test_linkedlist_indexed();
 
   return 0;
 }
@@ -8,19 +8,50 @@ APP_OUT=app/out
 X86_APP_OUT=$(APP_OUT)/$(X86)
 ARM_APP_OUT=$(APP_OUT)/$(ARM)
 
-APP_SRC_C += \
+# Sources without a main() or thread globals, these are shared with the
+# unit test binary
+NON_MAIN_SRC += \
 	$(APP_SRC_DIR)/log.c \
 	$(APP_SRC_DIR)/profiler.c \
 	$(APP_SRC_DIR)/circbuf.c \
+	$(APP_SRC_DIR)/circbuf_spsc.c \
+	$(APP_SRC_DIR)/circbuf_mpmc.c \
+	$(APP_SRC_DIR)/circbuf_shard.c \
+	$(APP_SRC_DIR)/circbuf_shm.c \
+	$(APP_SRC_DIR)/circbuf_window.c \
+	$(APP_SRC_DIR)/futex.c \
+	$(APP_SRC_DIR)/ringbuf.c \
+	$(APP_SRC_DIR)/linkedlist.c \
+	$(APP_SRC_DIR)/linkedlist_intrusive.c \
+	$(APP_SRC_DIR)/linkedlist_unrolled.c \
+	$(APP_SRC_DIR)/linkedlist_hash.c \
+	$(APP_SRC_DIR)/linkedlist_skip.c \
+	$(APP_SRC_DIR)/linkedlist_rcu.c \
+	$(APP_SRC_DIR)/linkedlist_indexed.c
+
+APP_SRC_C += \
+	$(NON_MAIN_SRC) \
 	$(APP_SRC_DIR)/child1.c \
-	$(APP_SRC_DIR)/child2.c \
-	$(APP_SRC_DIR)/linkedlist.c
+	$(APP_SRC_DIR)/child2.c
 
 TEST_SRC+= \
 	$(NON_MAIN_SRC) \
 	$(APP_SRC_DIR)/unit_tests.c \
 	$(APP_SRC_DIR)/unit_circbuf.c \
-	$(APP_SRC_DIR)/unit_linkedlist.c
+	$(APP_SRC_DIR)/unit_circbuf_spsc.c \
+	$(APP_SRC_DIR)/unit_circbuf_mpmc.c \
+	$(APP_SRC_DIR)/unit_circbuf_shard.c \
+	$(APP_SRC_DIR)/unit_circbuf_shm.c \
+	$(APP_SRC_DIR)/unit_circbuf_typed.c \
+	$(APP_SRC_DIR)/unit_circbuf_window.c \
+	$(APP_SRC_DIR)/unit_ringbuf.c \
+	$(APP_SRC_DIR)/unit_linkedlist.c \
+	$(APP_SRC_DIR)/unit_linkedlist_intrusive.c \
+	$(APP_SRC_DIR)/unit_linkedlist_unrolled.c \
+	$(APP_SRC_DIR)/unit_linkedlist_hash.c \
+	$(APP_SRC_DIR)/unit_linkedlist_skip.c \
+	$(APP_SRC_DIR)/unit_linkedlist_rcu.c \
+	$(APP_SRC_DIR)/unit_linkedlist_indexed.c
 
 # Make a src list without any directories to feed into the allasm/alli targets
 SRC_LIST = $(subst $(APP_SRC_DIR)/,,$(APP_SRC_C))